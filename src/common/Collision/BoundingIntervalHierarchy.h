@@ -32,6 +32,13 @@
 #include <cmath>
 
 #define MAX_STACK_SIZE 64
+// Max number of rays intersected together by BIH::intersectRays
+#define BIH_RAY_PACKET_SIZE 4
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define BIH_RAY_PACKET_SSE
+#include <xmmintrin.h>
+#endif
 
 static inline uint32 floatToRawIntBits(float f)
 {
@@ -60,6 +67,37 @@ struct AABound
     G3D::Vector3 lo, hi;
 };
 
+/* One float per ray of a packet. min and max return b when a is NaN (rays parallel to a plane they start in)
+so that the interval of the ray is kept, like the single ray traversal does. */
+struct BIHRayLanes
+{
+#ifdef BIH_RAY_PACKET_SSE
+    __m128 v;
+
+    static BIHRayLanes load(float const* f) { return { _mm_loadu_ps(f) }; }
+    static BIHRayLanes set(float f) { return { _mm_set1_ps(f) }; }
+    static BIHRayLanes sub(BIHRayLanes a, BIHRayLanes b) { return { _mm_sub_ps(a.v, b.v) }; }
+    static BIHRayLanes mul(BIHRayLanes a, BIHRayLanes b) { return { _mm_mul_ps(a.v, b.v) }; }
+    static BIHRayLanes min(BIHRayLanes a, BIHRayLanes b) { return { _mm_min_ps(a.v, b.v) }; }
+    static BIHRayLanes max(BIHRayLanes a, BIHRayLanes b) { return { _mm_max_ps(a.v, b.v) }; }
+    // a for lanes with all bits set in mask, b for the others
+    static BIHRayLanes select(BIHRayLanes mask, BIHRayLanes a, BIHRayLanes b) { return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) }; }
+    // bit i set if a[i] <= b[i]
+    static uint32 lessEqual(BIHRayLanes a, BIHRayLanes b) { return uint32(_mm_movemask_ps(_mm_cmple_ps(a.v, b.v))); }
+#else
+    float v[BIH_RAY_PACKET_SIZE];
+
+    static BIHRayLanes load(float const* f) { BIHRayLanes r; for (int i = 0; i < BIH_RAY_PACKET_SIZE; ++i) r.v[i] = f[i]; return r; }
+    static BIHRayLanes set(float f) { BIHRayLanes r; for (int i = 0; i < BIH_RAY_PACKET_SIZE; ++i) r.v[i] = f; return r; }
+    static BIHRayLanes sub(BIHRayLanes a, BIHRayLanes b) { for (int i = 0; i < BIH_RAY_PACKET_SIZE; ++i) a.v[i] -= b.v[i]; return a; }
+    static BIHRayLanes mul(BIHRayLanes a, BIHRayLanes b) { for (int i = 0; i < BIH_RAY_PACKET_SIZE; ++i) a.v[i] *= b.v[i]; return a; }
+    static BIHRayLanes min(BIHRayLanes a, BIHRayLanes b) { for (int i = 0; i < BIH_RAY_PACKET_SIZE; ++i) a.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i]; return a; }
+    static BIHRayLanes max(BIHRayLanes a, BIHRayLanes b) { for (int i = 0; i < BIH_RAY_PACKET_SIZE; ++i) a.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i]; return a; }
+    static BIHRayLanes select(BIHRayLanes mask, BIHRayLanes a, BIHRayLanes b) { for (int i = 0; i < BIH_RAY_PACKET_SIZE; ++i) a.v[i] = floatToRawIntBits(mask.v[i]) ? a.v[i] : b.v[i]; return a; }
+    static uint32 lessEqual(BIHRayLanes a, BIHRayLanes b) { uint32 r = 0; for (int i = 0; i < BIH_RAY_PACKET_SIZE; ++i) if (a.v[i] <= b.v[i]) r |= 1 << i; return r; }
+#endif
+};
+
 /** Bounding Interval Hierarchy Class.
 Building and Ray-Intersection functions based on BIH from
 Sunflow, a Java Raytracer, released under MIT/X11 License
@@ -120,35 +158,13 @@ public:
     template<typename RayCallback>
     void intersectRay(const G3D::Ray &r, RayCallback& intersectCallback, float &maxDist, bool stopAtFirst = false) const
     {
-        float intervalMin = -1.f;
-        float intervalMax = -1.f;
+        float intervalMin;
+        float intervalMax;
         G3D::Vector3 org = r.origin();
         G3D::Vector3 dir = r.direction();
         G3D::Vector3 invDir;
-        for (int i = 0; i<3; ++i)
-        {
-            invDir[i] = 1.f / dir[i];
-            if (G3D::fuzzyNe(dir[i], 0.0f))
-            {
-                float t1 = (bounds.low()[i] - org[i]) * invDir[i];
-                float t2 = (bounds.high()[i] - org[i]) * invDir[i];
-                if (t1 > t2)
-                    std::swap(t1, t2);
-                if (t1 > intervalMin)
-                    intervalMin = t1;
-                if (t2 < intervalMax || intervalMax < 0.f)
-                    intervalMax = t2;
-                // intervalMax can only become smaller for other axis,
-                //  and intervalMin only larger respectively, so stop early
-                if (intervalMax <= 0 || intervalMin >= maxDist)
-                    return;
-            }
-        }
-
-        if (intervalMin > intervalMax)
+        if (!clipRay(r, maxDist, invDir, intervalMin, intervalMax))
             return;
-        intervalMin = std::max(intervalMin, 0.f);
-        intervalMax = std::min(intervalMax, maxDist);
 
         uint32 offsetFront[3];
         uint32 offsetBack[3];
@@ -256,6 +272,169 @@ public:
         }
     }
 
+    /** Intersect up to BIH_RAY_PACKET_SIZE rays in the same traversal, bit i of rayMask set for each ray to intersect.
+    rays and maxDist have BIH_RAY_PACKET_SIZE entries, the ones not in rayMask are ignored. Rays can have different
+    origins, they are best going through the same nodes (same origin or same destination).
+    The callback is called as intersectCallback(rays, maxDist, rayMask, entry, stopAtFirst) for the rays reaching
+    the entry and returns the mask of the rays hitting it. Returns the mask of the rays which hit something. */
+    template<typename RayCallback>
+    uint32 intersectRays(G3D::Ray const* rays, float* maxDist, uint32 rayMask, RayCallback& intersectCallback, bool stopAtFirst = false) const
+    {
+        // lanes of unused rays have an empty interval and are never in the traversal mask
+        float org[3][BIH_RAY_PACKET_SIZE] = { };
+        float invDir[3][BIH_RAY_PACKET_SIZE] = { };
+        float dirSign[3][BIH_RAY_PACKET_SIZE] = { };
+        float intervalMin[BIH_RAY_PACKET_SIZE] = { };
+        float intervalMax[BIH_RAY_PACKET_SIZE] = { };
+        uint32 negativeDir[3] = { };
+        uint32 mask = 0;
+        for (uint32 i = 0; i < BIH_RAY_PACKET_SIZE; ++i)
+        {
+            if (!(rayMask & (1 << i)))
+                continue;
+
+            G3D::Vector3 rayInvDir;
+            if (!clipRay(rays[i], maxDist[i], rayInvDir, intervalMin[i], intervalMax[i]))
+                continue;
+
+            mask |= 1 << i;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                org[axis][i] = rays[i].origin()[axis];
+                invDir[axis][i] = rayInvDir[axis];
+                // sign bit of the direction, -0 included like in intersectRay
+                if (floatToRawIntBits(rays[i].direction()[axis]) >> 31)
+                {
+                    dirSign[axis][i] = intBitsToFloat(0xFFFFFFFF);
+                    negativeDir[axis] |= 1 << i;
+                }
+            }
+        }
+
+        if (!mask)
+            return 0;
+
+        BIHRayLanes const orgLanes[3] = { BIHRayLanes::load(org[0]), BIHRayLanes::load(org[1]), BIHRayLanes::load(org[2]) };
+        BIHRayLanes const invDirLanes[3] = { BIHRayLanes::load(invDir[0]), BIHRayLanes::load(invDir[1]), BIHRayLanes::load(invDir[2]) };
+        BIHRayLanes const dirSignLanes[3] = { BIHRayLanes::load(dirSign[0]), BIHRayLanes::load(dirSign[1]), BIHRayLanes::load(dirSign[2]) };
+        BIHRayLanes tMin = BIHRayLanes::load(intervalMin);
+        BIHRayLanes tMax = BIHRayLanes::load(intervalMax);
+
+        uint32 hitMask = 0;
+        PacketStackNode stack[MAX_STACK_SIZE];
+        int stackPos = 0;
+        int node = 0;
+
+        while (true) {
+            while (true)
+            {
+                uint32 tn = tree[node];
+                uint32 axis = (tn & (3 << 30)) >> 30;
+                bool BVH2 = (tn & (1 << 29)) != 0;
+                int offset = tn & ~(7 << 29);
+                if (!BVH2)
+                {
+                    if (axis < 3)
+                    {
+                        // "normal" interior node, left child is below the left clip plane and right child above the right one
+                        BIHRayLanes tl = BIHRayLanes::mul(BIHRayLanes::sub(BIHRayLanes::set(intBitsToFloat(tree[node + 1])), orgLanes[axis]), invDirLanes[axis]);
+                        BIHRayLanes tr = BIHRayLanes::mul(BIHRayLanes::sub(BIHRayLanes::set(intBitsToFloat(tree[node + 2])), orgLanes[axis]), invDirLanes[axis]);
+                        BIHRayLanes leftMin = BIHRayLanes::select(dirSignLanes[axis], BIHRayLanes::max(tl, tMin), tMin);
+                        BIHRayLanes leftMax = BIHRayLanes::select(dirSignLanes[axis], tMax, BIHRayLanes::min(tl, tMax));
+                        BIHRayLanes rightMin = BIHRayLanes::select(dirSignLanes[axis], tMin, BIHRayLanes::max(tr, tMin));
+                        BIHRayLanes rightMax = BIHRayLanes::select(dirSignLanes[axis], BIHRayLanes::min(tr, tMax), tMax);
+                        uint32 leftMask = mask & BIHRayLanes::lessEqual(leftMin, leftMax);
+                        uint32 rightMask = mask & BIHRayLanes::lessEqual(rightMin, rightMax);
+                        // rays pass between clip zones
+                        if (!leftMask && !rightMask)
+                            break;
+
+                        // rays pass through one node only
+                        if (!leftMask || !rightMask)
+                        {
+                            node = leftMask ? offset : offset + 3;
+                            mask = leftMask ? leftMask : rightMask;
+                            tMin = leftMask ? leftMin : rightMin;
+                            tMax = leftMask ? leftMax : rightMax;
+                            continue;
+                        }
+
+                        // rays pass through both nodes, the near one of the first ray is visited first
+                        PacketStackNode& back = stack[stackPos++];
+                        if (negativeDir[axis] & mask & (~mask + 1))
+                        {
+                            back = { leftMin, leftMax, uint32(offset), leftMask };
+                            node = offset + 3;
+                            mask = rightMask;
+                            tMin = rightMin;
+                            tMax = rightMax;
+                        }
+                        else
+                        {
+                            back = { rightMin, rightMax, uint32(offset + 3), rightMask };
+                            node = offset;
+                            mask = leftMask;
+                            tMin = leftMin;
+                            tMax = leftMax;
+                        }
+                        continue;
+                    }
+                    else
+                    {
+                        // leaf - test some objects
+                        int n = tree[node + 1];
+                        while (n > 0) {
+                            uint32 hit = intersectCallback(rays, maxDist, mask, objects[offset], stopAtFirst) & mask;
+                            hitMask |= hit;
+                            if (stopAtFirst && hit)
+                            {
+                                if ((hitMask & rayMask) == rayMask)
+                                    return hitMask;
+                                mask &= ~hit;
+                                if (!mask)
+                                    break;
+                            }
+                            --n;
+                            ++offset;
+                        }
+                        break;
+                    }
+                }
+                else
+                {
+                    if (axis>2)
+                        return hitMask; // should not happen
+                    BIHRayLanes tl = BIHRayLanes::mul(BIHRayLanes::sub(BIHRayLanes::set(intBitsToFloat(tree[node + 1])), orgLanes[axis]), invDirLanes[axis]);
+                    BIHRayLanes tr = BIHRayLanes::mul(BIHRayLanes::sub(BIHRayLanes::set(intBitsToFloat(tree[node + 2])), orgLanes[axis]), invDirLanes[axis]);
+                    node = offset;
+                    tMin = BIHRayLanes::max(BIHRayLanes::select(dirSignLanes[axis], tr, tl), tMin);
+                    tMax = BIHRayLanes::min(BIHRayLanes::select(dirSignLanes[axis], tl, tr), tMax);
+                    mask &= BIHRayLanes::lessEqual(tMin, tMax);
+                    if (!mask)
+                        break;
+                    continue;
+                }
+            } // traversal loop
+            do
+            {
+                // stack is empty?
+                if (stackPos == 0)
+                    return hitMask;
+                // move back up the stack
+                stackPos--;
+                tMin = stack[stackPos].tnear;
+                mask = stack[stackPos].mask & BIHRayLanes::lessEqual(tMin, BIHRayLanes::load(maxDist));
+                if (stopAtFirst)
+                    mask &= ~hitMask;
+                if (!mask)
+                    continue;
+                node = stack[stackPos].node;
+                tMax = stack[stackPos].tfar;
+                break;
+            } while (true);
+        }
+    }
+
     template<typename IsectCallback>
     void intersectPoint(const G3D::Vector3 &p, IsectCallback& intersectCallback) const
     {
@@ -355,6 +534,47 @@ protected:
         float tnear;
         float tfar;
     };
+    struct PacketStackNode
+    {
+        BIHRayLanes tnear;
+        BIHRayLanes tfar;
+        uint32 node;
+        uint32 mask;
+    };
+
+    // Ray interval inside the tree bounds, false if the ray misses them within maxDist
+    bool clipRay(G3D::Ray const& r, float maxDist, G3D::Vector3& invDir, float& intervalMin, float& intervalMax) const
+    {
+        intervalMin = -1.f;
+        intervalMax = -1.f;
+        G3D::Vector3 const& org = r.origin();
+        G3D::Vector3 const& dir = r.direction();
+        for (int i = 0; i<3; ++i)
+        {
+            invDir[i] = 1.f / dir[i];
+            if (G3D::fuzzyNe(dir[i], 0.0f))
+            {
+                float t1 = (bounds.low()[i] - org[i]) * invDir[i];
+                float t2 = (bounds.high()[i] - org[i]) * invDir[i];
+                if (t1 > t2)
+                    std::swap(t1, t2);
+                if (t1 > intervalMin)
+                    intervalMin = t1;
+                if (t2 < intervalMax || intervalMax < 0.f)
+                    intervalMax = t2;
+                // intervalMax can only become smaller for other axis,
+                //  and intervalMin only larger respectively, so stop early
+                if (intervalMax <= 0 || intervalMin >= maxDist)
+                    return false;
+            }
+        }
+
+        if (intervalMin > intervalMax)
+            return false;
+        intervalMin = std::max(intervalMin, 0.f);
+        intervalMax = std::min(intervalMax, maxDist);
+        return true;
+    }
 
     class BuildStats
     {
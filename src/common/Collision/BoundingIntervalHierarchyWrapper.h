@@ -47,6 +47,16 @@ class BIHWrap
             return false;
         }
 
+        /// Intersect rays
+        uint32 operator() (const G3D::Ray* rays, float* maxDist, uint32 rayMask, uint32 idx, bool /*stopAtFirst*/)
+        {
+            if (idx >= objects_size)
+                return 0;
+            if (const T* obj = objects[idx])
+                return _callback(rays, maxDist, rayMask, *obj);
+            return 0;
+        }
+
         /// Intersect point
         void operator() (const G3D::Vector3& p, uint32 idx)
         {
@@ -107,6 +117,14 @@ public:
         m_tree.intersectRay(ray, temp_cb, maxDist, true);
     }
 
+    template<typename RayCallback>
+    uint32 intersectRays(const G3D::Ray* rays, float* maxDist, uint32 rayMask, RayCallback& intersectCallback)
+    {
+        balance();
+        MDLCallback<RayCallback> temp_cb(intersectCallback, m_objects.getCArray(), m_objects.size());
+        return m_tree.intersectRays(rays, maxDist, rayMask, temp_cb, true);
+    }
+
     template<typename IsectCallback>
     void intersectPoint(const G3D::Vector3& point, IsectCallback& intersectCallback)
     {
@@ -27,6 +27,7 @@
 #include "GameObjectModel.h"
 #include "ModelInstance.h"
 #include "ModelIgnoreFlags.h"
+#include "IVMapManager.h"
 
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
@@ -150,6 +151,13 @@ struct DynamicTreeIntersectionCallback
         did_hit = obj.intersectRay(r, distance, true, phase_mask, VMAP::ModelIgnoreFlags::Nothing);
         return did_hit;
     }
+    uint32 operator()(G3D::Ray const* rays, float* distances, uint32 rayMask, GameObjectModel const& obj)
+    {
+        uint32 hitMask = obj.intersectRays(rays, distances, rayMask, true, phase_mask, VMAP::ModelIgnoreFlags::Nothing);
+        if (hitMask)
+            did_hit = true;
+        return hitMask;
+    }
     bool didHit() const { return did_hit;}
 };
 
@@ -242,6 +250,39 @@ bool DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, float x2, flo
     return !callback.did_hit;
 }
 
+void DynamicMapTree::isInLineOfSight(VMAP::LineOfSightQuery* queries, uint32 count, uint32 phasemask) const
+{
+    G3D::Ray rays[BIH_RAY_PACKET_SIZE];
+    G3D::Vector3 ends[BIH_RAY_PACKET_SIZE];
+    float maxDist[BIH_RAY_PACKET_SIZE] = { };
+    VMAP::LineOfSightQuery* packet[BIH_RAY_PACKET_SIZE];
+    uint32 packetSize = 0;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        VMAP::LineOfSightQuery& query = queries[i];
+        query.result = true;
+
+        G3D::Vector3 v1(query.x1, query.y1, query.z1), v2(query.x2, query.y2, query.z2);
+        float dist = (v2 - v1).magnitude();
+        if (G3D::fuzzyGt(dist, 0))
+        {
+            rays[packetSize] = G3D::Ray(v1, (v2 - v1) / dist);
+            ends[packetSize] = v2;
+            maxDist[packetSize] = dist;
+            packet[packetSize++] = &query;
+        }
+
+        if (packetSize == BIH_RAY_PACKET_SIZE || (packetSize && i + 1 == count))
+        {
+            DynamicTreeIntersectionCallback callback(phasemask);
+            uint32 hitMask = impl->intersectRays(rays, maxDist, ends, (1 << packetSize) - 1, callback);
+            for (uint32 j = 0; j < packetSize; ++j)
+                packet[j]->result = !(hitMask & (1 << j));
+            packetSize = 0;
+        }
+    }
+}
+
 float DynamicMapTree::getHeight(float x, float y, float z, float maxSearchDist, uint32 phasemask) const
 {
     G3D::Vector3 v(x, y, z);
@@ -10,6 +10,11 @@ namespace G3D
     class Vector3;
 }
 
+namespace VMAP
+{
+    struct LineOfSightQuery;
+}
+
 class GameObjectModel;
 struct DynTreeImpl;
 
@@ -24,6 +29,8 @@ public:
 
     bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2,
                          float z2, uint32 phasemask) const;
+    // Set result of each query, queries are intersected by packets of rays
+    void isInLineOfSight(VMAP::LineOfSightQuery* queries, uint32 count, uint32 phasemask) const;
 
     bool getIntersectionTime(uint32 phasemask, const G3D::Ray& ray,
                              const G3D::Vector3& endPos, float& maxDist) const;
@@ -27,9 +27,34 @@ namespace MMAP
     static char const* const TILE_FILE_NAME_FORMAT = "%s/mmaps/%03i%02i%02i.mmtile";
     static char const* const GAMEOBJECT_FILE_NAME_FORMAT = "%s/mmaps/go%04i.mmap";
 
+    std::atomic<uint32> MMapData::nextId(0);
+
+    namespace
+    {
+        // dtNavMeshQuery are not thread safe, each thread gets its own ones
+        struct ThreadNavMeshQueries
+        {
+            ~ThreadNavMeshQueries()
+            {
+                for (auto& itr : mapQueries)
+                    dtFreeNavMeshQuery(itr.second.second);
+                for (auto& itr : modelQueries)
+                    dtFreeNavMeshQuery(itr.second.second);
+            }
+
+            // key to (MMapData id, query)
+            std::unordered_map<uint32, std::pair<uint32, dtNavMeshQuery*>> mapQueries;   // by map id
+            std::unordered_map<uint32, std::pair<uint32, dtNavMeshQuery*>> modelQueries; // by display id
+        };
+
+        thread_local ThreadNavMeshQueries threadQueries;
+    }
+
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
+        StopTileLoader();
+
         for (auto & loadedMMap : loadedMMaps)
             delete loadedMMap.second;
 
@@ -129,13 +154,23 @@ namespace MMAP
         if (mmap->loadedTileRefs.find(packedGridPos) != mmap->loadedTileRefs.end())
             return false;
 
+        uint32 dataSize = 0;
+        unsigned char* data = readTile(mapId, x, y, dataSize);
+        if (!data)
+            return false;
+
+        return addTile(mmap, mapId, x, y, data, dataSize);
+    }
+
+    unsigned char* MMapManager::readTile(uint32 mapId, int32 x, int32 y, uint32& dataSize)
+    {
         // load this tile :: mmaps/MMMXXYY.mmtile
         std::string fileName = Trinity::StringFormat(TILE_FILE_NAME_FORMAT, sConfigMgr->GetStringDefault("DataDir", ".").c_str(), mapId, x, y);
         FILE* file = fopen(fileName.c_str(), "rb");
         if (!file)
         {
             TC_LOG_DEBUG("maps", "MMAP:loadMap: Could not open mmtile file '%s'", fileName.c_str());
-            return false;
+            return nullptr;
         }
 
         // read header
@@ -144,7 +179,7 @@ namespace MMAP
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: Bad header in mmap %03u%02i%02i.mmtile", mapId, x, y);
             fclose(file);
-            return false;
+            return nullptr;
         }
 
         if (fileHeader.mmapVersion != MMAP_VERSION)
@@ -152,7 +187,7 @@ namespace MMAP
             TC_LOG_ERROR("maps", "MMAP:loadMap: %03u%02i%02i.mmtile was built with generator v%i, expected v%i",
                 mapId, x, y, fileHeader.mmapVersion, MMAP_VERSION);
             fclose(file);
-            return false;
+            return nullptr;
         }
 
         unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
@@ -163,18 +198,25 @@ namespace MMAP
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
             fclose(file);
-            return false;
+            dtFree(data);
+            return nullptr;
         }
 
         fclose(file);
 
+        dataSize = fileHeader.size;
+        return data;
+    }
+
+    bool MMapManager::addTile(MMapData* mmap, uint32 mapId, int32 x, int32 y, unsigned char* data, uint32 dataSize)
+    {
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
+        if (dtStatusSucceed(mmap->navMesh->addTile(data, dataSize, DT_TILE_FREE_DATA, 0, &tileRef)))
         {
-            mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+            mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packTileID(x, y), tileRef));
             ++loadedTiles;
             TC_LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile %03i[%02i, %02i] into %03i[%02i, %02i]", mapId, x, y, mapId, header->x, header->y);
             return true;
@@ -185,8 +227,132 @@ namespace MMAP
             dtFree(data);
             return false;
         }
+    }
 
-        return false;
+    bool MMapManager::loadMapAsync(uint32 mapId, int32 x, int32 y, TileLoadedCallback callback)
+    {
+        if (!IsTileLoaderStarted())
+        {
+            bool const result = loadMap("", mapId, x, y);
+            if (callback)
+                callback(result);
+            return result;
+        }
+
+        // make sure the mmap is loaded and ready to load tiles, this one is small enough to be read right away
+        if (!loadMapData(mapId))
+        {
+            if (callback)
+                callback(false);
+            return false;
+        }
+
+        MMapData* mmap = loadedMMaps[mapId];
+        ASSERT(mmap->navMesh);
+
+        // check if we already have this tile loaded or queued
+        uint32 packedGridPos = packTileID(x, y);
+        if (mmap->loadedTileRefs.count(packedGridPos) || mmap->pendingTiles.count(packedGridPos))
+            return false;
+
+        mmap->pendingTiles.insert(packedGridPos);
+        {
+            std::lock_guard<std::mutex> lock(_tileLoaderLock);
+            _tileLoadQueue.push_back({ mapId, x, y, std::move(callback), nullptr, 0 });
+        }
+        _tileLoaderCondition.notify_one();
+        return true;
+    }
+
+    void MMapManager::processLoadedTiles(uint32 mapId)
+    {
+        std::vector<TileLoadRequest> requests;
+        {
+            std::lock_guard<std::mutex> lock(_tileLoaderLock);
+            auto itr = _loadedTileRequests.find(mapId);
+            if (itr == _loadedTileRequests.end())
+                return;
+
+            requests.swap(itr->second);
+            _loadedTileRequests.erase(itr);
+        }
+
+        auto itr = GetMMapData(mapId);
+        for (TileLoadRequest& request : requests)
+        {
+            // map or tile has been unloaded since request
+            if (itr == loadedMMaps.end() || !itr->second->pendingTiles.erase(packTileID(request.x, request.y)))
+            {
+                if (request.data)
+                    dtFree(request.data);
+                continue;
+            }
+
+            bool const result = request.data && addTile(itr->second, mapId, request.x, request.y, request.data, request.dataSize);
+            if (request.callback)
+                request.callback(result);
+        }
+    }
+
+    void MMapManager::StartTileLoader()
+    {
+        if (IsTileLoaderStarted())
+            return;
+
+        _stopTileLoader = false;
+        _tileLoaderThread = std::thread(&MMapManager::TileLoaderThread, this);
+    }
+
+    void MMapManager::StopTileLoader()
+    {
+        if (!IsTileLoaderStarted())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_tileLoaderLock);
+            _stopTileLoader = true;
+        }
+        _tileLoaderCondition.notify_all();
+        _tileLoaderThread.join();
+
+        // drop everything not yet added to navmeshes
+        for (TileLoadRequest& request : _tileLoadQueue)
+            if (request.data)
+                dtFree(request.data);
+        _tileLoadQueue.clear();
+
+        for (auto& itr : _loadedTileRequests)
+            for (TileLoadRequest& request : itr.second)
+                if (request.data)
+                    dtFree(request.data);
+        _loadedTileRequests.clear();
+
+        for (auto& itr : loadedMMaps)
+            if (itr.second)
+                itr.second->pendingTiles.clear();
+    }
+
+    void MMapManager::TileLoaderThread()
+    {
+        while (true)
+        {
+            TileLoadRequest request;
+            {
+                std::unique_lock<std::mutex> lock(_tileLoaderLock);
+                _tileLoaderCondition.wait(lock, [this] { return _stopTileLoader || !_tileLoadQueue.empty(); });
+                if (_stopTileLoader)
+                    return;
+
+                request = std::move(_tileLoadQueue.front());
+                _tileLoadQueue.pop_front();
+            }
+
+            request.dataSize = 0;
+            request.data = readTile(request.mapId, request.x, request.y, request.dataSize);
+
+            std::lock_guard<std::mutex> lock(_tileLoaderLock);
+            _loadedTileRequests[request.mapId].push_back(std::move(request));
+        }
     }
 
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
@@ -204,6 +370,11 @@ namespace MMAP
 
         // check if we have this tile loaded
         uint32 packedGridPos = packTileID(x, y);
+
+        // not loaded yet, just make sure it won't be added to navmesh once read
+        if (mmap->pendingTiles.erase(packedGridPos))
+            return true;
+
         if (mmap->loadedTileRefs.find(packedGridPos) == mmap->loadedTileRefs.end())
         {
             // file may not exist, therefore not loaded
@@ -265,66 +436,50 @@ namespace MMAP
         return true;
     }
 
-    bool MMapManager::unloadMapInstance(uint32 mapId, uint32 instanceId)
+    dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
     {
-        // check if we have this map loaded
         auto itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
-        {
-            // file may not exist, therefore not loaded
-            TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded navmesh map %03u", mapId);
-            return false;
-        }
-
-        MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-        {
-            TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %03u instanceId %u", mapId, instanceId);
-            return false;
-        }
-
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
-
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
-        TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
+            return nullptr;
 
-        return true;
+        return itr->second->navMesh;
     }
 
-    dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
+    dtNavMeshQuery const* MMapManager::GetThreadQuery(std::unordered_map<uint32, std::pair<uint32, dtNavMeshQuery*>>& queries, uint32 key, MMapData const* mmap)
     {
-        auto itr = GetMMapData(mapId);
-        if (itr == loadedMMaps.end())
+        auto& entry = queries[key];
+        if (entry.second && entry.first == mmap->id)
+            return entry.second;
+
+        // navmesh has been reloaded since this query was made
+        if (entry.second)
+            dtFreeNavMeshQuery(entry.second);
+
+        // allocate mesh query
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            queries.erase(key);
             return nullptr;
+        }
 
-        return itr->second->navMesh;
+        entry = std::make_pair(mmap->id, query);
+        return query;
     }
 
-    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
+    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId)
     {
         auto itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
             return nullptr;
 
-        MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-        {
-            // allocate mesh query
-            dtNavMeshQuery* query = dtAllocNavMeshQuery();
-            ASSERT(query);
-            if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
-            {
-                dtFreeNavMeshQuery(query);
-                TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-                return nullptr;
-            }
+        dtNavMeshQuery const* query = GetThreadQuery(threadQueries.mapQueries, mapId, itr->second);
+        if (!query)
+            TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
 
-            TC_LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-            mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
-        }
-
-        return mmap->navMeshQueries[instanceId];
+        return query;
     }
 
     bool MMapManager::loadGameObject(uint32 displayId)
@@ -397,32 +552,14 @@ namespace MMAP
 
     dtNavMeshQuery const* MMapManager::GetModelNavMeshQuery(uint32 displayId)
     {
-        if (loadedModels.find(displayId) == loadedModels.end())
+        auto itr = loadedModels.find(displayId);
+        if (itr == loadedModels.end())
             return nullptr;
 
-        MMapData* mmap = loadedModels[displayId];
-
-        dtNavMeshQuery* navMeshQuery = nullptr;
-
-        NavMeshQuerySet::iterator it = mmap->navMeshQueries.find(displayId);
-        if (it == mmap->navMeshQueries.end())
-        {
-            // allocate mesh query
-            navMeshQuery = dtAllocNavMeshQuery();
-            ASSERT(navMeshQuery);
-            if (dtStatusFailed(navMeshQuery->init(mmap->navMesh, 1024)))
-            {
-                dtFreeNavMeshQuery(navMeshQuery);
-                TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for displayid %03u displayId %u", displayId, displayId);
-                return nullptr;
-            }
-
-            TC_LOG_TRACE("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for displayid %03u displayId %u", displayId, displayId);
-            mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(displayId, navMeshQuery));
-        }
-        else
-            navMeshQuery = it->second;
+        dtNavMeshQuery const* query = GetThreadQuery(threadQueries.modelQueries, displayId, itr->second);
+        if (!query)
+            TC_LOG_ERROR("maps", "MMAP:GetModelNavMeshQuery: Failed to initialize dtNavMeshQuery for displayId %u", displayId);
 
-        return navMeshQuery;
+        return query;
     }
 }
@@ -23,70 +23,112 @@
 #include "DetourAlloc.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 //  move map related classes
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
 
     // dummy struct to hold map's mmap data
     struct TC_COMMON_API MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
+        MMapData(dtNavMesh* mesh) : navMesh(mesh), id(++nextId) { }
         ~MMapData()
         {
-            for (auto & navMeshQuerie : navMeshQueries)
-                dtFreeNavMeshQuery(navMeshQuerie.second);
-
             if (navMesh)
                 dtFreeNavMesh(navMesh);
         }
 
         dtNavMesh* navMesh;
+        // unique for each MMapData, allows threads to detect their query was made for an older navmesh of the same map
+        uint32 const id;
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries;     // instanceId to query
         MMapTileSet loadedTileRefs;         // maps [map grid coords] to [dtTile]
+        std::unordered_set<uint32> pendingTiles; // tiles queued in tile loader thread, [map grid coords]
+
+    private:
+        static std::atomic<uint32> nextId;
     };
 
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
+    // called with false if tile could not be loaded
+    typedef std::function<void(bool)> TileLoadedCallback;
 
     // singleton class
     // holds all all access to mmap loading unloading and meshes
     class TC_COMMON_API MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0), thread_safe_environment(true) {}
+            MMapManager() : loadedTiles(0), thread_safe_environment(true), _stopTileLoader(false) {}
             ~MMapManager();
 
             void InitializeThreadUnsafe(const std::vector<uint32>& mapIds);
             bool loadMap(const std::string& basePath, uint32 mapId, int32 x, int32 y);
+            /* Queue tile file read in tile loader thread. Tile is added to navmesh (and callback called) by the next
+            processLoadedTiles call for this map. Tile is loaded right away if tile loader isn't started. */
+            bool loadMapAsync(uint32 mapId, int32 x, int32 y, TileLoadedCallback callback);
+            // add tiles read by tile loader thread to navmesh, must be called from the thread owning this map tiles
+            void processLoadedTiles(uint32 mapId);
             bool loadGameObject(uint32 displayId);
             bool unloadMap(uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId);
-            bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
-            // the returned [dtNavMeshQuery const*] is NOT threadsafe
-            dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+            void StartTileLoader();
+            void StopTileLoader();
+            bool IsTileLoaderStarted() const { return _tileLoaderThread.joinable(); }
+
+            // Returned queries belong to the calling thread, they can be used concurrently with other threads queries
+            dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId);
             dtNavMeshQuery const* GetModelNavMeshQuery(uint32 displayId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
         private:
+            struct TileLoadRequest
+            {
+                uint32 mapId;
+                int32 x;
+                int32 y;
+                TileLoadedCallback callback;
+                unsigned char* data;  // set by tile loader thread, nullptr if loading failed
+                uint32 dataSize;
+            };
+
             bool loadMapData(uint32 mapId);
             uint32 packTileID(int32 x, int32 y);
+            // read tile file, returned data is allocated with dtAlloc. Does not access manager state, can be called from any thread.
+            static unsigned char* readTile(uint32 mapId, int32 x, int32 y, uint32& dataSize);
+            // add tile data to navmesh, data ownership is given to navmesh on success
+            bool addTile(MMapData* mmap, uint32 mapId, int32 x, int32 y, unsigned char* data, uint32 dataSize);
+            static dtNavMeshQuery const* GetThreadQuery(std::unordered_map<uint32, std::pair<uint32, dtNavMeshQuery*>>& queries, uint32 key, MMapData const* mmap);
+
+            void TileLoaderThread();
 
             MMapDataSet::const_iterator GetMMapData(uint32 mapId) const;
             MMapDataSet loadedMMaps;
             MMapDataSet loadedModels;
             uint32 loadedTiles;
             bool thread_safe_environment;
+
+            std::thread _tileLoaderThread;
+            std::mutex _tileLoaderLock;
+            std::condition_variable _tileLoaderCondition;
+            std::deque<TileLoadRequest> _tileLoadQueue;
+            // read tiles waiting for processLoadedTiles, by map id
+            std::unordered_map<uint32, std::vector<TileLoadRequest>> _loadedTileRequests;
+            bool _stopTileLoader;
     };
 }
 
@@ -181,6 +181,44 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, LineOfSightQuery* queries, uint32 count, ModelIgnoreFlags ignoreFlags)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            queries[i].result = true;
+
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+            return;
+
+        auto instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        Vector3 pos1[BIH_RAY_PACKET_SIZE];
+        Vector3 pos2[BIH_RAY_PACKET_SIZE];
+        bool results[BIH_RAY_PACKET_SIZE];
+        LineOfSightQuery* packet[BIH_RAY_PACKET_SIZE];
+        uint32 packetSize = 0;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            Vector3 start = convertPositionToInternalRep(queries[i].x1, queries[i].y1, queries[i].z1);
+            Vector3 end = convertPositionToInternalRep(queries[i].x2, queries[i].y2, queries[i].z2);
+            if (start != end)
+            {
+                pos1[packetSize] = start;
+                pos2[packetSize] = end;
+                packet[packetSize++] = &queries[i];
+            }
+
+            if (packetSize == BIH_RAY_PACKET_SIZE || (packetSize && i + 1 == count))
+            {
+                instanceTree->second->isInLineOfSight(pos1, pos2, results, packetSize, ignoreFlags);
+                for (uint32 j = 0; j < packetSize; ++j)
+                    packet[j]->result = results[j];
+                packetSize = 0;
+            }
+        }
+    }
+
     /* same as getObjectHitPos but a bit more gentle, will try from a bit higher and return collision from there if it gets further */
     bool VMapManager2::getLeapHitPos(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist)
     {
@@ -44,6 +44,13 @@ namespace VMAP
                     hit = true;
                 return result;
             }
+            uint32 operator()(const G3D::Ray* rays, float* distances, uint32 rayMask, uint32 entry, bool pStopAtFirstHit)
+            {
+                uint32 result = prims[entry].intersectRays(rays, distances, rayMask, pStopAtFirstHit, flags);
+                if (result)
+                    hit = true;
+                return result;
+            }
         bool didHit() { return hit; }
     protected:
         ModelInstance* prims;
@@ -207,6 +214,42 @@ namespace VMAP
     }
     //=========================================================
 
+    void StaticMapTree::isInLineOfSight(const Vector3* pos1, const Vector3* pos2, bool* results, uint32 count, ModelIgnoreFlags ignoreFlags) const
+    {
+        ASSERT(count <= BIH_RAY_PACKET_SIZE);
+
+        G3D::Ray rays[BIH_RAY_PACKET_SIZE];
+        float maxDist[BIH_RAY_PACKET_SIZE] = { };
+        uint32 rayMask = 0;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            // same checks as for a single ray
+            maxDist[i] = (pos2[i] - pos1[i]).magnitude();
+            if (maxDist[i] == std::numeric_limits<float>::max() || !std::isfinite(maxDist[i]))
+            {
+                results[i] = false;
+                continue;
+            }
+
+            results[i] = true;
+            if (maxDist[i] < 1e-10f)
+                continue;
+
+            rays[i] = G3D::Ray::fromOriginAndDirection(pos1[i], (pos2[i] - pos1[i]) / maxDist[i]);
+            rayMask |= 1 << i;
+        }
+
+        if (!rayMask)
+            return;
+
+        MapRayCallback intersectionCallBack(iTreeValues, ignoreFlags);
+        uint32 hitMask = iTree.intersectRays(rays, maxDist, rayMask, intersectionCallBack, true);
+        for (uint32 i = 0; i < count; ++i)
+            if (hitMask & (1 << i))
+                results[i] = false;
+    }
+    //=========================================================
+
     bool StaticMapTree::getObjectHitPos(const Vector3& pPos1, const Vector3& pPos2, Vector3& pResultHitPos, float pModifyDist) const
     {
         bool result=false;
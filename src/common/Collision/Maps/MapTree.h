@@ -60,6 +60,10 @@ namespace VMAP
 
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2, ModelIgnoreFlags ignoreFlags) const;
             /**
+            Line of sight from pos1[i] to pos2[i] for up to BIH_RAY_PACKET_SIZE pairs, checked in a single tree traversal
+            */
+            void isInLineOfSight(const G3D::Vector3* pos1, const G3D::Vector3* pos2, bool* results, uint32 count, ModelIgnoreFlags ignoreFlags) const;
+            /**
             When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
             Return the hit pos or the original dest pos
             */
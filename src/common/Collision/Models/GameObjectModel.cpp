@@ -172,6 +172,36 @@ bool GameObjectModel::intersectRay(const G3D::Ray& ray, float& MaxDist, bool Sto
     return hit;
 }
 
+uint32 GameObjectModel::intersectRays(const G3D::Ray* rays, float* maxDist, uint32 rayMask, bool StopAtFirstHit, uint32 ph_mask, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    if (!(phasemask & ph_mask) || !owner->IsSpawned())
+        return 0;
+
+    // child bounds are defined in object space:
+    Ray modRays[BIH_RAY_PACKET_SIZE];
+    float distances[BIH_RAY_PACKET_SIZE] = { };
+    uint32 boundMask = 0;
+    for (uint32 i = 0; i < BIH_RAY_PACKET_SIZE; ++i)
+    {
+        if (!(rayMask & (1 << i)) || rays[i].intersectionTime(iBound) == G3D::inf())
+            continue;
+
+        Vector3 p = iInvRot * (rays[i].origin() - iPos) * iInvScale;
+        modRays[i] = Ray(p, iInvRot * rays[i].direction());
+        distances[i] = maxDist[i] * iInvScale;
+        boundMask |= 1 << i;
+    }
+
+    if (!boundMask)
+        return 0;
+
+    uint32 hitMask = iModel->IntersectRays(modRays, distances, boundMask, StopAtFirstHit, ignoreFlags);
+    for (uint32 i = 0; i < BIH_RAY_PACKET_SIZE; ++i)
+        if (hitMask & (1 << i))
+            maxDist[i] = distances[i] * iScale;
+    return hitMask;
+}
+
 bool GameObjectModel::UpdatePosition()
 {
     if (!iModel)
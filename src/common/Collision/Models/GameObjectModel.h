@@ -68,6 +68,8 @@ public:
     bool isEnabled() const { return phasemask != 0; }
 
     bool intersectRay(const G3D::Ray& Ray, float& MaxDist, bool StopAtFirstHit, uint32 ph_mask, VMAP::ModelIgnoreFlags ignoreFlags) const;
+    // packet version of intersectRay, see BIH::intersectRays
+    uint32 intersectRays(const G3D::Ray* rays, float* maxDist, uint32 rayMask, bool StopAtFirstHit, uint32 ph_mask, VMAP::ModelIgnoreFlags ignoreFlags) const;
 
     static GameObjectModel* Create(std::unique_ptr<GameObjectModelOwnerBase> modelOwner, std::string const& dataPath);
 
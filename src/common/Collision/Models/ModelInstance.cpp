@@ -65,6 +65,36 @@ namespace VMAP
         return hit;
     }
 
+    uint32 ModelInstance::intersectRays(const G3D::Ray* pRays, float* pMaxDist, uint32 rayMask, bool pStopAtFirstHit, ModelIgnoreFlags ignoreFlags) const
+    {
+        if (!iModel)
+            return 0;
+
+        // child bounds are defined in object space, all rays share the model transform
+        Ray modRays[BIH_RAY_PACKET_SIZE];
+        float distances[BIH_RAY_PACKET_SIZE] = { };
+        uint32 boundMask = 0;
+        for (uint32 i = 0; i < BIH_RAY_PACKET_SIZE; ++i)
+        {
+            if (!(rayMask & (1 << i)) || pRays[i].intersectionTime(iBound) == G3D::inf())
+                continue;
+
+            Vector3 p = iInvRot * (pRays[i].origin() - iPos) * iInvScale;
+            modRays[i] = Ray(p, iInvRot * pRays[i].direction());
+            distances[i] = pMaxDist[i] * iInvScale;
+            boundMask |= 1 << i;
+        }
+
+        if (!boundMask)
+            return 0;
+
+        uint32 hitMask = iModel->IntersectRays(modRays, distances, boundMask, pStopAtFirstHit, ignoreFlags);
+        for (uint32 i = 0; i < BIH_RAY_PACKET_SIZE; ++i)
+            if (hitMask & (1 << i))
+                pMaxDist[i] = distances[i] * iScale;
+        return hitMask;
+    }
+
     void ModelInstance::intersectPoint(const G3D::Vector3& p, AreaInfo &info) const
     {
         if (!iModel)
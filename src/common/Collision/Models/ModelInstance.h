@@ -68,6 +68,8 @@ namespace VMAP
             ModelInstance(ModelSpawn spawn, WorldModel* model);
             void setUnloaded() { iModel = 0; }
             bool intersectRay(const G3D::Ray& pRay, float& pMaxDist, bool pStopAtFirstHit, ModelIgnoreFlags ignoreFlags) const;
+            // packet version of intersectRay, see BIH::intersectRays
+            uint32 intersectRays(const G3D::Ray* pRays, float* pMaxDist, uint32 rayMask, bool pStopAtFirstHit, ModelIgnoreFlags ignoreFlags) const;
             void intersectPoint(const G3D::Vector3& p, AreaInfo &info) const;
             bool isUnderModel(const G3D::Vector3& p, float* outDist = nullptr, float* inDist = nullptr) const;
             bool GetLocationInfo(const G3D::Vector3& p, LocationInfo &info) const;
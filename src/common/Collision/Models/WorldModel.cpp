@@ -357,6 +357,14 @@ namespace VMAP
             hit = IntersectTriangle(triangles[entry], vertices, ray, distance) || hit;
             return hit;
         }
+        uint32 operator()(const G3D::Ray* rays, float* distances, uint32 rayMask, uint32 entry, bool /*pStopAtFirstHit*/)
+        {
+            uint32 hitMask = 0;
+            for (uint32 i = 0; i < BIH_RAY_PACKET_SIZE; ++i)
+                if ((rayMask & (1 << i)) && IntersectTriangle(triangles[entry], vertices, rays[i], distances[i]))
+                    hitMask |= 1 << i;
+            return hitMask;
+        }
         std::vector<Vector3>::const_iterator vertices;
         std::vector<MeshTriangle>::const_iterator triangles;
         bool hit;
@@ -372,6 +380,15 @@ namespace VMAP
         return callback.hit;
     }
 
+    uint32 GroupModel::IntersectRays(const G3D::Ray* rays, float* distances, uint32 rayMask, bool stopAtFirstHit) const
+    {
+        if (triangles.empty())
+            return 0;
+
+        GModelRayCallback callback(triangles, vertices);
+        return meshTree.intersectRays(rays, distances, rayMask, callback, stopAtFirstHit);
+    }
+
     bool GroupModel::IsInsideObject(const Vector3 &pos, const Vector3 &down, float &z_dist) const
     {
         if (triangles.empty() || !iBound.contains(pos))
@@ -477,6 +494,10 @@ namespace VMAP
             if (result)  hit=true;
             return hit;
         }
+        uint32 operator()(const G3D::Ray* rays, float* distances, uint32 rayMask, uint32 entry, bool pStopAtFirstHit)
+        {
+            return models[entry].IntersectRays(rays, distances, rayMask, pStopAtFirstHit);
+        }
         std::vector<GroupModel>::const_iterator models;
         bool hit;
     };
@@ -501,6 +522,19 @@ namespace VMAP
         return isc.hit;
     }
 
+    uint32 WorldModel::IntersectRays(const G3D::Ray* rays, float* distances, uint32 rayMask, bool stopAtFirstHit, ModelIgnoreFlags ignoreFlags) const
+    {
+        // M2 models are not taken into account for LoS calculation if caller requested their ignoring.
+        if ((ignoreFlags & ModelIgnoreFlags::M2) != ModelIgnoreFlags::Nothing && (Flags & MOD_M2))
+            return 0;
+
+        if (groupModels.size() == 1)
+            return groupModels[0].IntersectRays(rays, distances, rayMask, stopAtFirstHit);
+
+        WModelRayCallBack isc(groupModels);
+        return groupTree.intersectRays(rays, distances, rayMask, isc, stopAtFirstHit);
+    }
+
     class WModelAreaCallback {
         public:
             WModelAreaCallback(const std::vector<GroupModel> &vals, const Vector3 &down):
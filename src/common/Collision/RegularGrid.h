@@ -23,7 +23,9 @@
 #include <G3D/Ray.h>
 #include <G3D/BoundsTrait.h>
 #include <G3D/PositionTrait.h>
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 template<class Node>
 struct NodeCreator{
@@ -134,6 +136,41 @@ public:
 
     template<typename RayCallback>
     void intersectRay(const G3D::Ray& ray, RayCallback& intersectCallback, float& max_dist, const G3D::Vector3& end)
+    {
+        visitCrossedNodes(ray, end, [&](Node* node)
+        {
+            node->intersectRay(ray, intersectCallback, max_dist);
+        });
+    }
+
+    /* Rays stop at their first hit. Each node crossed by one of the rays is intersected once with all the rays still
+    searched, not once per ray crossing it. Returns the mask of the rays which hit something. */
+    template<typename RayCallback>
+    uint32 intersectRays(const G3D::Ray* rays, float* max_dist, const G3D::Vector3* ends, uint32 rayMask, RayCallback& intersectCallback)
+    {
+        std::vector<Node*> crossed;
+        for (uint32 i = 0; rayMask >> i; ++i)
+        {
+            if (!(rayMask & (1 << i)))
+                continue;
+
+            visitCrossedNodes(rays[i], ends[i], [&](Node* node)
+            {
+                if (std::find(crossed.begin(), crossed.end(), node) == crossed.end())
+                    crossed.push_back(node);
+            });
+        }
+
+        uint32 hitMask = 0;
+        for (uint32 i = 0; i < crossed.size() && hitMask != rayMask; ++i)
+            hitMask |= crossed[i]->intersectRays(rays, max_dist, rayMask & ~hitMask, intersectCallback);
+        return hitMask;
+    }
+
+private:
+    // Calls visit(node) for each existing node crossed by the ray until end
+    template<typename Visitor>
+    void visitCrossedNodes(const G3D::Ray& ray, const G3D::Vector3& end, Visitor visit)
     {
         Cell cell = Cell::ComputeCell(ray.origin().x, ray.origin().y);
         if (!cell.isValid())
@@ -144,7 +181,7 @@ public:
         if (cell == last_cell)
         {
             if (Node* node = nodes[cell.x][cell.y])
-                node->intersectRay(ray, intersectCallback, max_dist);
+                visit(node);
             return;
         }
 
@@ -190,7 +227,7 @@ public:
             if (Node* node = nodes[cell.x][cell.y])
             {
                 //float enterdist = max_dist;
-                node->intersectRay(ray, intersectCallback, max_dist);
+                visit(node);
             }
             if (cell == last_cell)
                 break;
@@ -208,6 +245,7 @@ public:
         } while (cell.isValid());
     }
 
+public:
     template<typename IsectCallback>
     void intersectPoint(const G3D::Vector3& point, IsectCallback& intersectCallback)
     {
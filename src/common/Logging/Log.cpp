@@ -30,7 +30,7 @@
 #include <chrono>
 #include <sstream>
 
-Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr), _strand(nullptr)
+Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr), _strand(nullptr), _queueProcessingPosted(false)
 {
     m_logsTimestamp = "_" + GetTimestampStr();
     RegisterAppender<AppenderConsole>();
@@ -40,6 +40,7 @@ Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr)
 Log::~Log()
 {
     delete _strand;
+    ProcessQueue();
     Close();
 }
 
@@ -230,14 +231,35 @@ void Log::write(std::unique_ptr<LogMessage>&& msg) const
 
     if (_ioContext)
     {
-        std::shared_ptr<LogOperation> logOperation = std::make_shared<LogOperation>(logger, std::move(msg));
-        Trinity::Asio::post(*_ioContext, Trinity::Asio::bind_executor(*_strand, [logOperation]() { logOperation->call(); }));
+        _queue.Enqueue(new LogOperation(logger, std::move(msg)));
+
+        // Strand is already going to process the queue, no need to post again
+        if (!_queueProcessingPosted.exchange(true, std::memory_order_acq_rel))
+            Trinity::Asio::post(*_ioContext, Trinity::Asio::bind_executor(*_strand, [this]() { ProcessQueue(); }));
     }
     else
         logger->write(msg.get());
 }
 
+void Log::ProcessQueue() const
+{
+    // Reset first, so that messages enqueued while processing post a new call
+    _queueProcessingPosted.store(false, std::memory_order_seq_cst);
+
+    LogOperation* logOperation = nullptr;
+    while (_queue.Dequeue(logOperation))
+    {
+        logOperation->call();
+        delete logOperation;
+    }
+}
+
 Logger const* Log::GetLoggerByType(std::string const& type) const
+{
+    return GetLoggerHandle(type)->logger.load(std::memory_order_acquire);
+}
+
+Logger const* Log::ResolveLogger(std::string const& type) const
 {
     auto it = loggers.find(type);
     if (it != loggers.end())
@@ -251,7 +273,34 @@ Logger const* Log::GetLoggerByType(std::string const& type) const
     if (found != std::string::npos)
         parentLogger = type.substr(0, found);
 
-    return GetLoggerByType(parentLogger);
+    return ResolveLogger(parentLogger);
+}
+
+LoggerHandle const* Log::GetLoggerHandle(std::string const& type) const
+{
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(_loggerHandlesLock);
+        auto it = _loggerHandles.find(type);
+        if (it != _loggerHandles.end())
+            return it->second.get();
+    }
+
+    std::unique_lock<std::shared_timed_mutex> lock(_loggerHandlesLock);
+    std::unique_ptr<LoggerHandle>& handle = _loggerHandles[type];
+    if (!handle)
+    {
+        handle = Trinity::make_unique<LoggerHandle>();
+        handle->logger.store(ResolveLogger(type), std::memory_order_release);
+    }
+
+    return handle.get();
+}
+
+void Log::ResolveLoggerHandles()
+{
+    std::unique_lock<std::shared_timed_mutex> lock(_loggerHandlesLock);
+    for (auto& handle : _loggerHandles)
+        handle.second->logger.store(ResolveLogger(handle.first), std::memory_order_release);
 }
 
 std::string Log::GetTimestampStr()
@@ -330,20 +379,21 @@ void Log::SetRealmId(uint32 id)
 void Log::Close()
 {
     loggers.clear();
+    ResolveLoggerHandles();
     appenders.clear();
 }
 
 bool Log::ShouldLog(std::string const& type, LogLevel level) const
 {
-    // TODO: Use cache to store "Type.sub1.sub2": "Type" equivalence, should
-    // Speed up in cases where requesting "Type.sub1.sub2" but only configured
-    // Logger "Type"
-
     // Don't even look for a logger if the LogLevel is lower than lowest log levels across all loggers
     if (level < lowestLogLevel)
         return false;
 
-    Logger const* logger = GetLoggerByType(type);
+    return ShouldLog(GetLoggerByType(type), level);
+}
+
+bool Log::ShouldLog(Logger const* logger, LogLevel level)
+{
     if (!logger)
         return false;
 
@@ -370,6 +420,9 @@ void Log::Initialize(Trinity::Asio::IoContext* ioContext)
 
 void Log::SetSynchronous()
 {
+    // Strand won't run anymore, write what it still had to
+    ProcessQueue();
+
     delete _strand;
     _strand = nullptr;
     _ioContext = nullptr;
@@ -388,4 +441,5 @@ void Log::LoadFromConfig()
 
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
+    ResolveLoggerHandles();
 }
@@ -23,13 +23,17 @@
 #include "AsioHacksFwd.h"
 #include "LogCommon.h"
 #include "StringFormat.h"
+#include "MPSCQueue.h"
 
+#include <atomic>
 #include <memory>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
 class Appender;
 class Logger;
+class LogOperation;
 struct LogMessage;
 
 namespace Trinity
@@ -42,6 +46,18 @@ namespace Trinity
 
 #define LOGGER_ROOT "root"
 
+// Logger used for a "Type.sub1.sub2" filter, updated whenever loggers are reloaded. Never deleted before Log itself.
+struct LoggerHandle
+{
+    std::atomic<Logger const*> logger;
+};
+
+// Per TC_LOG_* call site cache of the filter logger, only filled for string literal filters
+struct LogCallSite
+{
+    std::atomic<LoggerHandle const*> handle;
+};
+
 typedef Appender*(*AppenderCreatorFn)(uint8 id, std::string const& name, LogLevel level, AppenderFlags flags, std::vector<char const*>&& extraArgs);
 
 template <class AppenderImpl>
@@ -70,6 +86,28 @@ class TC_COMMON_API Log
         void LoadFromConfig();
         void Close();
         bool ShouldLog(std::string const& type, LogLevel level) const;
+
+        // Call site variants, a string literal filter is resolved only once. isLiteral is given by TC_LOG_MESSAGE_BODY from the
+        // spelling of the filter, other char arrays may change between calls and are looked up each time.
+        template<size_t N>
+        bool ShouldLog(LogCallSite& site, char const (&type)[N], LogLevel level, bool isLiteral) const
+        {
+            if (!isLiteral)
+                return ShouldLog(std::string(type), level);
+
+            if (level < lowestLogLevel)
+                return false;
+
+            LoggerHandle const* handle = site.handle.load(std::memory_order_acquire);
+            if (!handle)
+            {
+                handle = GetLoggerHandle(type);
+                site.handle.store(handle, std::memory_order_release);
+            }
+
+            return ShouldLog(handle->logger.load(std::memory_order_acquire), level);
+        }
+        bool ShouldLog(LogCallSite& /*site*/, std::string const& type, LogLevel level, bool /*isLiteral*/) const { return ShouldLog(type, level); }
         bool SetLogLevel(std::string const& name, char const* level, bool isLogger = true);
 
         template<typename Format, typename... Args>
@@ -103,9 +141,16 @@ class TC_COMMON_API Log
 
     private:
         static std::string GetTimestampStr();
+        static bool ShouldLog(Logger const* logger, LogLevel level);
         void write(std::unique_ptr<LogMessage>&& msg) const;
+        // Write queued messages, on strand
+        void ProcessQueue() const;
 
         Logger const* GetLoggerByType(std::string const& type) const;
+        Logger const* ResolveLogger(std::string const& type) const;
+        LoggerHandle const* GetLoggerHandle(std::string const& type) const;
+        // Update all handles after loggers changed
+        void ResolveLoggerHandles();
         Appender* GetAppenderByName(std::string const& name);
         uint8 NextAppenderId();
         void CreateAppenderFromConfig(std::string const& name);
@@ -125,8 +170,14 @@ class TC_COMMON_API Log
         std::string m_logsDir;
         std::string m_logsTimestamp;
 
+        mutable std::shared_timed_mutex _loggerHandlesLock;
+        mutable std::unordered_map<std::string, std::unique_ptr<LoggerHandle>> _loggerHandles;
+
         Trinity::Asio::IoContext* _ioContext;
         Trinity::Asio::Strand* _strand;
+        // Messages waiting for the strand, a single ProcessQueue is posted at a time
+        mutable MPSCQueue<LogOperation> _queue;
+        mutable std::atomic<bool> _queueProcessingPosted;
 };
 
 #define sLog Log::instance()
@@ -144,6 +195,9 @@ class TC_COMMON_API Log
         } \
     }
 
+// True if the filter is written as a string literal at the call site
+#define LOG_FILTER_IS_LITERAL(filterType__) ((#filterType__)[0] == '"')
+
 #if TRINITY_PLATFORM != TRINITY_PLATFORM_WINDOWS
 void check_args(char const*, ...) ATTR_PRINTF(1, 2);
 void check_args(std::string const&, ...);
@@ -151,7 +205,8 @@ void check_args(std::string const&, ...);
 // This will catch format errors on build time
 #define TC_LOG_MESSAGE_BODY(filterType__, level__, ...)                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static LogCallSite logCallSite__;                           \
+            if (sLog->ShouldLog(logCallSite__, filterType__, level__, LOG_FILTER_IS_LITERAL(filterType__))) \
             {                                                           \
                 if (false)                                              \
                     check_args(__VA_ARGS__);                            \
@@ -164,7 +219,8 @@ void check_args(std::string const&, ...);
         __pragma(warning(push))                                         \
         __pragma(warning(disable:4127))                                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static LogCallSite logCallSite__;                           \
+            if (sLog->ShouldLog(logCallSite__, filterType__, level__, LOG_FILTER_IS_LITERAL(filterType__))) \
                 LOG_EXCEPTION_FREE(filterType__, level__, __VA_ARGS__); \
         } while (0)                                                     \
         __pragma(warning(pop))
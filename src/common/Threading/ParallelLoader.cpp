@@ -0,0 +1,106 @@
+#include "ParallelLoader.h"
+#include "Errors.h"
+#include "Log.h"
+#include "Timer.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+ParallelLoader::StepId ParallelLoader::Add(std::string name, StepFunction&& function, std::initializer_list<StepId> dependencies)
+{
+    StepId const id = StepId(_steps.size());
+
+    Step step;
+    step.name = std::move(name);
+    step.function = std::move(function);
+    for (StepId dependency : dependencies)
+    {
+        ASSERT(dependency < id);
+        _steps[dependency].dependents.push_back(id);
+        ++step.pendingDependencies;
+    }
+
+    _steps.push_back(std::move(step));
+    return id;
+}
+
+void ParallelLoader::Run(uint32 threads)
+{
+    uint32 const startTime = GetMSTime();
+    _timings.assign(_steps.size(), StepTiming());
+
+    std::mutex lock;
+    std::condition_variable condition;
+    std::set<StepId> ready; // lowest id first, so that a single thread keeps the declaration order
+    size_t remaining = _steps.size();
+
+    for (StepId id = 0; id < _steps.size(); ++id)
+        if (!_steps[id].pendingDependencies)
+            ready.insert(id);
+
+    auto work = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        for (;;)
+        {
+            condition.wait(guard, [&]() { return !ready.empty() || !remaining; });
+            if (ready.empty())
+                return;
+
+            StepId const id = *ready.begin();
+            ready.erase(ready.begin());
+            Step& step = _steps[id];
+
+            guard.unlock();
+            uint32 const stepStart = GetMSTime();
+            step.function();
+            uint32 const stepEnd = GetMSTime();
+            guard.lock();
+
+            _timings[id].name = step.name;
+            _timings[id].start = GetMSTimeDiff(startTime, stepStart);
+            _timings[id].duration = GetMSTimeDiff(stepStart, stepEnd);
+
+            for (StepId dependent : step.dependents)
+                if (!--_steps[dependent].pendingDependencies)
+                    ready.insert(dependent);
+
+            --remaining;
+            condition.notify_all();
+        }
+    };
+
+    threads = std::max(1u, std::min(threads, uint32(_steps.size())));
+    std::vector<std::thread> workers;
+    for (uint32 i = 1; i < threads; ++i)
+        workers.emplace_back(work);
+
+    work();
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    // A step depending on itself through others would never run
+    ASSERT(!remaining);
+
+    LogTimings(threads, GetMSTimeDiffToNow(startTime));
+}
+
+void ParallelLoader::LogTimings(uint32 threads, uint32 totalDuration) const
+{
+    uint32 stepsDuration = 0;
+    for (StepTiming const& timing : _timings)
+        stepsDuration += timing.duration;
+
+    TC_LOG_INFO("server.loading", ">> Ran %u loading steps in %u ms on %u threads (%u ms if run one after another)", uint32(_timings.size()), totalDuration, threads, stepsDuration);
+
+    std::vector<StepTiming const*> sorted;
+    for (StepTiming const& timing : _timings)
+        sorted.push_back(&timing);
+
+    std::sort(sorted.begin(), sorted.end(), [](StepTiming const* a, StepTiming const* b) { return a->duration > b->duration; });
+    for (StepTiming const* timing : sorted)
+        TC_LOG_DEBUG("server.loading", "   %-40s started at %6u ms, took %6u ms", timing->name.c_str(), timing->start, timing->duration);
+}
@@ -0,0 +1,49 @@
+#ifndef PARALLEL_LOADER_H
+#define PARALLEL_LOADER_H
+
+#include "Define.h"
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+/* Runs a set of loading steps, each one once all the steps it depends on are done.
+Independent steps run concurrently on up to 'threads' threads. With a single thread, steps run in the order they were added.
+Steps must only touch data not used by the steps they may run along. */
+class TC_COMMON_API ParallelLoader
+{
+public:
+    typedef uint32 StepId;
+    typedef std::function<void()> StepFunction;
+
+    struct StepTiming
+    {
+        std::string name;
+        uint32 start;    // ms since Run was called
+        uint32 duration; // ms
+    };
+
+    // Dependencies must have been added before
+    StepId Add(std::string name, StepFunction&& function, std::initializer_list<StepId> dependencies = {});
+
+    // Blocks until all steps are done, then logs their timings
+    void Run(uint32 threads);
+
+    std::vector<StepTiming> const& GetTimings() const { return _timings; }
+
+private:
+    struct Step
+    {
+        std::string name;
+        StepFunction function;
+        std::vector<StepId> dependents;
+        uint32 pendingDependencies = 0;
+    };
+
+    void LogTimings(uint32 threads, uint32 totalDuration) const;
+
+    std::vector<Step> _steps;
+    std::vector<StepTiming> _timings;
+};
+
+#endif // PARALLEL_LOADER_H
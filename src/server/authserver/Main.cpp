@@ -6,6 +6,7 @@
 * authentication server
 */
 
+#include "AuthCryptoPool.h"
 #include "AuthSocketMgr.h"
 #include "Banner.h"
 #include "Common.h"
@@ -16,6 +17,7 @@
 #include "ProcessPriority.h"
 #include "RealmList.h"
 #include "MySQLThreading.h"
+#include "OpenSSLCrypto.h"
 #include "GitRevision.h"
 #include "Util.h"
 #include <iostream>
@@ -149,6 +151,16 @@ int main(int argc, char** argv)
 
     std::string bindIp = sConfigMgr->GetStringDefault("BindIP", "0.0.0.0");
 
+    // Crypto threads and the network thread use OpenSSL at the same time
+    OpenSSLCrypto::threadsSetup();
+
+    std::shared_ptr<void> opensslHandle(nullptr, [](void*) { OpenSSLCrypto::threadsCleanup(); });
+
+    // Start the crypto threads before the network, they are stopped after it
+    sAuthCryptoPool.Start(sConfigMgr->GetIntDefault("CryptoPool.Threads", 2), sConfigMgr->GetIntDefault("CryptoPool.MaxQueued", 1000));
+
+    std::shared_ptr<void> sAuthCryptoPoolHandle(nullptr, [](void*) { sAuthCryptoPool.Stop(); });
+
     if (!sAuthSocketMgr.StartNetwork(*ioContext, bindIp, port))
     {
         TC_LOG_ERROR("server.authserver", "Failed to initialize network");
@@ -0,0 +1,86 @@
+#include "AuthCryptoPool.h"
+#include "Log.h"
+
+void AuthCryptoPool::Start(uint32 threadCount, uint32 maxQueued)
+{
+    _maxQueued = maxQueued;
+    _stopped = false;
+
+    for (uint32 i = 0; i < threadCount; ++i)
+        _threads.emplace_back(&AuthCryptoPool::WorkerThread, this);
+
+    TC_LOG_INFO("server.authserver", "Started %u crypto threads, %u queued logons max", threadCount, maxQueued);
+}
+
+void AuthCryptoPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _stopped = true;
+    }
+
+    _condition.notify_all();
+
+    for (std::thread& thread : _threads)
+        thread.join();
+
+    _threads.clear();
+
+    // Dropping the tasks breaks their promises, sessions waiting on them are being closed anyway
+    _tasks.clear();
+    _turns.clear();
+    _queued = 0;
+}
+
+std::future<void> AuthCryptoPool::Enqueue(std::string const& clientAddress, std::function<void()>&& task)
+{
+    std::packaged_task<void()> packagedTask(std::move(task));
+    std::future<void> future = packagedTask.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_stopped || _queued >= _maxQueued)
+            return std::future<void>();
+
+        std::deque<std::packaged_task<void()>>& tasks = _tasks[clientAddress];
+        if (tasks.empty())
+            _turns.push_back(clientAddress);
+
+        tasks.push_back(std::move(packagedTask));
+        ++_queued;
+    }
+
+    _condition.notify_one();
+    return future;
+}
+
+void AuthCryptoPool::WorkerThread()
+{
+    while (true)
+    {
+        std::packaged_task<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _condition.wait(lock, [this]() { return _stopped || !_turns.empty(); });
+            if (_stopped)
+                return;
+
+            // Take the oldest task of the next address, which goes back at the end of the turns if it has more
+            std::string address = std::move(_turns.front());
+            _turns.pop_front();
+
+            auto itr = _tasks.find(address);
+            task = std::move(itr->second.front());
+            itr->second.pop_front();
+            if (itr->second.empty())
+                _tasks.erase(itr);
+            else
+                _turns.push_back(std::move(address));
+
+            --_queued;
+        }
+
+        task();
+    }
+}
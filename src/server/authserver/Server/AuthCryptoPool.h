@@ -0,0 +1,56 @@
+#ifndef __AUTHCRYPTOPOOL_H__
+#define __AUTHCRYPTOPOOL_H__
+
+#include "Define.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/* Worker threads running the SRP6 computations of logons (ModExp on big numbers), so that the network thread keeps
+reading and writing sockets during login storms.
+Tasks are queued per client address and workers serve addresses in turn, a single address sending many logons
+only delays its own. The number of queued tasks is bounded, new ones are refused once it is reached. */
+class AuthCryptoPool
+{
+public:
+    static AuthCryptoPool& Instance()
+    {
+        static AuthCryptoPool instance;
+        return instance;
+    }
+
+    // threadCount 0 disables the pool, tasks are then run by the caller
+    void Start(uint32 threadCount, uint32 maxQueued);
+    void Stop();
+
+    bool IsEnabled() const { return !_threads.empty(); }
+
+    // Return an invalid future if the queue is full
+    std::future<void> Enqueue(std::string const& clientAddress, std::function<void()>&& task);
+
+private:
+    AuthCryptoPool() : _maxQueued(0), _queued(0), _stopped(false) { }
+    ~AuthCryptoPool() { Stop(); }
+
+    void WorkerThread();
+
+    std::vector<std::thread> _threads;
+
+    std::mutex _lock;
+    std::condition_variable _condition;
+    std::unordered_map<std::string, std::deque<std::packaged_task<void()>>> _tasks;
+    std::deque<std::string> _turns;         // addresses having queued tasks, in serving order
+    uint32 _maxQueued;
+    uint32 _queued;
+    bool _stopped;
+};
+
+#define sAuthCryptoPool AuthCryptoPool::Instance()
+
+#endif
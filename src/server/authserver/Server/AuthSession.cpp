@@ -1,4 +1,5 @@
 #include "AuthSession.h"
+#include "AuthCryptoPool.h"
 #include "Log.h"
 #include "AuthCodes.h"
 #include "Database/DatabaseEnv.h"
@@ -133,7 +134,7 @@ void AccountInfo::LoadResult(Field* fields)
 }
 
 AuthSession::AuthSession(tcp::socket&& socket) : Socket(std::move(socket)),
-_status(STATUS_CHALLENGE), _build(0), _expversion(0)
+_status(STATUS_CHALLENGE), _build(0), _expversion(0), _cryptoCallback(nullptr)
 {
     N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
     g.SetDword(7);
@@ -158,6 +159,31 @@ bool AuthSession::Update()
 
     _queryProcessor.ProcessReadyQueries();
 
+    if (_cryptoTask.valid() && _cryptoTask.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        _cryptoTask.get();
+        (this->*_cryptoCallback)();
+    }
+
+    return true;
+}
+
+bool AuthSession::RunCrypto(std::function<void()>&& task, void (AuthSession::*callback)())
+{
+    if (!sAuthCryptoPool.IsEnabled())
+    {
+        task();
+        (this->*callback)();
+        return true;
+    }
+
+    // The pool keeps the session alive until the task is done
+    std::shared_ptr<AuthSession> self = shared_from_this();
+    _cryptoTask = sAuthCryptoPool.Enqueue(GetRemoteIpAddress().to_string(), [self, task]() { task(); });
+    if (!_cryptoTask.valid())
+        return false;
+
+    _cryptoCallback = callback;
     return true;
 }
 
@@ -365,19 +391,41 @@ void AuthSession::LogonChallengeCallback(PreparedQueryResult result)
     TC_LOG_DEBUG("network", "database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
 
     // multiply with 2 since bytes are stored as hexstring
-    if (databaseV.size() != size_t(BufferSizes::SRP_6_V) * 2 || databaseS.size() != size_t(BufferSizes::SRP_6_S) * 2)
-        SetVSFields(rI);
-    else
+    bool const setVSFields = databaseV.size() != size_t(BufferSizes::SRP_6_V) * 2 || databaseS.size() != size_t(BufferSizes::SRP_6_S) * 2;
+    if (!setVSFields)
     {
         s.SetHexStr(databaseS.c_str());
         v.SetHexStr(databaseV.c_str());
     }
 
-    b.SetRand(19 * 8);
-    BigNumber gmod = g.ModExp(b, N);
-    B = ((v * 3) + gmod) % N;
+    // Check if token is used
+    _tokenKey = fields[9].GetString();
+
+    bool const started = RunCrypto([this, rI, setVSFields]()
+    {
+        if (setVSFields)
+            SetVSFields(rI);
+
+        b.SetRand(19 * 8);
+        BigNumber gmod = g.ModExp(b, N);
+        B = ((v * 3) + gmod) % N;
+
+        ASSERT(gmod.GetNumBytes() <= 32);
+    }, &AuthSession::LogonChallengeCryptoCallback);
+
+    if (!started)
+    {
+        TC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] crypto queue is full, account %s has to retry", ipAddress.c_str(), port, _accountInfo.Login.c_str());
+        pkt << uint8(WOW_FAIL_DB_BUSY);
+        SendPacket(pkt);
+    }
+}
 
-    ASSERT(gmod.GetNumBytes() <= 32);
+void AuthSession::LogonChallengeCryptoCallback()
+{
+    ByteBuffer pkt;
+    pkt << uint8(AUTH_LOGON_CHALLENGE);
+    pkt << uint8(0x00);
 
     BigNumber unk3;
     unk3.SetRand(16 * 8);
@@ -400,8 +448,6 @@ void AuthSession::LogonChallengeCallback(PreparedQueryResult result)
     pkt.append(unk3.AsByteArray(16).get(), 16);
     uint8 securityFlags = 0;
 
-    // Check if token is used
-    _tokenKey = fields[9].GetString();
     if (!_tokenKey.empty())
         securityFlags = 4;
 
@@ -426,7 +472,7 @@ void AuthSession::LogonChallengeCallback(PreparedQueryResult result)
         pkt << uint8(1);
 
     TC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] account %s is using '%s' locale (%u)",
-        ipAddress.c_str(), port, _accountInfo.Login.c_str(), _localizationName.c_str(), GetLocaleByName(_localizationName));
+        GetRemoteIpAddress().to_string().c_str(), GetRemotePort(), _accountInfo.Login.c_str(), _localizationName.c_str(), GetLocaleByName(_localizationName));
 
     SendPacket(pkt);
 }
@@ -449,14 +495,43 @@ bool AuthSession::HandleLogonProof()
     }
 
     // Continue the SRP6 calculation based on data received from the client
-    BigNumber A;
-
-    A.SetBinary(logonProof->A, 32);
+    _logonProof.A.SetBinary(logonProof->A, 32);
 
     // SRP safeguard: abort if A == 0
-    if ((A % N).IsZero())
+    if ((_logonProof.A % N).IsZero())
         return false;
 
+    memcpy(_logonProof.M1.data(), logonProof->M1, 20);
+
+    // Read the token now, the read buffer goes on while the proof is computed
+    _logonProof.hasToken = (logonProof->securityFlags & 0x04) || !_tokenKey.empty();
+    if (_logonProof.hasToken)
+    {
+        if (GetReadBuffer().GetActiveSize() < sizeof(sAuthLogonProof_C) + sizeof(uint8))
+            return false;
+
+        uint8 size = *(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C));
+        if (GetReadBuffer().GetActiveSize() < sizeof(sAuthLogonProof_C) + sizeof(size) + size)
+            return false;
+
+        _logonProof.token.assign(reinterpret_cast<char*>(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C) + sizeof(size)), size);
+        GetReadBuffer().ReadCompleted(sizeof(size) + size);
+    }
+
+    if (!RunCrypto(std::bind(&AuthSession::ComputeLogonProof, this), &AuthSession::LogonProofCryptoCallback))
+    {
+        TC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] crypto queue is full, closing connection of account %s", GetRemoteIpAddress().to_string().c_str(), GetRemotePort(), _accountInfo.Login.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+// Run by the crypto pool
+void AuthSession::ComputeLogonProof()
+{
+    BigNumber& A = _logonProof.A;
+
     SHA1Hash sha;
     sha.UpdateBigNumbers(&A, &B, NULL);
     sha.Finalize();
@@ -521,18 +596,29 @@ bool AuthSession::HandleLogonProof()
     BigNumber M;
     M.SetBinary(sha.GetDigest(), sha.GetLength());
 
+    // Check if SRP6 results match (password is correct)
+    _logonProof.isValid = !memcmp(M.AsByteArray(sha.GetLength()).get(), _logonProof.M1.data(), 20);
+    if (!_logonProof.isValid)
+        return;
+
+    // Finish SRP6, M2 is sent to the client
+    sha.Initialize();
+    sha.UpdateBigNumbers(&_logonProof.A, &M, &K, NULL);
+    sha.Finalize();
+    memcpy(_logonProof.M2.data(), sha.GetDigest(), 20);
+}
+
+void AuthSession::LogonProofCryptoCallback()
+{
     // Check if SRP6 results match (password is correct), else send an error
-    if (!memcmp(M.AsByteArray(sha.GetLength()).get(), logonProof->M1, 20))
+    if (_logonProof.isValid)
     {
         // Check auth token
-        if ((logonProof->securityFlags & 0x04) || !_tokenKey.empty())
+        if (_logonProof.hasToken)
         {
-            uint8 size = *(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C));
-            std::string token(reinterpret_cast<char*>(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C) + sizeof(size)), size);
-            GetReadBuffer().ReadCompleted(sizeof(size) + size);
             uint32 validToken = TOTP::GenerateToken(_tokenKey.c_str());
             _tokenKey.clear();
-            uint32 incomingToken = atoi(token.c_str());
+            uint32 incomingToken = atoi(_logonProof.token.c_str());
             if (validToken != incomingToken)
             {
                 ByteBuffer packet;
@@ -541,7 +627,7 @@ bool AuthSession::HandleLogonProof()
                 packet << uint8(3);
                 packet << uint8(0);
                 SendPacket(packet);
-                return true;
+                return;
             }
         }
 
@@ -559,16 +645,12 @@ bool AuthSession::HandleLogonProof()
         stmt->setString(5, _accountInfo.Login);
         LoginDatabase.DirectExecute(stmt);
 
-        // Finish SRP6 and send the final result to the client
-        sha.Initialize();
-        sha.UpdateBigNumbers(&A, &M, &K, NULL);
-        sha.Finalize();
-
+        // Send the final result of SRP6 to the client
         ByteBuffer packet;
         if (_expversion & POST_BC_EXP_FLAG)                 // 2.x and 3.x clients
         {
             sAuthLogonProof_S proof;
-            memcpy(proof.M2, sha.GetDigest(), 20);
+            memcpy(proof.M2, _logonProof.M2.data(), 20);
             proof.cmd = AUTH_LOGON_PROOF;
             proof.error = 0;
             proof.AccountFlags = 0x00800000;    // 0x01 = GM, 0x08 = Trial, 0x00800000 = Pro pass (arena tournament)
@@ -581,7 +663,7 @@ bool AuthSession::HandleLogonProof()
         else
         {
             sAuthLogonProof_S_Old proof;
-            memcpy(proof.M2, sha.GetDigest(), 20);
+            memcpy(proof.M2, _logonProof.M2.data(), 20);
             proof.cmd = AUTH_LOGON_PROOF;
             proof.error = 0;
             proof.unk2 = 0x00;
@@ -653,8 +735,6 @@ bool AuthSession::HandleLogonProof()
             }
         }
     }
-
-    return true;
 }
 
 bool AuthSession::HandleReconnectChallenge()
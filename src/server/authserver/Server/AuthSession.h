@@ -7,6 +7,9 @@
 #include "Socket.h"
 #include "BigNumber.h"
 #include "QueryCallbackProcessor.h"
+#include <array>
+#include <functional>
+#include <future>
 #include <memory>
 #include <boost/asio/ip/tcp.hpp>
 
@@ -67,16 +70,34 @@ private:
 
     void CheckIpCallback(PreparedQueryResult result);
     void LogonChallengeCallback(PreparedQueryResult result);
+    void LogonChallengeCryptoCallback();
+    void LogonProofCryptoCallback();
     void ReconnectChallengeCallback(PreparedQueryResult result);
     void RealmListCallback(PreparedQueryResult result);
 
     void SetVSFields(const std::string& rI);
+    void ComputeLogonProof();
+
+    /* Run task in the crypto pool then callback from Update, or both right away if the pool is disabled.
+    Return false if the pool queue is full, task is not run. */
+    bool RunCrypto(std::function<void()>&& task, void (AuthSession::*callback)());
 
     BigNumber N, s, g, v;
     BigNumber b, B;
     BigNumber K;
     BigNumber _reconnectProof;
 
+    // Logon proof data sent by the client and computed by the crypto pool
+    struct LogonProof
+    {
+        BigNumber A;
+        std::array<uint8, 20> M1;
+        std::array<uint8, 20> M2;
+        std::string token;
+        bool hasToken = false;
+        bool isValid = false;
+    } _logonProof;
+
     AuthStatus _status;
     AccountInfo _accountInfo;
     std::string _tokenKey;
@@ -87,6 +108,9 @@ private:
     uint8 _expversion;
 
     QueryCallbackProcessor _queryProcessor;
+    // Session members used by a pending crypto task must not be touched until it is ready
+    std::future<void> _cryptoTask;
+    void (AuthSession::*_cryptoCallback)();
 };
 
 #pragma pack(push, 1)
@@ -16,9 +16,11 @@
  */
 
 #include "AdhocStatement.h"
+#include "Common.h"
 #include "Errors.h"
 #include "MySQLConnection.h"
 #include "QueryResult.h"
+#include <cctype>
 #include <cstdlib>
 #include <cstring>
 
@@ -57,3 +59,20 @@ bool BasicStatementTask::Execute()
 
     return m_conn->Execute(m_sql);
 }
+
+bool BasicStatementTask::IsBatchable() const
+{
+    if (m_has_result)
+        return false;
+
+    // Only plain data changes, anything else (DDL, LOCK TABLES, ...) may implicitly commit
+    char const* sql = m_sql;
+    while (*sql && isspace(static_cast<unsigned char>(*sql)))
+        ++sql;
+
+    for (char const* keyword : { "INSERT", "REPLACE", "UPDATE", "DELETE" })
+        if (!strnicmp(sql, keyword, strlen(keyword)))
+            return true;
+
+    return false;
+}
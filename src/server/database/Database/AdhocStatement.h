@@ -30,6 +30,8 @@ class TC_DATABASE_API BasicStatementTask : public SQLOperation
         ~BasicStatementTask();
 
         bool Execute() override;
+        bool IsBatchable() const override;
+        std::string GetQueryString() const override { return m_sql; }
         QueryResultFuture GetFuture() const { return m_result->get_future(); }
 
     private:
@@ -16,11 +16,34 @@
  */
 
 #include "DatabaseWorker.h"
+#include "MySQLConnection.h"
 #include "SQLOperation.h"
 #include "ProducerConsumerQueue.h"
+#include <chrono>
+#include <mysqld_error.h>
 
-DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
+constexpr std::array<uint32, DatabaseBatchStats::BUCKET_COUNT> DatabaseBatchStats::SizeBounds;
+constexpr std::array<uint32, DatabaseBatchStats::BUCKET_COUNT> DatabaseBatchStats::LatencyBounds;
+
+static uint8 GetBucket(std::array<uint32, DatabaseBatchStats::BUCKET_COUNT> const& bounds, uint64 value)
+{
+    for (uint8 i = 0; i < DatabaseBatchStats::BUCKET_COUNT - 1; ++i)
+        if (value <= bounds[i])
+            return i;
+
+    return DatabaseBatchStats::BUCKET_COUNT - 1;
+}
+
+DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection) :
+    _batchCount(0), _batchedOperations(0), _batchFallbacks(0), _batchUncertain(0)
 {
+    for (uint8 i = 0; i < DatabaseBatchStats::BUCKET_COUNT; ++i)
+    {
+        _sizeHistogram[i] = 0;
+        _latencyHistogram[i] = 0;
+    }
+
+    _batch.reserve(MAX_BATCH_SIZE);
     _connection = connection;
     _queue = newQueue;
     _cancelationToken = false;
@@ -50,9 +73,127 @@ void DatabaseWorker::WorkerThread()
         if (_cancelationToken || !operation)
             return;
 
-        operation->SetConnection(_connection);
-        operation->call();
+        if (!operation->IsBatchable())
+        {
+            ExecuteOperation(operation);
+            continue;
+        }
+
+        // Grab the writes already waiting behind this one so that they share a single commit
+        _batch.push_back(operation);
+        SQLOperation* next = nullptr;
+        while (_batch.size() < MAX_BATCH_SIZE && _queue->Pop(next) && next)
+        {
+            if (!next->IsBatchable())
+                break;
+
+            _batch.push_back(next);
+            next = nullptr;
+        }
+
+        ExecuteBatch();
 
+        if (next)
+            ExecuteOperation(next);
+    }
+}
+
+void DatabaseWorker::ExecuteOperation(SQLOperation* operation)
+{
+    operation->SetConnection(_connection);
+    operation->call();
+
+    delete operation;
+}
+
+void DatabaseWorker::ExecuteBatch()
+{
+    auto start = std::chrono::steady_clock::now();
+    size_t const size = _batch.size();
+
+    if (size == 1)
+    {
+        _batch.front()->SetConnection(_connection);
+        _batch.front()->call();
+    }
+    else
+    {
+        uint32 const reconnectCount = _connection->GetReconnectCount();
+        auto connectionLost = [&]() { return _connection->GetReconnectCount() != reconnectCount; };
+
+        // A statement failing because the connection was lost must not be executed again by itself on the new connection,
+        // the rest of the transaction is lost with the old one
+        _connection->SetRetryAfterReconnect(false);
+
+        _connection->BeginTransaction();
+        bool replay = connectionLost();
+        for (size_t i = 0; i < size && !replay; ++i)
+        {
+            SQLOperation* operation = _batch[i];
+            operation->SetConnection(_connection);
+            bool const success = operation->Execute();
+
+            // Nothing of the transaction has been written
+            if (connectionLost())
+                replay = true;
+            // The server has rolled back the whole transaction
+            else if (!success && _connection->GetLastError() == ER_LOCK_DEADLOCK)
+            {
+                _connection->RollbackTransaction();
+                replay = true;
+            }
+
+            // Any other error only affects the failed statement, as it would without batching
+        }
+
+        if (!replay)
+        {
+            _connection->CommitTransaction();
+
+            // The server may have committed before the connection was lost, executing them again could write them twice
+            if (connectionLost())
+            {
+                ++_batchUncertain;
+                TC_LOG_ERROR("sql.sql", "Connection lost while committing a batch of %u statements, they may not have been written:", uint32(size));
+                for (SQLOperation* operation : _batch)
+                    TC_LOG_ERROR("sql.sql", "    %s", operation->GetQueryString().c_str());
+            }
+        }
+
+        _connection->SetRetryAfterReconnect(true);
+
+        if (replay)
+        {
+            ++_batchFallbacks;
+
+            // Execute them one at a time in their order, as if they had never been batched
+            for (SQLOperation* operation : _batch)
+                operation->Execute();
+        }
+    }
+
+    uint64 const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    ++_sizeHistogram[GetBucket(DatabaseBatchStats::SizeBounds, size)];
+    ++_latencyHistogram[GetBucket(DatabaseBatchStats::LatencyBounds, elapsed)];
+    ++_batchCount;
+    _batchedOperations += size;
+
+    for (SQLOperation* operation : _batch)
         delete operation;
+
+    _batch.clear();
+}
+
+void DatabaseWorker::AddBatchStats(DatabaseBatchStats& stats) const
+{
+    for (uint8 i = 0; i < DatabaseBatchStats::BUCKET_COUNT; ++i)
+    {
+        stats.Sizes[i] += _sizeHistogram[i];
+        stats.Latencies[i] += _latencyHistogram[i];
     }
+
+    stats.Batches += _batchCount;
+    stats.Operations += _batchedOperations;
+    stats.Fallbacks += _batchFallbacks;
+    stats.Uncertain += _batchUncertain;
 }
@@ -19,8 +19,10 @@
 #define _WORKERTHREAD_H
 
 #include "Define.h"
+#include <array>
 #include <atomic>
 #include <thread>
+#include <vector>
 
 template <typename T>
 class ProducerConsumerQueue;
@@ -28,21 +30,55 @@ class ProducerConsumerQueue;
 class MySQLConnection;
 class SQLOperation;
 
+//- Batch size and latency histograms of the async workers of a pool
+struct TC_DATABASE_API DatabaseBatchStats
+{
+    static constexpr uint8 BUCKET_COUNT = 8;
+    //- Inclusive upper bound of each bucket, last bucket has no upper bound
+    static constexpr std::array<uint32, BUCKET_COUNT> SizeBounds = { { 1, 2, 4, 8, 16, 32, 64, 0 } };
+    static constexpr std::array<uint32, BUCKET_COUNT> LatencyBounds = { { 500, 1000, 2000, 5000, 10000, 25000, 100000, 0 } }; // microseconds
+
+    std::array<uint64, BUCKET_COUNT> Sizes = { };
+    std::array<uint64, BUCKET_COUNT> Latencies = { };
+    uint64 Batches = 0;
+    uint64 Operations = 0;
+    uint64 Fallbacks = 0; // Batches re-executed one operation at a time after a deadlock or a lost connection
+    uint64 Uncertain = 0; // Batches being committed when the connection was lost, not executed again
+};
+
 class TC_DATABASE_API DatabaseWorker
 {
     public:
         DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection);
         ~DatabaseWorker();
 
+        //- Max operations executed in a single transaction
+        static constexpr uint32 MAX_BATCH_SIZE = 64;
+
+        //- Add this worker histograms to given stats
+        void AddBatchStats(DatabaseBatchStats& stats) const;
+
     private:
         ProducerConsumerQueue<SQLOperation*>* _queue;
         MySQLConnection* _connection;
 
         void WorkerThread();
+        void ExecuteOperation(SQLOperation* operation);
+        void ExecuteBatch();
         std::thread _workerThread;
 
         std::atomic<bool> _cancelationToken;
 
+        //- Consecutive batchable operations popped from the queue, only used by worker thread
+        std::vector<SQLOperation*> _batch;
+
+        std::array<std::atomic<uint64>, DatabaseBatchStats::BUCKET_COUNT> _sizeHistogram;
+        std::array<std::atomic<uint64>, DatabaseBatchStats::BUCKET_COUNT> _latencyHistogram;
+        std::atomic<uint64> _batchCount;
+        std::atomic<uint64> _batchedOperations;
+        std::atomic<uint64> _batchFallbacks;
+        std::atomic<uint64> _batchUncertain;
+
         DatabaseWorker(DatabaseWorker const& right) = delete;
         DatabaseWorker& operator=(DatabaseWorker const& right) = delete;
 };
@@ -18,6 +18,7 @@
 #include "DatabaseWorkerPool.h"
 #include "AdhocStatement.h"
 #include "Common.h"
+#include "DatabaseWorker.h"
 #include "Errors.h"
 #include "Implementation/LoginDatabase.h"
 #include "Implementation/WorldDatabase.h"
@@ -334,6 +335,26 @@ void DatabaseWorkerPool<T>::KeepAlive()
         Enqueue(new PingOperation);
 }
 
+template <class T>
+DatabaseBatchStats DatabaseWorkerPool<T>::GetBatchStats() const
+{
+    DatabaseBatchStats stats;
+    for (auto const& connection : _connections[IDX_ASYNC])
+        connection->m_worker->AddBatchStats(stats);
+
+    return stats;
+}
+
+template <class T>
+std::unique_ptr<T> DatabaseWorkerPool<T>::OpenDedicatedConnection()
+{
+    auto connection = Trinity::make_unique<T>(*_connectionInfo);
+    if (connection->Open() || !connection->PrepareStatements())
+        return nullptr;
+
+    return connection;
+}
+
 template <class T>
 uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConnections)
 {
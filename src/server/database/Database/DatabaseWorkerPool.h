@@ -30,6 +30,7 @@ template <typename T>
 class ProducerConsumerQueue;
 
 class SQLOperation;
+struct DatabaseBatchStats;
 struct MySQLConnectionInfo;
 
 template <class T>
@@ -211,6 +212,13 @@ class DatabaseWorkerPool
         //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
         void KeepAlive();
 
+        //! Batch size and latency histograms of the asynchronous connections.
+        DatabaseBatchStats GetBatchStats() const;
+
+        //! Opens a synchronous connection outside of the pool, for a thread which needs its own (long transactions...).
+        //! Returns nullptr if the connection could not be opened.
+        std::unique_ptr<T> OpenDedicatedConnection();
+
     private:
         uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
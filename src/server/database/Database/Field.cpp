@@ -352,4 +352,14 @@ void Field::SetMetadata(MYSQL_FIELD* field, uint32 fieldIndex)
     meta.Type = FieldTypeToString(field->type);
     meta.Index = fieldIndex;
 }
+
+void Field::SetMetadata(char const* table, char const* name, uint32 mysqlType, uint32 fieldIndex)
+{
+    meta.TableName = table;
+    meta.TableAlias = table;
+    meta.Name = name;
+    meta.Alias = name;
+    meta.Type = FieldTypeToString(enum_field_types(mysqlType));
+    meta.Index = fieldIndex;
+}
 #endif
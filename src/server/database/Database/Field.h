@@ -70,6 +70,7 @@ class TC_DATABASE_API Field
 {
     friend class ResultSet;
     friend class PreparedResultSet;
+    friend class ResultSnapshot;
 
     public:
         Field();
@@ -138,6 +139,7 @@ class TC_DATABASE_API Field
     private:
         #ifdef TRINITY_DEBUG
         void SetMetadata(MYSQL_FIELD* field, uint32 fieldIndex);
+        void SetMetadata(char const* table, char const* name, uint32 mysqlType, uint32 fieldIndex);
         Metadata meta;
         #endif
 };
@@ -563,8 +563,11 @@ void CharacterDatabaseConnection::DoPrepareStatements()
     */
     PrepareStatement(CHAR_DEL_CHAR_SPELL_COOLDOWNS, "DELETE FROM character_spell_cooldown WHERE guid = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_INS_CHAR_SPELL_COOLDOWN, "INSERT INTO character_spell_cooldown (guid, spell, item, time, categoryId, categoryEnd) VALUES (?, ?, ?, ?, ?, ?)", CONNECTION_ASYNC);
-    PrepareStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN, "DELETE FROM character_spell_cooldown WHERE guid = ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN, "DELETE FROM character_spell_cooldown WHERE guid = ? AND spell = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_DEL_CHAR_AURA, "DELETE FROM character_aura WHERE guid = ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_CHAR_AURA_BY_SPELL, "DELETE FROM character_aura WHERE guid = ? AND casterGuid = ? AND spell = ? AND effectMask = ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_UPD_CHAR_AURA, "UPDATE character_aura SET recalculateMask = ?, stackCount = ?, amount0 = ?, amount1 = ?, amount2 = ?, base_amount0 = ?, base_amount1 = ?, base_amount2 = ?, "
+        "maxDuration = ?, remainTime = ?, remainCharges = ?, critChance = ?, applyResilience = ? WHERE guid = ? AND casterGuid = ? AND spell = ? AND effectMask = ?", CONNECTION_ASYNC);
     /*
     PrepareStatement(CHAR_DEL_CHAR_GIFT, "DELETE FROM character_gifts WHERE guid = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_DEL_CHAR_INSTANCE, "DELETE FROM character_instance WHERE guid = ?", CONNECTION_ASYNC);
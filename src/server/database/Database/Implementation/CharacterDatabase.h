@@ -484,6 +484,8 @@ enum CharacterDatabaseStatements : uint32
     CHAR_DEL_CHAR_SPELL_COOLDOWN,
     CHAR_INS_CHAR_SPELL_COOLDOWN,
     CHAR_DEL_CHAR_AURA,
+    CHAR_DEL_CHAR_AURA_BY_SPELL,
+    CHAR_UPD_CHAR_AURA,
     /*
     CHAR_DEL_CHAR_GIFT,
     CHAR_DEL_CHAR_INSTANCE,
@@ -50,6 +50,8 @@ MySQLConnectionInfo::MySQLConnectionInfo(std::string const& infoString)
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_reconnectCount(0),
+m_retryAfterReconnect(true),
 m_queue(nullptr),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
@@ -58,6 +60,8 @@ m_connectionFlags(CONNECTION_SYNCH) { }
 MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_reconnectCount(0),
+m_retryAfterReconnect(true),
 m_queue(queue),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
@@ -181,7 +185,7 @@ bool MySQLConnection::Execute(char const* sql)
             TC_LOG_INFO("sql.sql", "SQL: %s", sql);
             TC_LOG_ERROR("sql.sql", "[%u] %s", lErrno, mysql_error(m_Mysql));
 
-            if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            if (_HandleMySQLErrno(lErrno) && m_retryAfterReconnect)  // If it returns true, an error was handled successfully (i.e. reconnection)
                 return Execute(sql);       // Try again
 
             return false;
@@ -217,7 +221,12 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
         TC_LOG_ERROR("sql.sql", "SQL(p): %s\n [ERROR]: [%u] %s", m_mStmt->getQueryString().c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
         if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
-            return Execute(stmt);       // Try again
+        {
+            if (m_retryAfterReconnect)
+                return Execute(stmt);       // Try again
+
+            return false; // m_mStmt was freed when statements were prepared again
+        }
 
         m_mStmt->ClearParameters();
         return false;
@@ -229,7 +238,12 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
         TC_LOG_ERROR("sql.sql", "SQL(p): %s\n [ERROR]: [%u] %s", m_mStmt->getQueryString().c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
         if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
-            return Execute(stmt);       // Try again
+        {
+            if (m_retryAfterReconnect)
+                return Execute(stmt);       // Try again
+
+            return false; // m_mStmt was freed when statements were prepared again
+        }
 
         m_mStmt->ClearParameters();
         return false;
@@ -265,7 +279,12 @@ bool MySQLConnection::_Query(PreparedStatement* stmt, MYSQL_RES **pResult, uint6
         TC_LOG_ERROR("sql.sql", "SQL(p): %s\n [ERROR]: [%u] %s", m_mStmt->getQueryString().c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
         if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
-            return _Query(stmt, pResult, pRowCount, pFieldCount);       // Try again
+        {
+            if (m_retryAfterReconnect)
+                return _Query(stmt, pResult, pRowCount, pFieldCount);       // Try again
+
+            return false; // m_mStmt was freed when statements were prepared again
+        }
 
         m_mStmt->ClearParameters();
         return false;
@@ -278,7 +297,12 @@ bool MySQLConnection::_Query(PreparedStatement* stmt, MYSQL_RES **pResult, uint6
             m_mStmt->getQueryString().c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
         if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
-            return _Query(stmt, pResult, pRowCount, pFieldCount);      // Try again
+        {
+            if (m_retryAfterReconnect)
+                return _Query(stmt, pResult, pRowCount, pFieldCount);      // Try again
+
+            return false; // m_mStmt was freed when statements were prepared again
+        }
 
         m_mStmt->ClearParameters();
         return false;
@@ -325,7 +349,7 @@ bool MySQLConnection::_Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD *
             TC_LOG_INFO("sql.sql", "SQL: %s", sql);
             TC_LOG_ERROR("sql.sql", "[%u] %s", lErrno, mysql_error(m_Mysql));
 
-            if (_HandleMySQLErrno(lErrno))      // If it returns true, an error was handled successfully (i.e. reconnection)
+            if (_HandleMySQLErrno(lErrno) && m_retryAfterReconnect)      // If it returns true, an error was handled successfully (i.e. reconnection)
                 return _Query(sql, pResult, pFields, pRowCount, pFieldCount);    // We try again
 
             return false;
@@ -423,6 +447,16 @@ void MySQLConnection::Ping()
     mysql_ping(m_Mysql);
 }
 
+std::string MySQLConnection::GetQueryString(PreparedStatement* stmt)
+{
+    MySQLPreparedStatement* mStmt = GetPreparedStatement(stmt->m_index);
+    if (!mStmt)
+        return "";
+
+    mStmt->m_stmt = stmt;
+    return mStmt->getQueryString();
+}
+
 uint32 MySQLConnection::GetLastError()
 {
     return mysql_errno(m_Mysql);
@@ -538,6 +572,7 @@ bool MySQLConnection::_HandleMySQLErrno(uint32 errNo, uint8 attempts /*= 5*/)
                         (m_connectionFlags & CONNECTION_ASYNC) ? "asynchronous" : "synchronous");
 
                 m_reconnecting = false;
+                ++m_reconnectCount;
                 return true;
             }
 
@@ -82,6 +82,13 @@ class TC_DATABASE_API MySQLConnection
         void Ping();
 
         uint32 GetLastError();
+        /// Number of times this connection was re-opened after being lost. Anything not yet committed at that time was lost as well
+        uint32 GetReconnectCount() const { return m_reconnectCount; }
+        /// Whether a statement is executed again after the connection was lost and re-opened (default). Must be disabled inside a transaction
+        /// which is handled by the caller, the statement would otherwise be executed alone while the rest of the transaction is lost
+        void SetRetryAfterReconnect(bool retry) { m_retryAfterReconnect = retry; }
+        /// Query of stmt with its parameters, for logging
+        std::string GetQueryString(PreparedStatement* stmt);
 
     protected:
         /// Tries to acquire lock. If lock is acquired by another thread
@@ -103,6 +110,8 @@ class TC_DATABASE_API MySQLConnection
         PreparedStatementContainer           m_stmts;         //! PreparedStatements storage
         bool                                 m_reconnecting;  //! Are we reconnecting?
         bool                                 m_prepareError;  //! Was there any error while preparing statements?
+        uint32                               m_reconnectCount; //! Successful reconnections count
+        bool                                 m_retryAfterReconnect; //! Execute a statement again after reconnecting
 
     private:
         bool _HandleMySQLErrno(uint32 errNo, uint8 attempts = 5);
@@ -457,6 +457,11 @@ PreparedStatementTask::~PreparedStatementTask()
         delete m_result;
 }
 
+std::string PreparedStatementTask::GetQueryString() const
+{
+    return m_conn ? m_conn->GetQueryString(m_stmt) : "";
+}
+
 bool PreparedStatementTask::Execute()
 {
     if (m_has_result)
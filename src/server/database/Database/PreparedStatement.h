@@ -167,6 +167,8 @@ class TC_DATABASE_API PreparedStatementTask : public SQLOperation
         ~PreparedStatementTask();
 
         bool Execute() override;
+        bool IsBatchable() const override { return !m_has_result; }
+        std::string GetQueryString() const override;
         PreparedQueryResultFuture GetFuture() { return m_result->get_future(); }
 
     protected:
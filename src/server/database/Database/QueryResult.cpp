@@ -20,6 +20,8 @@
 #include "Errors.h"
 #include "Field.h"
 #include "Log.h"
+#include "ResultSnapshot.h"
+#include <cstring>
 #ifdef _WIN32 // hack for broken mysql.h not including the correct winsock header for SOCKET definition, fixed in 5.7
 #include <winsock2.h>
 #endif
@@ -123,7 +125,8 @@ ResultSet::ResultSet(MYSQL_RES *result, MYSQL_FIELD *fields, uint64 rowCount, ui
 _rowCount(rowCount),
 _fieldCount(fieldCount),
 _result(result),
-_fields(fields)
+_fields(fields),
+_snapshotRow(nullptr)
 {
     _currentRow = new Field[_fieldCount];
 #ifdef TRINITY_DEBUG
@@ -132,6 +135,24 @@ _fields(fields)
 #endif
 }
 
+ResultSet::ResultSet(std::shared_ptr<ResultSnapshot const> snapshot) :
+_rowCount(snapshot->GetRowCount()),
+_fieldCount(uint32(snapshot->GetColumns().size())),
+_result(nullptr),
+_fields(nullptr),
+_snapshot(std::move(snapshot)),
+_snapshotRow(_snapshot->GetRows())
+{
+    _currentRow = new Field[_fieldCount];
+#ifdef TRINITY_DEBUG
+    for (uint32 i = 0; i < _fieldCount; i++)
+    {
+        ResultSnapshot::Column const& column = _snapshot->GetColumns()[i];
+        _currentRow[i].SetMetadata(column.Table.c_str(), column.Name.c_str(), column.MysqlType, i);
+    }
+#endif
+}
+
 PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES *result, uint64 rowCount, uint32 fieldCount) :
 m_rowCount(rowCount),
 m_rowPosition(0),
@@ -279,6 +300,9 @@ bool ResultSet::NextRow()
 {
     MYSQL_ROW row;
 
+    if (_snapshot)
+        return NextSnapshotRow();
+
     if (!_result)
         return false;
 
@@ -303,6 +327,34 @@ bool ResultSet::NextRow()
     return true;
 }
 
+bool ResultSet::NextSnapshotRow()
+{
+    // Bounds were checked when the snapshot was loaded
+    if (_snapshotRow == _snapshot->GetRows() + _snapshot->GetRowsSize())
+    {
+        CleanUp();
+        return false;
+    }
+
+    std::vector<ResultSnapshot::Column> const& columns = _snapshot->GetColumns();
+    for (uint32 i = 0; i < _fieldCount; i++)
+    {
+        uint32 length;
+        memcpy(&length, _snapshotRow, sizeof(length));
+        _snapshotRow += sizeof(length);
+
+        if (length == ResultSnapshot::NULL_LENGTH)
+            _currentRow[i].SetStructuredValue(nullptr, columns[i].Type, 0);
+        else
+        {
+            _currentRow[i].SetStructuredValue(const_cast<char*>(_snapshotRow), columns[i].Type, length);
+            _snapshotRow += length;
+        }
+    }
+
+    return true;
+}
+
 bool PreparedResultSet::NextRow()
 {
     /// Only updates the m_rowPosition so upper level code knows in which element
@@ -337,6 +389,9 @@ void ResultSet::CleanUp()
         mysql_free_result(_result);
         _result = nullptr;
     }
+
+    _snapshot.reset();
+    _snapshotRow = nullptr;
 }
 
 Field const& ResultSet::operator[](std::size_t index) const
@@ -21,12 +21,17 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <memory>
 #include <vector>
 
+class ResultSnapshot;
+
 class TC_DATABASE_API ResultSet
 {
     public:
         ResultSet(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount);
+        // Reads the rows of a snapshot instead of a MySQL result
+        ResultSet(std::shared_ptr<ResultSnapshot const> snapshot);
         ~ResultSet();
 
         bool NextRow();
@@ -42,9 +47,14 @@ class TC_DATABASE_API ResultSet
         uint32 _fieldCount;
 
     private:
+        friend class ResultSnapshot;
+
         void CleanUp();
+        bool NextSnapshotRow();
         MYSQL_RES* _result;
         MYSQL_FIELD* _fields;
+        std::shared_ptr<ResultSnapshot const> _snapshot;
+        char const* _snapshotRow;
 
         ResultSet(ResultSet const& right) = delete;
         ResultSet& operator=(ResultSet const& right) = delete;
@@ -0,0 +1,102 @@
+#include "QuerySnapshotCache.h"
+#include "Field.h"
+#include "Log.h"
+#include "QueryResult.h"
+#include "ResultSnapshot.h"
+#include "StringFormat.h"
+#include "Timer.h"
+#include <boost/filesystem/operations.hpp>
+
+QuerySnapshotCache* QuerySnapshotCache::instance()
+{
+    static QuerySnapshotCache instance;
+    return &instance;
+}
+
+void QuerySnapshotCache::Initialize(std::string const& directory, std::string const& revision)
+{
+    _directory = directory;
+    _revision = revision;
+    if (_directory.empty())
+        return;
+
+    if (_directory.back() != '/' && _directory.back() != '\\')
+        _directory.push_back('/');
+
+    boost::system::error_code error;
+    boost::filesystem::create_directories(_directory, error);
+    if (error)
+    {
+        TC_LOG_ERROR("server.loading", "Could not create query snapshot directory '%s' (%s), snapshots are disabled.", _directory.c_str(), error.message().c_str());
+        _directory.clear();
+        return;
+    }
+
+    TC_LOG_INFO("server.loading", "Using query snapshots in '%s'", _directory.c_str());
+}
+
+std::string QuerySnapshotCache::GetFileName(char const* sql) const
+{
+    // FNV-1a, std::hash is not guaranteed to give the same value across builds
+    uint64 hash = 14695981039346656037ULL;
+    for (char const* c = sql; *c; ++c)
+        hash = (hash ^ uint8(*c)) * 1099511628211ULL;
+
+    return Trinity::StringFormat("%s%016llx.snapshot", _directory.c_str(), (unsigned long long)hash);
+}
+
+QueryResult QuerySnapshotCache::Query(char const* sql, std::initializer_list<char const*> tables, QueryFunction const& query)
+{
+    uint32 const oldMSTime = GetMSTime();
+
+    // Checksums are computed by the server without sending the rows, NULL means the table does not exist
+    std::string checksumQuery = "CHECKSUM TABLE ";
+    for (char const* table : tables)
+    {
+        if (table != *tables.begin())
+            checksumQuery += ", ";
+        checksumQuery += Trinity::StringFormat("`%s`", table);
+    }
+
+    QueryResult checksums = query(checksumQuery.c_str());
+    if (!checksums)
+        return query(sql);
+
+    // The query is part of the key, a hash collision on the file name only makes it stale
+    std::string key = _revision + '\n' + sql;
+    do
+    {
+        Field* fields = checksums->Fetch();
+        if (fields[1].IsNull())
+        {
+            TC_LOG_ERROR("sql.sql", "QuerySnapshotCache: table %s does not exist, not using snapshots for query: %s", fields[0].GetCString(), sql);
+            return query(sql);
+        }
+
+        key += Trinity::StringFormat("\n%s=" UI64FMTD, fields[0].GetCString(), fields[1].GetUInt64());
+    } while (checksums->NextRow());
+
+    std::string const fileName = GetFileName(sql);
+    if (std::shared_ptr<ResultSnapshot const> snapshot = ResultSnapshot::Load(fileName, key))
+    {
+        // Empty results are not saved
+        QueryResult result = std::make_shared<ResultSet>(std::move(snapshot));
+        result->NextRow();
+
+        TC_LOG_DEBUG("sql.sql", "QuerySnapshotCache: read " UI64FMTD " rows from %s in %u ms", result->GetRowCount(), fileName.c_str(), GetMSTimeDiffToNow(oldMSTime));
+        return result;
+    }
+
+    QueryResult result = query(sql);
+    if (!result)
+        return result;
+
+    // The MySQL result can only be read once, continue with a result reading the snapshot that was just made
+    std::shared_ptr<ResultSnapshot const> snapshot = ResultSnapshot::Create(*result);
+    if (snapshot->Save(fileName, key))
+        TC_LOG_DEBUG("sql.sql", "QuerySnapshotCache: saved " UI64FMTD " rows to %s", snapshot->GetRowCount(), fileName.c_str());
+
+    result = std::make_shared<ResultSet>(std::move(snapshot));
+    result->NextRow();
+    return result;
+}
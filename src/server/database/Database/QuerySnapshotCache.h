@@ -0,0 +1,44 @@
+#ifndef QUERYSNAPSHOTCACHE_H
+#define QUERYSNAPSHOTCACHE_H
+
+#include "Define.h"
+#include "DatabaseWorkerPool.h"
+#include <functional>
+#include <initializer_list>
+#include <string>
+
+/* Keeps the results of big static data queries on disk, so that the next boots can map them instead of having the server
+run and send them again. A snapshot is keyed by the query, the given revision and the checksums of the tables it reads,
+any change in those tables makes it stale and the query is run again (and its snapshot rewritten). */
+class TC_DATABASE_API QuerySnapshotCache
+{
+    public:
+        static QuerySnapshotCache* instance();
+
+        // Empty directory disables the cache, queries are then always run
+        void Initialize(std::string const& directory, std::string const& revision);
+        bool IsEnabled() const { return !_directory.empty(); }
+
+        // Same as database.Query(sql). 'tables' must list every table the query reads from.
+        template<class T>
+        QueryResult Query(DatabaseWorkerPool<T>& database, char const* sql, std::initializer_list<char const*> tables)
+        {
+            if (!IsEnabled())
+                return database.Query(sql);
+
+            return Query(sql, tables, [&database](char const* query) { return database.Query(query); });
+        }
+
+    private:
+        typedef std::function<QueryResult(char const*)> QueryFunction;
+
+        QueryResult Query(char const* sql, std::initializer_list<char const*> tables, QueryFunction const& query);
+        std::string GetFileName(char const* sql) const;
+
+        std::string _directory;
+        std::string _revision;
+};
+
+#define sQuerySnapshotCache QuerySnapshotCache::instance()
+
+#endif
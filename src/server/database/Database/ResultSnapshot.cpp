@@ -0,0 +1,248 @@
+#include "ResultSnapshot.h"
+#include "Errors.h"
+#include "Field.h"
+#include "Log.h"
+#include "QueryResult.h"
+#ifdef _WIN32 // hack for broken mysql.h not including the correct winsock header for SOCKET definition, fixed in 5.7
+#include <winsock2.h>
+#endif
+#include <mysql.h>
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    char const SNAPSHOT_MAGIC[4] = { 'R', 'S', 'N', 'P' };
+    uint32 const SNAPSHOT_VERSION = 1; // increase when the file format changes
+
+    void Append(std::vector<char>& buffer, void const* data, std::size_t size)
+    {
+        char const* bytes = reinterpret_cast<char const*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    void AppendString(std::vector<char>& buffer, std::string const& str)
+    {
+        uint32 const length = uint32(str.length());
+        Append(buffer, &length, sizeof(length));
+        Append(buffer, str.data(), length);
+    }
+
+    // Bound checked reads from a mapped snapshot file
+    class SnapshotReader
+    {
+        public:
+            SnapshotReader(char const* data, std::size_t size) : _data(data), _size(size), _pos(0) { }
+
+            bool Read(void* value, std::size_t size)
+            {
+                if (_size - _pos < size)
+                    return false;
+
+                memcpy(value, _data + _pos, size);
+                _pos += size;
+                return true;
+            }
+
+            bool ReadString(std::string& str)
+            {
+                uint32 length;
+                if (!Read(&length, sizeof(length)) || _size - _pos < length)
+                    return false;
+
+                str.assign(_data + _pos, length);
+                _pos += length;
+                return true;
+            }
+
+            bool Skip(std::size_t size)
+            {
+                if (_size - _pos < size)
+                    return false;
+
+                _pos += size;
+                return true;
+            }
+
+            char const* GetPosition() const { return _data + _pos; }
+            std::size_t GetRemaining() const { return _size - _pos; }
+
+        private:
+            char const* _data;
+            std::size_t _size;
+            std::size_t _pos;
+    };
+}
+
+ResultSnapshot::ResultSnapshot() : _rowCount(0), _rows(nullptr), _rowsSize(0)
+{
+}
+
+ResultSnapshot::~ResultSnapshot() = default;
+
+std::shared_ptr<ResultSnapshot> ResultSnapshot::Create(ResultSet& result)
+{
+    std::shared_ptr<ResultSnapshot> snapshot = std::make_shared<ResultSnapshot>();
+
+    uint32 const fieldCount = result.GetFieldCount();
+    if (result._snapshot)
+        snapshot->_columns = result._snapshot->_columns;
+    else
+    {
+        ASSERT(result._fields && result._currentRow);
+        snapshot->_columns.reserve(fieldCount);
+        for (uint32 i = 0; i < fieldCount; ++i)
+        {
+            MYSQL_FIELD const& field = result._fields[i];
+            snapshot->_columns.push_back({ field.org_table, field.org_name, uint32(field.type), result._currentRow[i].data.type });
+        }
+    }
+
+    do
+    {
+        Field const* fields = result.Fetch();
+        for (uint32 i = 0; i < fieldCount; ++i)
+        {
+            if (fields[i].IsNull())
+            {
+                Append(snapshot->_buffer, &NULL_LENGTH, sizeof(NULL_LENGTH));
+                continue;
+            }
+
+            uint32 const length = fields[i].data.length;
+            Append(snapshot->_buffer, &length, sizeof(length));
+            Append(snapshot->_buffer, fields[i].data.value, length);
+        }
+
+        ++snapshot->_rowCount;
+    } while (result.NextRow());
+
+    snapshot->_rows = snapshot->_buffer.data();
+    snapshot->_rowsSize = snapshot->_buffer.size();
+    return snapshot;
+}
+
+std::shared_ptr<ResultSnapshot> ResultSnapshot::Load(std::string const& fileName, std::string const& key)
+{
+    if (!boost::filesystem::exists(fileName))
+        return nullptr;
+
+    std::shared_ptr<ResultSnapshot> snapshot = std::make_shared<ResultSnapshot>();
+    try
+    {
+        snapshot->_mappedFile = std::make_unique<boost::iostreams::mapped_file_source>(fileName);
+    }
+    catch (std::exception const& e)
+    {
+        TC_LOG_ERROR("sql.sql", "ResultSnapshot: could not map file '%s' (%s)", fileName.c_str(), e.what());
+        return nullptr;
+    }
+
+    SnapshotReader reader(snapshot->_mappedFile->data(), snapshot->_mappedFile->size());
+
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    uint32 version;
+    std::string fileKey;
+    if (!reader.Read(magic, sizeof(magic)) || memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0
+        || !reader.Read(&version, sizeof(version)) || version != SNAPSHOT_VERSION
+        || !reader.ReadString(fileKey))
+    {
+        TC_LOG_ERROR("sql.sql", "ResultSnapshot: file '%s' is not a valid snapshot or was written by another version", fileName.c_str());
+        return nullptr;
+    }
+
+    // Not an error, data changed since the snapshot was saved
+    if (fileKey != key)
+        return nullptr;
+
+    uint32 columnCount;
+    uint64 rowsSize;
+    bool valid = reader.Read(&columnCount, sizeof(columnCount));
+    for (uint32 i = 0; valid && i < columnCount; ++i)
+    {
+        Column column;
+        uint8 type;
+        valid = reader.ReadString(column.Table) && reader.ReadString(column.Name)
+            && reader.Read(&column.MysqlType, sizeof(column.MysqlType)) && reader.Read(&type, sizeof(type));
+        column.Type = DatabaseFieldTypes(type);
+        snapshot->_columns.push_back(std::move(column));
+    }
+
+    valid = valid && reader.Read(&snapshot->_rowCount, sizeof(snapshot->_rowCount))
+        && reader.Read(&rowsSize, sizeof(rowsSize)) && rowsSize == reader.GetRemaining();
+
+    if (valid)
+    {
+        snapshot->_rows = reader.GetPosition();
+        snapshot->_rowsSize = std::size_t(rowsSize);
+
+        // Check every field once here rather than bound checking each read in ResultSet::NextRow
+        SnapshotReader rows(snapshot->_rows, snapshot->_rowsSize);
+        for (uint64 row = 0; valid && row < snapshot->_rowCount; ++row)
+        {
+            for (uint32 i = 0; valid && i < columnCount; ++i)
+            {
+                uint32 length;
+                valid = rows.Read(&length, sizeof(length)) && (length == NULL_LENGTH || rows.Skip(length));
+            }
+        }
+
+        valid = valid && !rows.GetRemaining();
+    }
+
+    if (!valid)
+    {
+        TC_LOG_ERROR("sql.sql", "ResultSnapshot: file '%s' is truncated or corrupted", fileName.c_str());
+        return nullptr;
+    }
+
+    return snapshot;
+}
+
+bool ResultSnapshot::Save(std::string const& fileName, std::string const& key) const
+{
+    std::vector<char> header;
+    Append(header, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    Append(header, &SNAPSHOT_VERSION, sizeof(SNAPSHOT_VERSION));
+    AppendString(header, key);
+
+    uint32 const columnCount = uint32(_columns.size());
+    Append(header, &columnCount, sizeof(columnCount));
+    for (Column const& column : _columns)
+    {
+        uint8 const type = uint8(column.Type);
+        AppendString(header, column.Table);
+        AppendString(header, column.Name);
+        Append(header, &column.MysqlType, sizeof(column.MysqlType));
+        Append(header, &type, sizeof(type));
+    }
+
+    uint64 const rowsSize = _rowsSize;
+    Append(header, &_rowCount, sizeof(_rowCount));
+    Append(header, &rowsSize, sizeof(rowsSize));
+
+    std::string const tempFileName = fileName + ".tmp";
+    {
+        std::ofstream file(tempFileName, std::ios::binary | std::ios::trunc);
+        file.write(header.data(), header.size());
+        file.write(_rows, _rowsSize);
+        if (!file)
+        {
+            TC_LOG_ERROR("sql.sql", "ResultSnapshot: could not write file '%s'", tempFileName.c_str());
+            return false;
+        }
+    }
+
+    boost::system::error_code error;
+    boost::filesystem::rename(tempFileName, fileName, error);
+    if (error)
+    {
+        TC_LOG_ERROR("sql.sql", "ResultSnapshot: could not rename '%s' to '%s' (%s)", tempFileName.c_str(), fileName.c_str(), error.message().c_str());
+        boost::filesystem::remove(tempFileName, error);
+        return false;
+    }
+
+    return true;
+}
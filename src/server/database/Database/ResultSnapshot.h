@@ -0,0 +1,64 @@
+#ifndef RESULTSNAPSHOT_H
+#define RESULTSNAPSHOT_H
+
+#include "Define.h"
+#include "DatabaseEnvFwd.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace boost
+{
+    namespace iostreams
+    {
+        class mapped_file_source;
+    }
+}
+
+enum class DatabaseFieldTypes : uint8;
+
+/* Rows of an ad hoc query result stored in a single flat buffer, which can be saved to disk and mapped back later.
+A ResultSet can then be built from it and read exactly like the one returned by the server. */
+class TC_DATABASE_API ResultSnapshot
+{
+    public:
+        struct Column
+        {
+            std::string Table;
+            std::string Name;
+            uint32 MysqlType;            // enum_field_types, only used for field metadata in debug builds
+            DatabaseFieldTypes Type;
+        };
+
+        // Each field of a row is stored as its length followed by its value, or as NULL_LENGTH alone for NULL values
+        static constexpr uint32 NULL_LENGTH = 0xFFFFFFFF;
+
+        ResultSnapshot();
+        ~ResultSnapshot();
+
+        // Copies the current and all following rows of result, which is left at its end
+        static std::shared_ptr<ResultSnapshot> Create(ResultSet& result);
+        // Returns nullptr if the file does not exist, is invalid or was saved with another key
+        static std::shared_ptr<ResultSnapshot> Load(std::string const& fileName, std::string const& key);
+        // Writes to a temporary file renamed at the end, so that an interrupted save never leaves a truncated snapshot
+        bool Save(std::string const& fileName, std::string const& key) const;
+
+        std::vector<Column> const& GetColumns() const { return _columns; }
+        uint64 GetRowCount() const { return _rowCount; }
+        char const* GetRows() const { return _rows; }
+        std::size_t GetRowsSize() const { return _rowsSize; }
+
+    private:
+        std::vector<Column> _columns;
+        uint64 _rowCount;
+        char const* _rows;
+        std::size_t _rowsSize;
+
+        std::vector<char> _buffer;                                          // rows of a snapshot created from a result
+        std::unique_ptr<boost::iostreams::mapped_file_source> _mappedFile;  // file the rows of a loaded snapshot are read from
+
+        ResultSnapshot(ResultSnapshot const& right) = delete;
+        ResultSnapshot& operator=(ResultSnapshot const& right) = delete;
+};
+
+#endif
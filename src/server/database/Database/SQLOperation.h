@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <string>
 
 //- Union that holds element data
 union SQLElementUnion
@@ -63,6 +64,10 @@ class TC_DATABASE_API SQLOperation
             return 0;
         }
         virtual bool Execute() = 0;
+        //- Can this operation be executed along other queued ones in a single transaction? (see DatabaseWorker)
+        virtual bool IsBatchable() const { return false; }
+        //- Query executed by this operation, for logging
+        virtual std::string GetQueryString() const { return ""; }
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
         MySQLConnection* m_conn;
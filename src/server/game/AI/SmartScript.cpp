@@ -20,6 +20,7 @@
 #include "ScriptedCreature.h"
 #include "CreatureTextMgr.h"
 #include "Language.h"
+#include <functional>
 
 /*
 class TrinityStringTextBuilder 
@@ -86,17 +87,15 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
-    for (auto& mEvent : mEvents)
-    {
-        SMART_EVENT eventType = SMART_EVENT(mEvent.GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+    if (e == SMART_EVENT_LINK || e >= SMART_EVENT_END) //special handling
+        return;
 
-        if (eventType == e)
-        {
-            if (sConditionMgr->IsObjectMeetingSmartEventConditions(mEvent.entryOrGuid, mEvent.event_id, mEvent.source_type, unit, GetBaseObject()))
-                ProcessEvent(mEvent, unit, var0, var1, bvar, spell, gob);
-        }
+    std::vector<uint32> const& events = mEventsByType[e];
+    for (uint32 i = 0; i < events.size(); i++)
+    {
+        SmartScriptHolder& mEvent = mEvents[events[i]];
+        if (sConditionMgr->IsObjectMeetingSmartEventConditions(mEvent.entryOrGuid, mEvent.event_id, mEvent.source_type, unit, GetBaseObject()))
+            ProcessEvent(mEvent, unit, var0, var1, bvar, spell, gob);
     }
 }
 
@@ -4011,6 +4010,62 @@ void SmartScript::RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max)
 
     e.timer = urand(uint32(min), uint32(max));
     e.active = e.timer ? false : true;
+
+    // non timed events from mEvents need to be updated until their cooldown is over. e may also be from another list
+    // (mTimedActionList...), std::less gives a total order on pointers to unrelated objects, unlike built-in comparisons
+    std::less<SmartScriptHolder const*> const before;
+    if (!e.active && !IsTimedEventType(e.GetEventType()) && e.GetEventType() != SMART_EVENT_LINK && !mEvents.empty()
+        && !before(&e, &mEvents.front()) && !before(&mEvents.back(), &e))
+    {
+        uint32 const index = uint32(&e - &mEvents.front());
+        if (std::find(mCooldownEvents.begin(), mCooldownEvents.end(), index) == mCooldownEvents.end())
+            mCooldownEvents.push_back(index);
+    }
+}
+
+bool SmartScript::IsTimedEventType(SMART_EVENT type)
+{
+    switch (type)
+    {
+        case SMART_EVENT_UPDATE:
+        case SMART_EVENT_UPDATE_OOC:
+        case SMART_EVENT_UPDATE_IC:
+        case SMART_EVENT_HEALT_PCT:
+        case SMART_EVENT_TARGET_HEALTH_PCT:
+        case SMART_EVENT_MANA_PCT:
+        case SMART_EVENT_TARGET_MANA_PCT:
+        case SMART_EVENT_RANGE:
+        case SMART_EVENT_VICTIM_CASTING:
+        case SMART_EVENT_FRIENDLY_HEALTH:
+        case SMART_EVENT_FRIENDLY_IS_CC:
+        case SMART_EVENT_FRIENDLY_MISSING_BUFF:
+        case SMART_EVENT_HAS_AURA:
+        case SMART_EVENT_TARGET_BUFFED:
+        case SMART_EVENT_IS_BEHIND_TARGET:
+        case SMART_EVENT_FRIENDLY_HEALTH_PCT:
+        case SMART_EVENT_DISTANCE_CREATURE:
+        case SMART_EVENT_DISTANCE_GAMEOBJECT:
+        case SMART_EVENT_VICTIM_NOT_IN_LOS:
+        case SMART_EVENT_AFFECTED_BY_MECHANIC:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void SmartScript::PushEvent(SmartScriptHolder const& e)
+{
+    uint32 const index = mEvents.size();
+    mEvents.push_back(e);
+
+    SMART_EVENT const type = e.GetEventType();
+    if (type < SMART_EVENT_END)
+        mEventsByType[type].push_back(index);
+
+    if (IsTimedEventType(type))
+        mTimedEvents.push_back(index);
+    else if (!e.active && type != SMART_EVENT_LINK)
+        mCooldownEvents.push_back(index);
 }
 
 void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
@@ -4053,49 +4108,26 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
         }
 
         e.active = true;//activate events with cooldown
-        switch (e.GetEventType())//process ONLY timed events
-        {
-            case SMART_EVENT_UPDATE:
-            case SMART_EVENT_UPDATE_OOC:
-            case SMART_EVENT_UPDATE_IC:
-            case SMART_EVENT_HEALT_PCT:
-            case SMART_EVENT_TARGET_HEALTH_PCT:
-            case SMART_EVENT_MANA_PCT:
-            case SMART_EVENT_TARGET_MANA_PCT:
-            case SMART_EVENT_RANGE:
-            case SMART_EVENT_VICTIM_CASTING:
-            case SMART_EVENT_FRIENDLY_HEALTH:
-            case SMART_EVENT_FRIENDLY_IS_CC:
-            case SMART_EVENT_FRIENDLY_MISSING_BUFF:
-            case SMART_EVENT_HAS_AURA:
-            case SMART_EVENT_TARGET_BUFFED:
-            case SMART_EVENT_IS_BEHIND_TARGET:
-            case SMART_EVENT_FRIENDLY_HEALTH_PCT:
-            case SMART_EVENT_DISTANCE_CREATURE:
-            case SMART_EVENT_DISTANCE_GAMEOBJECT:
-            case SMART_EVENT_VICTIM_NOT_IN_LOS:
-            case SMART_EVENT_AFFECTED_BY_MECHANIC:
-            {
-                if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
+        if (IsTimedEventType(e.GetEventType()))//process ONLY timed events
+        {
+            if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
+            {
+                Unit* invoker = nullptr;
+                if (me && mTimedActionListInvoker)
+                    invoker = ObjectAccessor::GetUnit(*me, mTimedActionListInvoker);
+                ProcessEvent(e, invoker);
+                e.enableTimed = false;//disable event if it is in an ActionList and was processed once
+                for (auto & i : mTimedActionList)
                 {
-                    Unit* invoker = nullptr;
-                    if (me && mTimedActionListInvoker)
-                        invoker = ObjectAccessor::GetUnit(*me, mTimedActionListInvoker);
-                    ProcessEvent(e, invoker);
-                    e.enableTimed = false;//disable event if it is in an ActionList and was processed once
-                    for (auto & i : mTimedActionList)
+                    //find the first event which is not the current one and enable it
+                    if (i.event_id > e.event_id)
                     {
-                        //find the first event which is not the current one and enable it
-                        if (i.event_id > e.event_id)
-                        {
-                            i.enableTimed = true;
-                            break;
-                        }
+                        i.enableTimed = true;
+                        break;
                     }
-                } else 
-                    ProcessEvent(e);
-                break;
-            }
+                }
+            } else 
+                ProcessEvent(e);
         }
     }
     else
@@ -4112,7 +4144,7 @@ void SmartScript::InstallEvents()
     if (!mInstallEvents.empty())
     {
         for (auto & mInstallEvent : mInstallEvents)
-            mEvents.push_back(mInstallEvent);//must be before UpdateTimers
+            PushEvent(mInstallEvent);//must be before UpdateTimers
 
         mInstallEvents.clear();
     }
@@ -4176,8 +4208,22 @@ void SmartScript::OnUpdate(uint32 const diff)
 
     InstallEvents();//before UpdateTimers
 
-    for (auto & mEvent : mEvents)
-        UpdateTimer(mEvent, diff);
+    for (uint32 index : mTimedEvents)
+        UpdateTimer(mEvents[index], diff);
+
+    // events with a cooldown, no longer updated once active again
+    for (uint32 i = 0; i < mCooldownEvents.size();)
+    {
+        SmartScriptHolder& e = mEvents[mCooldownEvents[i]];
+        UpdateTimer(e, diff);
+        if (e.active)
+        {
+            mCooldownEvents[i] = mCooldownEvents.back();
+            mCooldownEvents.pop_back();
+        }
+        else
+            i++;
+    }
 
     if (!mStoredEvents.empty())
     {
@@ -4251,15 +4297,15 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
             if(obj && obj->GetMap()->IsDungeon())
             {
                 if ((1 << (obj->GetMap()->GetSpawnMode()+1)) & i.event.event_flags)
-                    mEvents.push_back(i);
+                    PushEvent(i);
             } else {
                 //if out of instance, still play "normal" difficulty events
                 if(i.event.event_flags & SMART_EVENT_FLAG_DIFFICULTY_0)
-                    mEvents.push_back(i);
+                    PushEvent(i);
             }
             continue;
         }
-        mEvents.push_back(i);//NOTE: 'world(0)' events still get processed in ANY instance mode
+        PushEvent(i);//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
 }
 
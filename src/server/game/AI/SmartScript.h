@@ -216,7 +216,18 @@ class TC_GAME_API SmartScript
         void SetPhase(uint32 p = 0);
         void SetTemplatePhase(uint32 p = 0);
 
+        // Add event to mEvents and to the indexes below (AddEvent only queues events in mInstallEvents)
+        void PushEvent(SmartScriptHolder const& e);
+        // Events which timer is processed in UpdateTimer (SMART_EVENT_UPDATE, SMART_EVENT_HEALT_PCT, ...)
+        static bool IsTimedEventType(SMART_EVENT type);
+
         SmartAIEventList mEvents;
+        // Indexes in mEvents, by event type. mEvents is never shrunk so indexes stay valid.
+        std::array<std::vector<uint32>, SMART_EVENT_END> mEventsByType;
+        // Indexes in mEvents of timed events, updated every OnUpdate
+        std::vector<uint32> mTimedEvents;
+        // Indexes in mEvents of other events currently on cooldown (not active), they're only updated until their cooldown is over
+        std::vector<uint32> mCooldownEvents;
         SmartAIEventList mInstallEvents;
         SmartAIEventList mTimedActionList;
         ObjectGuid mTimedActionListInvoker;
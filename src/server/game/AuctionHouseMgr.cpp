@@ -447,6 +447,91 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(uint32 factionTem
     return sAuctionHouseStore.LookupEntry(houseid);
 }
 
+std::wstring const& AuctionHouseMgr::GetItemSearchName(uint32 itemEntry, LocaleConstant locale)
+{
+    auto& names = _itemSearchNames[locale < TOTAL_LOCALES ? locale : LOCALE_enUS];
+    auto itr = names.find(itemEntry);
+    if (itr != names.end())
+        return itr->second;
+
+    std::wstring& wname = names[itemEntry];
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(itemEntry);
+    if (!proto)
+        return wname;
+
+    std::string name = proto->Name1;
+    if (ItemLocale const* il = sObjectMgr->GetItemLocale(itemEntry))
+        if (il->Name.size() > size_t(locale) && !il->Name[locale].empty())
+            name = il->Name[locale];
+
+    if (Utf8toWStr(name, wname))
+        wstrToLower(wname);
+    else
+        wname.clear();
+
+    return wname;
+}
+
+void AuctionHouseObject::AddAuction(AuctionEntry *ah)
+{
+    ASSERT( ah );
+    AuctionsMap[ah->Id] = ah;
+    AddToSearchIndexes(ah);
+}
+
+bool AuctionHouseObject::RemoveAuction(uint32 id)
+{
+    auto itr = AuctionsMap.find(id);
+    if (itr == AuctionsMap.end())
+        return false;
+
+    if (itr->second)
+        RemoveFromSearchIndexes(itr->second);
+
+    AuctionsMap.erase(itr);
+    return true;
+}
+
+void AuctionHouseObject::AddToSearchIndexes(AuctionEntry* auction)
+{
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction->itemEntry);
+    if (!proto)
+        return;
+
+    _auctionsByItemEntry[auction->itemEntry][auction->Id] = auction;
+    _auctionsByClass[proto->Class][auction->Id] = auction;
+    _auctionsBySubClass[(proto->Class << 16) | proto->SubClass][auction->Id] = auction;
+    _auctionsByInventoryType[proto->InventoryType][auction->Id] = auction;
+    _auctionsByQuality[proto->Quality][auction->Id] = auction;
+    _auctionsByRequiredLevel[proto->RequiredLevel][auction->Id] = auction;
+}
+
+template<class Index>
+static void RemoveFromSearchIndex(Index& index, uint32 key, uint32 auctionId)
+{
+    auto itr = index.find(key);
+    if (itr == index.end())
+        return;
+
+    itr->second.erase(auctionId);
+    if (itr->second.empty())
+        index.erase(itr);
+}
+
+void AuctionHouseObject::RemoveFromSearchIndexes(AuctionEntry const* auction)
+{
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction->itemEntry);
+    if (!proto)
+        return;
+
+    RemoveFromSearchIndex(_auctionsByItemEntry, auction->itemEntry, auction->Id);
+    RemoveFromSearchIndex(_auctionsByClass, proto->Class, auction->Id);
+    RemoveFromSearchIndex(_auctionsBySubClass, (proto->Class << 16) | proto->SubClass, auction->Id);
+    RemoveFromSearchIndex(_auctionsByInventoryType, proto->InventoryType, auction->Id);
+    RemoveFromSearchIndex(_auctionsByQuality, proto->Quality, auction->Id);
+    RemoveFromSearchIndex(_auctionsByRequiredLevel, proto->RequiredLevel, auction->Id);
+}
+
 void AuctionHouseObject::Update()
 {
     time_t curTime = WorldGameTime::GetGameTime();
@@ -478,9 +563,9 @@ void AuctionHouseObject::Update()
             itr->second->DeleteFromDB(trans);
 
             sAuctionMgr->RemoveAItem(itr->second->itemGUIDLow);
-            delete itr->second;
-            itr->second = nullptr;
+            AuctionEntry* auction = itr->second;
             RemoveAuction(itr->first);
+            delete auction;
         }
     }
     if(trans->GetSize()) //Sun: don't commit empty transaction
@@ -516,10 +601,9 @@ void AuctionHouseObject::RemoveAllAuctionsOf(SQLTransaction& trans, ObjectGuid::
             itr->second->DeleteFromDB(trans);
 
             sAuctionMgr->RemoveAItem(itr->second->itemGUIDLow);
-            delete itr->second;
-            itr->second = nullptr;
-
+            AuctionEntry* auction = itr->second;
             RemoveAuction(itr->first);
+            delete auction;
         }
     }
 }
@@ -572,41 +656,124 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
     uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
     uint32& count, uint32& totalcount)
 {
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin();itr != AuctionsMap.end();++itr)
+    // Only go through the smallest index matching one of the filters, other filters are checked on each of its auctions
+    AuctionEntryMap const* candidates = &AuctionsMap;
+    auto useIndex = [&candidates](auto const& index, uint32 key)
     {
-        AuctionEntry *Aentry = itr->second;
-        Item *item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow);
-        if (!item)
-            continue;
+        auto itr = index.find(key);
+        if (itr == index.end())
+            return false; // no auction can match
 
-        ItemTemplate const *proto = item->GetTemplate();
+        if (itr->second.size() < candidates->size())
+            candidates = &itr->second;
+        return true;
+    };
+
+    if (itemClass != (0xffffffff))
+    {
+        bool found = itemSubClass != (0xffffffff) ? useIndex(_auctionsBySubClass, (itemClass << 16) | itemSubClass) : useIndex(_auctionsByClass, itemClass);
+        if (!found)
+            return;
+    }
+
+    if (inventoryType != (0xffffffff) && !useIndex(_auctionsByInventoryType, inventoryType))
+        return;
+
+    if (quality != (0xffffffff) && !useIndex(_auctionsByQuality, quality))
+        return;
+
+    LocaleConstant const locale = player->GetSession()->GetSessionDbcLocale();
+
+    // Item entries whose name match. Name is the same for all auctions of an entry, so it's checked once per entry.
+    std::unordered_set<uint32> matchingEntries;
+    // Auctions of those entries, or of the searched level range, if they are fewer than candidates. Ordered by id.
+    std::vector<AuctionEntry*> candidatesList;
+    bool useCandidatesList = false;
+    if (!wsearchedname.empty())
+    {
+        size_t matchingCount = 0;
+        for (auto const& itr : _auctionsByItemEntry)
+        {
+            if (sAuctionMgr->GetItemSearchName(itr.first, locale).find(wsearchedname) == std::wstring::npos)
+                continue;
+
+            matchingEntries.insert(itr.first);
+            matchingCount += itr.second.size();
+        }
+
+        if (matchingEntries.empty())
+            return;
+
+        if (matchingCount < candidates->size())
+        {
+            candidatesList.reserve(matchingCount);
+            for (uint32 itemEntry : matchingEntries)
+                for (auto const& itr : _auctionsByItemEntry[itemEntry])
+                    candidatesList.push_back(itr.second);
+
+            useCandidatesList = true;
+        }
+    }
+
+    if (levelmin || levelmax)
+    {
+        auto begin = _auctionsByRequiredLevel.lower_bound(levelmin);
+        auto end = levelmax ? _auctionsByRequiredLevel.upper_bound(levelmax) : _auctionsByRequiredLevel.end();
+        size_t rangeCount = 0;
+        for (auto itr = begin; itr != end; ++itr)
+            rangeCount += itr->second.size();
+
+        if (!rangeCount)
+            return;
+
+        if (rangeCount < (useCandidatesList ? candidatesList.size() : candidates->size()))
+        {
+            candidatesList.clear();
+            candidatesList.reserve(rangeCount);
+            for (auto itr = begin; itr != end; ++itr)
+                for (auto const& itr2 : itr->second)
+                    candidatesList.push_back(itr2.second);
+
+            useCandidatesList = true;
+        }
+    }
+
+    auto processAuction = [&](AuctionEntry* Aentry)
+    {
+        ItemTemplate const *proto = sObjectMgr->GetItemTemplate(Aentry->itemEntry);
+        if (!proto)
+            return;
 
         if (itemClass != (0xffffffff) && proto->Class != itemClass)
-            continue;
+            return;
 
         if (itemSubClass != (0xffffffff) && proto->SubClass != itemSubClass)
-            continue;
+            return;
 
         if (inventoryType != (0xffffffff) && proto->InventoryType != inventoryType)
-            continue;
+            return;
 
         if (quality != (0xffffffff) && proto->Quality != quality)
-            continue;
+            return;
 
         if(    ( levelmin && (proto->RequiredLevel < levelmin) )
             || ( levelmax && (proto->RequiredLevel > levelmax) ) 
           )
-            continue;
+            return;
 
-        if( usable != (0x00) && player->CanUseItem( item ) != EQUIP_ERR_OK )
-            continue;
+        // Cached name is empty if the item has no name in this locale
+        if (sAuctionMgr->GetItemSearchName(Aentry->itemEntry, locale).empty())
+            return;
 
-        std::string name = player->GetSession()->GetLocalizedItemName(proto);
-        if(name.empty())
-            continue;
+        if (!wsearchedname.empty() && !matchingEntries.count(Aentry->itemEntry))
+            return;
 
-        if( !wsearchedname.empty() && !Utf8FitTo(name, wsearchedname) )
-            continue;
+        Item *item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow);
+        if (!item)
+            return;
+
+        if( usable != (0x00) && player->CanUseItem( item ) != EQUIP_ERR_OK )
+            return;
 
         if ((count < 50) && (totalcount >= listfrom))
         {
@@ -615,6 +782,19 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
         }
 
         ++totalcount;
+    };
+
+    if (useCandidatesList)
+    {
+        // keep the same order as AuctionsMap so that pages are consistent whatever index was used
+        std::sort(candidatesList.begin(), candidatesList.end(), [](AuctionEntry const* a, AuctionEntry const* b) { return a->Id < b->Id; });
+        for (AuctionEntry* Aentry : candidatesList)
+            processAuction(Aentry);
+    }
+    else
+    {
+        for (auto const& itr : *candidates)
+            processAuction(itr.second);
     }
 }
 
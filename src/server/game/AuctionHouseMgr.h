@@ -83,11 +83,7 @@ class AuctionHouseObject
     AuctionEntryMap::iterator GetAuctionsBegin() {return AuctionsMap.begin();}
     AuctionEntryMap::iterator GetAuctionsEnd() {return AuctionsMap.end();}
 
-    void AddAuction(AuctionEntry *ah)
-    {
-        ASSERT( ah );
-        AuctionsMap[ah->Id] = ah;
-    }
+    void AddAuction(AuctionEntry *ah);
 
     AuctionEntry* GetAuction(uint32 id) const
     {
@@ -95,11 +91,8 @@ class AuctionHouseObject
         return itr != AuctionsMap.end() ? itr->second : nullptr;
     }
 
-    bool RemoveAuction(uint32 id)
-    {
-        return AuctionsMap.erase(id) ? true : false;
-    }
-    
+    bool RemoveAuction(uint32 id);
+
     void RemoveAllAuctionsOf(SQLTransaction& trans, ObjectGuid::LowType ownerGUID);
 
     void Update();
@@ -113,7 +106,18 @@ class AuctionHouseObject
         uint32& count, uint32& totalcount);
 
   private:
+    void AddToSearchIndexes(AuctionEntry* auction);
+    void RemoveFromSearchIndexes(AuctionEntry const* auction);
+
     AuctionEntryMap AuctionsMap;
+
+    // Search indexes used by BuildListAuctionItems, they hold the same auctions as AuctionsMap, also ordered by id
+    std::unordered_map<uint32 /*itemEntry*/, AuctionEntryMap> _auctionsByItemEntry;
+    std::unordered_map<uint32 /*class*/, AuctionEntryMap> _auctionsByClass;
+    std::unordered_map<uint32 /*class << 16 | subclass*/, AuctionEntryMap> _auctionsBySubClass;
+    std::unordered_map<uint32 /*inventoryType*/, AuctionEntryMap> _auctionsByInventoryType;
+    std::unordered_map<uint32 /*quality*/, AuctionEntryMap> _auctionsByQuality;
+    std::map<uint32 /*requiredLevel*/, AuctionEntryMap> _auctionsByRequiredLevel;
 };
 
 class TC_GAME_API AuctionHouseMgr
@@ -151,6 +155,9 @@ class TC_GAME_API AuctionHouseMgr
         void SendAuctionOutbiddedMail(AuctionEntry * auction, uint32 newPrice, Player* newBidder, SQLTransaction& trans);
         void SendAuctionCancelledToBidderMail(AuctionEntry* auction, SQLTransaction& trans);
 
+        // Lower case name of item in given locale, as compared to searched name in auction house. Cached, world thread only.
+        std::wstring const& GetItemSearchName(uint32 itemEntry, LocaleConstant locale);
+
         static uint32 GetAuctionDeposit(AuctionHouseEntry const* entry, uint32 time, Item *pItem);
         static AuctionHouseEntry const* GetAuctionHouseEntry(uint32 factionTemplateId);
         void RemoveAllAuctionsOf(SQLTransaction& trans, ObjectGuid::LowType ownerGUID);
@@ -171,6 +178,8 @@ class TC_GAME_API AuctionHouseMgr
       AuctionHouseObject mNeutralAuctions;
 
       ItemMap mAitems;
+
+      std::array<std::unordered_map<uint32 /*itemEntry*/, std::wstring>, TOTAL_LOCALES> _itemSearchNames;
 };
 
 #define sAuctionMgr AuctionHouseMgr::instance()
@@ -370,16 +370,19 @@ Position const* Battleground::GetTeamStartPosition(TeamId teamId) const
 
 void Battleground::SendPacketToAll(WorldPacket *packet)
 {
+    // copied once, sockets of all players reference the same packet
+    SharedWorldPacket const sharedPacket = std::make_shared<WorldPacket const>(*packet);
     for(auto & m_Player : m_Players)
     {
         Player *plr = ObjectAccessor::FindPlayer(m_Player.first);
         if(plr)
-            plr->SendDirectMessage(packet);
+            plr->SendDirectMessage(sharedPacket);
     }
 }
 
 void Battleground::SendPacketToTeam(uint32 TeamID, WorldPacket *packet, Player *sender, bool self)
 {
+    SharedWorldPacket const sharedPacket = std::make_shared<WorldPacket const>(*packet);
     for(auto & m_Player : m_Players)
     {
         Player *plr = ObjectAccessor::FindPlayer(m_Player.first);
@@ -394,7 +397,7 @@ void Battleground::SendPacketToTeam(uint32 TeamID, WorldPacket *packet, Player *
         if(!team) team = plr->GetTeam();
 
         if(team == TeamID)
-            plr->SendDirectMessage(packet);
+            plr->SendDirectMessage(sharedPacket);
     }
 }
 
@@ -710,26 +710,29 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket *data, ObjectGuid p)
 {
+    // copied once, sockets of all members reference the same packet
+    SharedWorldPacket const sharedData = std::make_shared<WorldPacket const>(*data);
     for(auto & player : players)
     {
         Player *plr = ObjectAccessor::FindPlayer(player.first);
         if(plr)
         {
             if(!p || !plr->GetSocial()->HasIgnore(p.GetCounter()))
-                plr->SendDirectMessage(data);
+                plr->SendDirectMessage(sharedData);
         }
     }
 }
 
 void Channel::SendToAllButOne(WorldPacket *data, ObjectGuid who)
 {
+    SharedWorldPacket const sharedData = std::make_shared<WorldPacket const>(*data);
     for(auto & player : players)
     {
         if(player.first != who)
         {
             Player *plr = ObjectAccessor::FindPlayer(player.first);
             if(plr)
-                plr->SendDirectMessage(data);
+                plr->SendDirectMessage(sharedData);
         }
     }
 }
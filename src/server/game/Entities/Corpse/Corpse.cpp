@@ -44,8 +44,11 @@ Corpse::~Corpse()
 void Corpse::AddToWorld()
 {
     ///- Register the corpse for guid lookup
-    if(!IsInWorld()) 
+    if(!IsInWorld())
+    {
+        auto lock = GetMap()->LockForRegionUpdate();
         GetMap()->GetObjectsStore().Insert<Corpse>(GetGUID(), this);
+    }
 
     Object::AddToWorld();
 }
@@ -53,8 +56,11 @@ void Corpse::AddToWorld()
 void Corpse::RemoveFromWorld()
 {
     ///- Remove the corpse from the accessor
-    if(IsInWorld()) 
+    if(IsInWorld())
+    {
+        auto lock = GetMap()->LockForRegionUpdate();
         GetMap()->GetObjectsStore().Remove<Corpse>(GetGUID());
+    }
 
     Object::RemoveFromWorld();
 }
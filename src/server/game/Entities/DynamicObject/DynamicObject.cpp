@@ -48,7 +48,10 @@ void DynamicObject::AddToWorld()
     ///- Register the dynamicObject for guid lookup
     if(!IsInWorld())
     {
-        GetMap()->GetObjectsStore().Insert<DynamicObject>(GetGUID(), this);
+        {
+            auto lock = GetMap()->LockForRegionUpdate();
+            GetMap()->GetObjectsStore().Insert<DynamicObject>(GetGUID(), this);
+        }
         WorldObject::AddToWorld();
         BindToCaster();
     }
@@ -71,7 +74,10 @@ void DynamicObject::RemoveFromWorld()
 
         UnbindFromCaster();
         WorldObject::RemoveFromWorld();
-        GetMap()->GetObjectsStore().Remove<DynamicObject>(GetGUID());
+        {
+            auto lock = GetMap()->LockForRegionUpdate();
+            GetMap()->GetObjectsStore().Remove<DynamicObject>(GetGUID());
+        }
         if(GetTransport())
             GetTransport()->RemovePassenger(this);
     }
@@ -164,6 +164,21 @@ std::string GameObject::GetAIName() const
     return sObjectMgr->GetGameObjectTemplate(GetEntry())->AIName;
 }
 
+bool GameObject::IsValuesUpdateShareable(uint8 /*updateType*/) const
+{
+    // Keep in sync with BuildValuesUpdate. Dynamic flags are always sent and depend on target quests for these types.
+    switch (GetGoType())
+    {
+        case GAMEOBJECT_TYPE_QUESTGIVER:
+        case GAMEOBJECT_TYPE_CHEST:
+        case GAMEOBJECT_TYPE_GOOBER:
+        case GAMEOBJECT_TYPE_GENERIC:
+            return false;
+        default:
+            return true;
+    }
+}
+
 void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const
 {
     if (!target)
@@ -275,10 +290,12 @@ void GameObject::AddToWorld()
         if (m_zoneScript)
             m_zoneScript->OnGameObjectCreate(this);
 
-        GetMap()->GetObjectsStore().Insert<GameObject>(GetGUID(), this);
-
-        if (m_spawnId)
-            GetMap()->GetGameObjectBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
+        {
+            auto lock = GetMap()->LockForRegionUpdate();
+            GetMap()->GetObjectsStore().Insert<GameObject>(GetGUID(), this);
+            if (m_spawnId)
+                GetMap()->GetGameObjectBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
+        }
 
         // The state can be changed after GameObject::Create but before GameObject::AddToWorld
         bool toggledState = GetGoType() == GAMEOBJECT_TYPE_CHEST ? getLootState() == GO_READY : (GetGoState() == GO_STATE_READY || IsTransport());
@@ -308,10 +325,12 @@ void GameObject::RemoveFromWorld()
             if (GetMap()->ContainsGameObjectModel(*m_model))
                 GetMap()->RemoveGameObjectModel(*m_model);
 
-        GetMap()->GetObjectsStore().Remove<GameObject>(GetGUID());
-
-        if (m_spawnId)
-            Trinity::Containers::MultimapErasePair(GetMap()->GetGameObjectBySpawnIdStore(), m_spawnId, this);
+        {
+            auto lock = GetMap()->LockForRegionUpdate();
+            GetMap()->GetObjectsStore().Remove<GameObject>(GetGUID());
+            if (m_spawnId)
+                Trinity::Containers::MultimapErasePair(GetMap()->GetGameObjectBySpawnIdStore(), m_spawnId, this);
+        }
 
         WorldObject::RemoveFromWorld();
     }
@@ -562,7 +581,9 @@ void GameObject::Update(uint32 diff)
                     time_t now = GetMap()->GetGameTime();
                     if (m_respawnTime <= now)            // timer expired
                     {
+                        bool const wasSpawned = isSpawned();
                         m_respawnTime = 0;
+                        SpawnStateChanged(wasSpawned);
                         m_SkillupList.clear();
                         m_usetimes = 0;
 
@@ -832,9 +853,11 @@ void GameObject::Update(uint32 diff)
             if(!m_respawnDelayTime)
                 return;
 
+            bool const wasSpawned = isSpawned();
             if(!m_spawnedByDefault)
             {
                 m_respawnTime = 0;
+                SpawnStateChanged(wasSpawned);
                 DestroyForNearbyPlayers(); // old UpdateObjectVisibility()
                 return;
             }
@@ -844,6 +867,7 @@ void GameObject::Update(uint32 diff)
                 GetMap()->ApplyDynamicModeRespawnScaling(this, this->m_spawnId, respawnDelay, scalingMode);
 
             m_respawnTime = GetMap()->GetGameTime() + respawnDelay;
+            SpawnStateChanged(wasSpawned);
 
             // if option not set then object will be saved at grid unload
             if(sWorld->getConfig(CONFIG_SAVE_RESPAWN_TIME_IMMEDIATELY))
@@ -1177,6 +1201,7 @@ void GameObject::SetDisplayId(uint32 displayid)
 {
     SetUInt32Value(GAMEOBJECT_DISPLAYID, displayid);
     UpdateModel();
+    UpdateGridPosition();
 }
 
 void GameObject::SetPhaseMask(uint32 newPhaseMask, bool update)
@@ -1193,6 +1218,14 @@ void GameObject::EnableCollision(bool enable)
         return;
 
     m_model->enable(enable);
+    if (IsInWorld())
+        GetMap()->GameObjectModelChanged();
+}
+
+void GameObject::SpawnStateChanged(bool wasSpawned)
+{
+    if (m_model && IsInWorld() && isSpawned() != wasSpawned)
+        GetMap()->GameObjectModelChanged();
 }
 
 void GameObject::UpdateModel()
@@ -1380,7 +1413,9 @@ void GameObject::Respawn()
 {
     if(m_spawnedByDefault && m_respawnTime > 0)
     {
+        bool const wasSpawned = isSpawned();
         m_respawnTime = GetMap()->GetGameTime();
+        SpawnStateChanged(wasSpawned);
         GetMap()->RemoveRespawnTime(SPAWN_TYPE_GAMEOBJECT, m_spawnId, true);
     }
 }
@@ -2168,6 +2203,19 @@ bool GameObject::IsInRange(float x, float y, float z, float radius) const
         && dz < (info->maxZ*scale) + radius && dz >(info->minZ*scale) - radius;
 }
 
+float GameObject::GetGridSearchRadius() const
+{
+    // Bounds of the model box checked by IsInRange, whatever the orientation
+    GameObjectDisplayInfoEntry const* info = sGameObjectDisplayInfoStore.LookupEntry(GetUInt32Value(GAMEOBJECT_DISPLAYID));
+    if (!info)
+        return 2.0f;
+
+    float const x = std::max(std::fabs(info->minX), std::fabs(info->maxX));
+    float const y = std::max(std::fabs(info->minY), std::fabs(info->maxY));
+    float const z = std::max(std::fabs(info->minZ), std::fabs(info->maxZ));
+    return std::max(std::sqrt(x * x + y * y), z) * GetObjectScale();
+}
+
 void GameObject::AddUse()
 {
      ++m_usetimes;
@@ -2178,12 +2226,21 @@ void GameObject::AddUse()
 
 void GameObject::SetRespawnTime(int32 respawn)
 {
+    bool const wasSpawned = isSpawned();
     m_respawnTime = respawn > 0 ? GetMap()->GetGameTime() + respawn : 0;
     m_respawnDelayTime = respawn > 0 ? respawn : 0;
+    SpawnStateChanged(wasSpawned);
     if (respawn && !m_spawnedByDefault)
         UpdateObjectVisibility(true);
 }
 
+void GameObject::SetSpawnedByDefault(bool b)
+{
+    bool const wasSpawned = isSpawned();
+    m_spawnedByDefault = b;
+    SpawnStateChanged(wasSpawned);
+}
+
 void GameObject::DespawnOrUnsummon(Milliseconds const& delay, Seconds forceRespawnTime)
 {
     if (delay > 0ms)
@@ -516,6 +516,7 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
         ~GameObject() override;
 
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+        bool IsValuesUpdateShareable(uint8 updatetype) const override;
 
         void AddToWorld() override;
         void RemoveFromWorld() override;
@@ -599,7 +600,7 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
                 (m_respawnTime == 0 && m_spawnedByDefault);
         }
         bool isSpawnedByDefault() const { return m_spawnedByDefault; }
-        void SetSpawnedByDefault(bool b) { m_spawnedByDefault = b; }
+        void SetSpawnedByDefault(bool b);
         uint32 GetRespawnDelay() const { return m_respawnDelayTime; }
         void Refresh();
         void Delete();
@@ -685,6 +686,7 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
 
         void SendCustomAnim(uint32 anim);
         bool IsInRange(float x, float y, float z, float radius) const;
+        float GetGridSearchRadius() const override;
         
         void SwitchDoorOrButton(bool activate, bool alternative = false, Unit* user = nullptr);
         
@@ -762,6 +764,7 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
         GameObjectModel* CreateModel();
         static bool CanHaveModel(GameobjectTypes);
         void UpdateModel();                                 // updates model in case displayId were changed
+        void SpawnStateChanged(bool wasSpawned);            // model collision depends on isSpawned(), drops cached collision results of the map
 
         Position m_stationaryPosition;
 
@@ -226,6 +226,52 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData *data, Player *target) c
     data->AddUpdateBlock(buf);
 }
 
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateCache& cache) const
+{
+    if (!IsValuesUpdateShareable(UPDATETYPE_VALUES))
+    {
+        BuildFieldsUpdate(player, data_map);
+        return;
+    }
+
+    auto iter = data_map.find(player);
+    if (iter == data_map.end())
+    {
+        std::pair<UpdateDataMapType::iterator, bool> p = data_map.emplace(player, UpdateData());
+        ASSERT(p.second);
+        iter = p.first;
+    }
+
+    uint64 const key = GetValuesUpdateCacheKey(player);
+    for (auto const& cached : cache)
+    {
+        if (cached.first == key)
+        {
+            iter->second.AddUpdateBlock(cached.second);
+            return;
+        }
+    }
+
+    ByteBuffer buf(500);
+    buf << (uint8) UPDATETYPE_VALUES;
+    buf << GetPackGUID();
+    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, player);
+
+    iter->second.AddUpdateBlock(buf);
+    cache.emplace_back(key, std::move(buf));
+}
+
+uint64 Object::GetValuesUpdateCacheKey(Player* target) const
+{
+    uint32* flags = nullptr;
+    uint64 key = GetUpdateFieldData(target, flags);
+    // some fields are altered for gamemasters
+    if (target->IsGameMaster())
+        key |= uint64(1) << 32;
+
+    return key;
+}
+
 void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
 {
     auto iter = data_map.find(player);
@@ -896,6 +942,9 @@ WorldObject::~WorldObject()
         }
         ResetMap();
     }
+
+    // GridObject destructor unlinked the object if it was still in a grid
+    GridPositionIndex::Remove(m_gridPosition);
 }
 
 
@@ -1131,22 +1180,34 @@ bool WorldObject::IsWithinLOS(float ox, float oy, float oz, LineOfSightChecks ch
 {
     if(IsInWorld())
     {
-        oz += GetCollisionHeight();
-        float x, y, z;
-        if (GetTypeId() == TYPEID_PLAYER)
-        {
-            GetPosition(x, y, z);
-            z += GetCollisionHeight();
-        }
-        else
-            GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
-        
-        return GetMap()->isInLineOfSight(x, y, z + 2.0f, ox, oy, oz + 2.0f, GetPhaseMask(), checks, ignoreFlags);
+        VMAP::LineOfSightQuery query;
+        GetLOSQuery(ox, oy, oz, query);
+        return GetMap()->isInLineOfSight(query.x1, query.y1, query.z1, query.x2, query.y2, query.z2, GetPhaseMask(), checks, ignoreFlags);
    }
     
     return true;
 }
 
+void WorldObject::GetLOSQuery(float ox, float oy, float oz, VMAP::LineOfSightQuery& query) const
+{
+    oz += GetCollisionHeight();
+    float x, y, z;
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        GetPosition(x, y, z);
+        z += GetCollisionHeight();
+    }
+    else
+        GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
+
+    query.x1 = x;
+    query.y1 = y;
+    query.z1 = z + 2.0f;
+    query.x2 = ox;
+    query.y2 = oy;
+    query.z2 = oz + 2.0f;
+}
+
 Position WorldObject::GetHitSpherePointFor(Position const& dest) const
 {
     G3D::Vector3 vThis(GetPositionX(), GetPositionY(), GetPositionZ() + GetCollisionHeight());
@@ -2551,6 +2612,8 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     UpdatePlayerSet& i_playerSet;
     WorldObject& i_object;
+    // players most often get the same values update, only build it once per visibility class
+    ValuesUpdateCache i_valuesCache;
     WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d, UpdatePlayerSet &p) : i_updateDatas(d), i_object(obj), i_playerSet(p) 
     { 
         i_playerSet.clear();
@@ -2609,18 +2672,12 @@ struct WorldObjectChangeAccumulator
         }
     }
 
-    /*todo perf: As I understand it, what changes from player to player is visibility, we build almost the same packet for every players here, this could be vastly improved.
-    Maybe we could:
-    - Do a first pass where we just count players in range that should receive the packet
-    - If that count passes a certain threshold (maybe a very low one like 2-3?), send all those players a packet containing all the changes
-    I think that a client ignore "privates" field it shouldn't receive anyway (like those with UF_OWNER) so that shouldn't cause problems
-    */
     void BuildPacket(Player* player)
     {
         // Only send update once to a player
         if (i_playerSet.find(player->GetGUID().GetCounter()) == i_playerSet.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, i_valuesCache);
             i_playerSet.insert(player->GetGUID().GetCounter());
         }
     }
@@ -2643,6 +2700,15 @@ void WorldObject::BuildUpdate(UpdateDataMapType& data_map, UpdatePlayerSet& play
     ClearUpdateMask(false);
 }
 
+void WorldObject::AddToNotify(uint16 f)
+{
+    // queued once, until the map notifies it and resets its flags
+    if (!m_notifyflags && IsInWorld())
+        GetMap()->AddToRelocationNotify(this);
+
+    m_notifyflags |= f;
+}
+
 void WorldObject::AddToObjectUpdate()
 {
     GetMap()->AddUpdateObject(this);
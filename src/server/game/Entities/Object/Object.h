@@ -43,6 +43,8 @@ namespace G3D
 
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 typedef std::unordered_set<uint32> UpdatePlayerSet;
+// Values update blocks of one object already encoded during its BuildUpdate, keyed by visibility class (see Object::GetValuesUpdateCacheKey)
+typedef std::vector<std::pair<uint64 /*key*/, ByteBuffer>> ValuesUpdateCache;
 
 float const DEFAULT_COLLISION_HEIGHT = 2.03128f; // Most common value in dbc
 
@@ -133,8 +135,18 @@ public:
 	virtual ~GridObject() { }
 
 	bool IsInGrid() const { return _gridRef.isValid(); }
-	void AddToGrid(GridRefManager<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); }
-	void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.unlink(); }
+	void AddToGrid(GridRefManager<T>& m)
+	{
+		ASSERT(!IsInGrid());
+		_gridRef.link(&m, (T*)this);
+		static_cast<T*>(this)->AddToGridPositions(m.GetPositions(), static_cast<T*>(this));
+	}
+	void RemoveFromGrid()
+	{
+		ASSERT(IsInGrid());
+		GridPositionIndex::Remove(static_cast<T*>(this)->GetGridPositionLink());
+		_gridRef.unlink();
+	}
 private:
 	GridReference<T> _gridRef;
 };
@@ -259,6 +271,11 @@ class TC_GAME_API Object
            Creates the update map for him if it doesn't exists, else exists the already existing one.
         */
         void BuildFieldsUpdate(Player*, UpdateDataMapType& data_map) const;
+        /**
+           Same as above, but values update block is encoded only once per visibility class and copied for the next players of
+           that class. cache must only be used for this object and within the same BuildUpdate call.
+        */
+        void BuildFieldsUpdate(Player*, UpdateDataMapType& data_map, ValuesUpdateCache& cache) const;
 
         /** Force notify of all update fields having this flag. Don't forget to remove it afterwards. */
         void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
@@ -301,6 +318,13 @@ class TC_GAME_API Object
             Second step of filling updateData ByteBuffer with data from this object, for given target
         */
         virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* updateData, Player* target) const;
+        /**
+            Return true if BuildValuesUpdate output for given update type only depends on the target visibility class (see GetValuesUpdateCacheKey).
+            Must be overriden by classes writing target specific values.
+        */
+        virtual bool IsValuesUpdateShareable(uint8 /*updatetype*/) const { return true; }
+        // Targets with the same key get the same values update block, if IsValuesUpdateShareable
+        uint64 GetValuesUpdateCacheKey(Player* target) const;
 
         uint16 m_objectType;
 
@@ -439,6 +463,25 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         Position GetNearPosition(float dist, float angle);
 
         virtual float GetCombatReach() const { return 0.0f; } // overridden (only) in Unit
+
+        // Hide Position ones, so that the position of the object in the positions index of its grid follows
+        void Relocate(float x, float y) { Position::Relocate(x, y); UpdateGridPosition(); }
+        void Relocate(float x, float y, float z) { Position::Relocate(x, y, z); UpdateGridPosition(); }
+        void Relocate(float x, float y, float z, float orientation) { Position::Relocate(x, y, z, orientation); UpdateGridPosition(); }
+        void Relocate(Position const& pos) { Position::Relocate(pos); UpdateGridPosition(); }
+        void Relocate(Position const* pos) { Position::Relocate(pos); UpdateGridPosition(); }
+        void SetObjectScale(float scale) override { Object::SetObjectScale(scale); UpdateGridPosition(); }
+
+        // Distance from the position at which area searches may still find the object
+        virtual float GetGridSearchRadius() const { return GetCombatReach(); }
+        void AddToGridPositions(GridPositionIndex& index, void* object) { index.Insert(m_gridPosition, object, GetPositionX(), GetPositionY(), GetPositionZ(), GetGridSearchRadius()); }
+        GridPositionLink& GetGridPositionLink() { return m_gridPosition; }
+        // Must be called when something GetGridSearchRadius depends on changes
+        void UpdateGridPosition()
+        {
+            if (m_gridPosition.index)
+                GridPositionIndex::Update(m_gridPosition, GetPositionX(), GetPositionY(), GetPositionZ(), GetGridSearchRadius());
+        }
         bool IsPositionValid() const;
         //Set Z to ground position for given x and z
         void UpdateGroundPositionZ(float x, float y, float &z) const;
@@ -502,6 +545,8 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         bool IsWithinDist(WorldObject const* obj, float dist2compare, bool is3D = true) const;
         bool IsWithinDistInMap(WorldObject const* obj, float dist2compare, bool is3D = true, bool incOwnRadius = true, bool incTargetRadius = true) const;
         bool IsWithinLOS(float x, float y, float z, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
+        // Positions IsWithinLOS(x, y, z) checks
+        void GetLOSQuery(float x, float y, float z, VMAP::LineOfSightQuery& query) const;
         bool IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
         Position GetHitSpherePointFor(Position const& dest) const;
         void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const;
@@ -677,7 +722,7 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
 		void RemoveFromObjectUpdate() override;
 
 		//relocation and visibility system functions
-		void AddToNotify(uint16 f) { m_notifyflags |= f; }
+		void AddToNotify(uint16 f);
 		bool isNeedNotify(uint16 f) const { return (m_notifyflags & f) != 0; }
 		uint16 GetNotifyFlags() const { return m_notifyflags; }
 		bool NotifyExecuted(uint16 f) const { return (m_executed_notifies & f) != 0; }
@@ -720,6 +765,7 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         Map*   m_currMap;                                   //current object's Map location
 		uint32 m_InstanceId;                                // in map copy with instance id
         uint32 m_phaseMask;                                 // in area phase state
+        GridPositionLink m_gridPosition;
 
 		uint16 m_notifyflags;
 		uint16 m_executed_notifies;
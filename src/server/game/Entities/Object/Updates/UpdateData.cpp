@@ -26,29 +26,87 @@ void UpdateData::AddUpdateBlock(const ByteBuffer &block)
     ++m_blockCount;
 }
 
-void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
+namespace
 {
-    z_stream c_stream;
-
-    c_stream.zalloc = (alloc_func)nullptr;
-    c_stream.zfree = (free_func)nullptr;
-    c_stream.opaque = (voidpf)nullptr;
+    /* One deflate stream per thread, reset between packets instead of paying deflateInit/deflateEnd (and their
+    allocations) for each of them. Packets may be built from several map update threads at once. */
+    class UpdateCompressor
+    {
+    public:
+        UpdateCompressor() : _initialized(false), _level(0) { }
+        ~UpdateCompressor()
+        {
+            if (_initialized)
+                deflateEnd(&_stream);
+        }
+
+        z_stream* Acquire(int level)
+        {
+            if (_initialized && _level != level)
+            {
+                deflateEnd(&_stream);
+                _initialized = false;
+            }
+
+            if (!_initialized)
+            {
+                _stream.zalloc = (alloc_func)nullptr;
+                _stream.zfree = (free_func)nullptr;
+                _stream.opaque = (voidpf)nullptr;
+
+                int z_res = deflateInit(&_stream, level);
+                if (z_res != Z_OK)
+                {
+                    TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                    return nullptr;
+                }
+                _initialized = true;
+                _level = level;
+            }
+            else
+            {
+                int z_res = deflateReset(&_stream);
+                if (z_res != Z_OK)
+                {
+                    TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
+                    deflateEnd(&_stream);
+                    _initialized = false;
+                    return nullptr;
+                }
+            }
+
+            return &_stream;
+        }
+
+    private:
+        z_stream _stream;
+        bool _initialized;
+        int _level;
+    };
+
+    thread_local UpdateCompressor updateCompressor;
+    // header part of the packet being built (block count, out of range guids), reused between packets
+    thread_local ByteBuffer updateHeader;
+}
 
+void UpdateData::Compress(void* dst, uint32 *dst_size, ByteBuffer const& header, ByteBuffer const& data)
+{
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld->getConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
+    z_stream* c_stream = updateCompressor.Acquire(sWorld->getConfig(CONFIG_COMPRESSION));
+    if (!c_stream)
     {
-        TC_LOG_ERROR("misc","Can't compress update packet (zlib: deflateInit) Error code: %i (%s)",z_res,zError(z_res));
         *dst_size = 0;
         return;
     }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
+
+    // feed header then data, no need to concatenate them first
+    c_stream->next_in = (Bytef*)header.contents();
+    c_stream->avail_in = (uInt)header.wpos();
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
+    int z_res = deflate(c_stream, Z_NO_FLUSH);
     if (z_res != Z_OK)
     {
         TC_LOG_ERROR("misc","Can't compress update packet (zlib: deflate) Error code: %i (%s)",z_res,zError(z_res));
@@ -56,14 +114,17 @@ void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
         return;
     }
 
-    if (c_stream.avail_in != 0)
+    if (c_stream->avail_in != 0)
     {
         TC_LOG_ERROR("misc","Can't compress update packet (zlib: deflate not greedy)");
         *dst_size = 0;
         return;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    c_stream->next_in = (Bytef*)data.contents();
+    c_stream->avail_in = (uInt)data.wpos();
+
+    z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         TC_LOG_ERROR("misc","Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)",z_res,zError(z_res));
@@ -71,46 +132,37 @@ void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        TC_LOG_ERROR("misc","Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)",z_res,zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    *dst_size = c_stream.total_out;
+    *dst_size = c_stream->total_out;
 }
 
 bool UpdateData::BuildPacket(WorldPacket *packet, bool hasTransport)
 {
-    ByteBuffer buf(m_data.size() + 10 + m_outOfRangeGUIDs.size()*9);
+    ByteBuffer& header = updateHeader;
+    header.clear();
 
-    buf << (uint32) (!m_outOfRangeGUIDs.empty() ? m_blockCount + 1 : m_blockCount);
+    header << (uint32) (!m_outOfRangeGUIDs.empty() ? m_blockCount + 1 : m_blockCount);
 #ifndef LICH_KING
-    buf << (uint8) (hasTransport ? true : false);
+    header << (uint8) (hasTransport ? true : false);
 #endif
 
     if(!m_outOfRangeGUIDs.empty())
     {
-        buf << (uint8) UPDATETYPE_OUT_OF_RANGE_OBJECTS;
-        buf << (uint32) m_outOfRangeGUIDs.size();
+        header << (uint8) UPDATETYPE_OUT_OF_RANGE_OBJECTS;
+        header << (uint32) m_outOfRangeGUIDs.size();
 
         for (auto i : m_outOfRangeGUIDs)
-            buf << PackedGuid(i);
+            header << PackedGuid(i);
     }
 
-    buf.append(m_data);
-
-    size_t pSize = buf.wpos();                              // use real used data size
+    size_t pSize = header.wpos() + m_data.wpos();            // use real used data size
 
     if (m_data.size() > 100 )
     {
         uint32 destsize = compressBound(pSize);
         packet->resize(destsize + sizeof(uint32));
 
-        packet->put(0, (uint32)buf.size());
-        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
+        packet->put(0, (uint32)pSize);
+        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, header, m_data);
         if (destsize == 0)
             return false;
 
@@ -119,7 +171,8 @@ bool UpdateData::BuildPacket(WorldPacket *packet, bool hasTransport)
     }
     else
     {
-        packet->append(buf);
+        packet->append(header);
+        packet->append(m_data);
         packet->SetOpcode( SMSG_UPDATE_OBJECT );
     }
 
@@ -63,7 +63,8 @@ class UpdateData
         GuidSet m_outOfRangeGUIDs;
         ByteBuffer m_data;
 
-        void Compress(void* dst, uint32 *dst_size, void* src, int src_size);
+        // compress header followed by data into dst, using the calling thread compression stream
+        void Compress(void* dst, uint32 *dst_size, ByteBuffer const& header, ByteBuffer const& data);
 };
 #endif
 
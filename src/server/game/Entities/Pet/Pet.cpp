@@ -102,7 +102,10 @@ void Pet::AddToWorld()
     ///- Register the pet for guid lookup
     if(!IsInWorld())
     {   
-        GetMap()->GetObjectsStore().Insert<Pet>(GetGUID(), this);
+        {
+            auto lock = GetMap()->LockForRegionUpdate();
+            GetMap()->GetObjectsStore().Insert<Pet>(GetGUID(), this);
+        }
         Unit::AddToWorld();
         AIM_Initialize();
     }
@@ -124,7 +127,10 @@ void Pet::RemoveFromWorld()
     ///- Remove the pet from the accessor
     if(IsInWorld())
     {
-        GetMap()->GetObjectsStore().Remove<Pet>(GetGUID());
+        {
+            auto lock = GetMap()->LockForRegionUpdate();
+            GetMap()->GetObjectsStore().Remove<Pet>(GetGUID());
+        }
         ///- Don't call the function for Creature, normal mobs + totems go in a different storage
         Unit::RemoveFromWorld();
     }
@@ -1454,6 +1460,7 @@ void Pet::_LoadAuras(uint32 timediff)
 {
     for (auto & m_modAura : m_modAuras)
         m_modAura.clear();
+    m_auraModifierCache.clear();
 
     // all aura related fields
     for(int i = UNIT_FIELD_AURA; i <= UNIT_FIELD_AURASTATE; ++i)
@@ -73,6 +73,7 @@
 #ifdef PLAYERBOT
 #include "PlayerbotAI.h"
 #include "GuildTaskMgr.h"
+#include "RandomPlayerbotMgr.h"
 #endif
 
 #include <cmath>
@@ -164,6 +165,9 @@ static uint32 constexpr copseReclaimDelay[MAX_DEATH_COUNT] = { 30, 60, 120 };
 
 uint32 const MAX_MONEY_AMOUNT = static_cast<uint32>(std::numeric_limits<int32>::max());
 
+std::atomic<uint64> Player::s_saveCount(0);
+std::atomic<uint64> Player::s_saveStatementCount(0);
+
 Player::Player(WorldSession *session) :
     Unit(true),
     m_bHasDelayedTeleport(false),
@@ -287,6 +291,8 @@ Player::Player(WorldSession *session) :
 
     m_mailsLoaded = false;
     m_mailsUpdated = false;
+    m_aurasSaved = false;
+    m_bgDataSaved = false;
     unReadMails = 0;
     m_nextMailDelivereTime = 0;
 
@@ -515,7 +521,7 @@ bool Player::Create(ObjectGuid::LowType guidlow, const std::string& name, uint8
     }
 
     SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, DEFAULT_PLAYER_BOUNDING_RADIUS );
-    SetFloatValue(UNIT_FIELD_COMBATREACH, DEFAULT_PLAYER_COMBAT_REACH );
+    SetCombatReach(DEFAULT_PLAYER_COMBAT_REACH);
 
     switch(gender)
     {
@@ -1459,7 +1465,7 @@ void Player::Update( uint32 p_time )
 
     #ifdef PLAYERBOT
     if (m_playerbotAI)
-       m_playerbotAI->UpdateAI(p_time);
+       sRandomPlayerbotMgr.GetScheduler().UpdateAI(this, m_playerbotAI, p_time);
     if (m_playerbotMgr)
        m_playerbotMgr->UpdateAI(p_time);
     #endif
@@ -6071,6 +6077,11 @@ void Player::SendDirectMessage(WorldPacket *data) const
     GetSession()->SendPacket(data);
 }
 
+void Player::SendDirectMessage(SharedWorldPacket const& data) const
+{
+    GetSession()->SendPacket(data);
+}
+
 void Player::SendCinematicStart(uint32 CinematicSequenceId) const
 {
     WorldPacket data(SMSG_TRIGGER_CINEMATIC, 4);
@@ -14887,7 +14898,7 @@ bool Player::LoadFromDB( uint32 guid, SQLQueryHolder *holder )
     _LoadIntoDataField(fields[LOAD_DATA_KNOWNTITLES].GetString(), PLAYER_FIELD_KNOWN_TITLES, 2);
 
     SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, DEFAULT_PLAYER_BOUNDING_RADIUS);
-    SetFloatValue(UNIT_FIELD_COMBATREACH, 1.5f);
+    SetCombatReach(1.5f);
     //SetFloatValue(UNIT_FIELD_HOVERHEIGHT, 1.0f);
 
     // update money limits
@@ -17049,6 +17060,9 @@ void Player::SaveToDB(bool create /*=false*/)
     m_reputationMgr->SaveToDB(trans);
     GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
 
+    ++s_saveCount;
+    s_saveStatementCount += trans->GetSize();
+
     WorldSession* session = GetSession(); //This player object won't exist anymore when executing the callback, so extract session in a variable to capture
     GetSession()->GetQueryProcessor().AddQuery(CharacterDatabase.CommitTransaction(trans).WithCallback([session, create]() -> void
     {
@@ -17106,10 +17120,7 @@ void Player::_SaveActions(SQLTransaction trans)
 
 void Player::_SaveAuras(SQLTransaction trans)
 {
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
-    stmt->setUInt32(0, GetGUID().GetCounter());
-    trans->Append(stmt);
-
+    SavedAurasMap auras;
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
         if (!itr->second->CanBeSaved())
@@ -17117,52 +17128,123 @@ void Player::_SaveAuras(SQLTransaction trans)
 
         Aura* aura = itr->second;
 
-        int32 damage[MAX_SPELL_EFFECTS];
-        int32 baseDamage[MAX_SPELL_EFFECTS];
+        SavedAuraData data;
         uint8 effMask = 0;
-        uint8 recalculateMask = 0;
+        data.recalculateMask = 0;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
             if (AuraEffect const* effect = aura->GetEffect(i))
             {
-                baseDamage[i] = effect->GetBaseAmount();
-                damage[i] = effect->GetAmount();
+                data.baseDamage[i] = effect->GetBaseAmount();
+                data.damage[i] = effect->GetAmount();
                 effMask |= 1 << i;
                 if (effect->CanBeRecalculated())
-                    recalculateMask |= 1 << i;
+                    data.recalculateMask |= 1 << i;
             }
             else
             {
-                baseDamage[i] = 0;
-                damage[i] = 0;
+                data.baseDamage[i] = 0;
+                data.damage[i] = 0;
             }
         }
 
+        data.stackCount = aura->GetStackAmount();
+        data.maxDuration = aura->GetMaxDuration();
+        data.duration = aura->GetDuration();
+        data.charges = aura->GetCharges();
+        data.critChance = aura->GetCritChance();
+        data.applyResilience = aura->CanApplyResilience();
+        auras[std::make_tuple(aura->GetCasterGUID().GetRawValue(), aura->GetId(), effMask)] = data;
+    }
+
+    PreparedStatement* stmt;
+    auto setAuraData = [](PreparedStatement* stmt, uint8& index, SavedAuraData const& data)
+    {
+        stmt->setUInt8(index++, data.recalculateMask);
+        stmt->setUInt8(index++, data.stackCount);
+        stmt->setInt32(index++, data.damage[0]);
+        stmt->setInt32(index++, data.damage[1]);
+        stmt->setInt32(index++, data.damage[2]);
+        stmt->setInt32(index++, data.baseDamage[0]);
+        stmt->setInt32(index++, data.baseDamage[1]);
+        stmt->setInt32(index++, data.baseDamage[2]);
+        stmt->setInt32(index++, data.maxDuration);
+        stmt->setInt32(index++, data.duration);
+        stmt->setUInt8(index++, data.charges);
+        stmt->setFloat(index++, data.critChance);
+        stmt->setBool(index++, data.applyResilience);
+    };
+
+    if (!m_aurasSaved)
+    {
+        // we don't know what's in DB yet, rewrite everything
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
+        stmt->setUInt32(0, GetGUID().GetCounter());
+        trans->Append(stmt);
+    }
+    else
+    {
+        for (auto const& itr : m_savedAuras)
+        {
+            if (auras.count(itr.first))
+                continue;
+
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA_BY_SPELL);
+            stmt->setUInt32(0, GetGUID().GetCounter());
+            stmt->setUInt64(1, std::get<0>(itr.first));
+            stmt->setUInt32(2, std::get<1>(itr.first));
+            stmt->setUInt8(3, std::get<2>(itr.first));
+            trans->Append(stmt);
+        }
+    }
+
+    for (auto const& itr : auras)
+    {
         uint8 index = 0;
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
-        stmt->setUInt32(index++, GetGUID().GetCounter());
-        stmt->setUInt64(index++, itr->second->GetCasterGUID().GetRawValue());
-        stmt->setUInt32(index++, itr->second->GetId());
-        stmt->setUInt8(index++, effMask);
-        stmt->setUInt8(index++, recalculateMask);
-        stmt->setUInt8(index++, itr->second->GetStackAmount());
-        stmt->setInt32(index++, damage[0]);
-        stmt->setInt32(index++, damage[1]);
-        stmt->setInt32(index++, damage[2]);
-        stmt->setInt32(index++, baseDamage[0]);
-        stmt->setInt32(index++, baseDamage[1]);
-        stmt->setInt32(index++, baseDamage[2]);
-        stmt->setInt32(index++, itr->second->GetMaxDuration());
-        stmt->setInt32(index++, itr->second->GetDuration());
-        stmt->setUInt8(index++, itr->second->GetCharges());
-        stmt->setFloat(index++, itr->second->GetCritChance());
-        stmt->setBool(index++, itr->second->CanApplyResilience());
+        auto saved = m_savedAuras.find(itr.first);
+        if (m_aurasSaved && saved != m_savedAuras.end())
+        {
+            if (saved->second == itr.second)
+                continue;
+
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_CHAR_AURA);
+            setAuraData(stmt, index, itr.second);
+            stmt->setUInt32(index++, GetGUID().GetCounter());
+            stmt->setUInt64(index++, std::get<0>(itr.first));
+            stmt->setUInt32(index++, std::get<1>(itr.first));
+            stmt->setUInt8(index++, std::get<2>(itr.first));
+        }
+        else
+        {
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
+            stmt->setUInt32(index++, GetGUID().GetCounter());
+            stmt->setUInt64(index++, std::get<0>(itr.first));
+            stmt->setUInt32(index++, std::get<1>(itr.first));
+            stmt->setUInt8(index++, std::get<2>(itr.first));
+            setAuraData(stmt, index, itr.second);
+        }
         trans->Append(stmt);
     }
+
+    m_savedAuras = std::move(auras);
+    m_aurasSaved = true;
 }
 
 void Player::_SaveBGData(SQLTransaction& trans)
 {
+    if (m_bgDataSaved
+        && m_savedBGData.bgInstanceID == m_bgData.bgInstanceID
+        && m_savedBGData.bgTeam == m_bgData.bgTeam
+        && m_savedBGData.joinPos.GetMapId() == m_bgData.joinPos.GetMapId()
+        && m_savedBGData.joinPos.GetPositionX() == m_bgData.joinPos.GetPositionX()
+        && m_savedBGData.joinPos.GetPositionY() == m_bgData.joinPos.GetPositionY()
+        && m_savedBGData.joinPos.GetPositionZ() == m_bgData.joinPos.GetPositionZ()
+        && m_savedBGData.joinPos.GetOrientation() == m_bgData.joinPos.GetOrientation()
+        && m_savedBGData.taxiPath[0] == m_bgData.taxiPath[0]
+        && m_savedBGData.taxiPath[1] == m_bgData.taxiPath[1]
+        && m_savedBGData.mountSpell == m_bgData.mountSpell)
+        return; // unchanged since last save
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_BGDATA);
     stmt->setUInt32(0, GetGUID().GetCounter());
     trans->Append(stmt);
@@ -17180,6 +17262,9 @@ void Player::_SaveBGData(SQLTransaction& trans)
     stmt->setUInt16(9, m_bgData.taxiPath[1]);
     stmt->setUInt16(10, m_bgData.mountSpell);
     trans->Append(stmt);
+
+    m_savedBGData = m_bgData;
+    m_bgDataSaved = true;
 }
 
 void Player::_SaveInventory(SQLTransaction trans)
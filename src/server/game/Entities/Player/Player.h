@@ -1102,6 +1102,31 @@ struct BGData
     bool HasTaxiPath() const { return taxiPath[0] && taxiPath[1]; }
 };
 
+// Values of a character_aura row as last written by Player::_SaveAuras
+struct SavedAuraData
+{
+    uint8 recalculateMask;
+    uint8 stackCount;
+    int32 damage[MAX_SPELL_EFFECTS];
+    int32 baseDamage[MAX_SPELL_EFFECTS];
+    int32 maxDuration;
+    int32 duration;
+    uint8 charges;
+    float critChance;
+    bool applyResilience;
+
+    bool operator==(SavedAuraData const& other) const
+    {
+        return recalculateMask == other.recalculateMask && stackCount == other.stackCount
+            && std::equal(std::begin(damage), std::end(damage), std::begin(other.damage))
+            && std::equal(std::begin(baseDamage), std::end(baseDamage), std::begin(other.baseDamage))
+            && maxDuration == other.maxDuration && duration == other.duration && charges == other.charges
+            && critChance == other.critChance && applyResilience == other.applyResilience;
+    }
+};
+
+typedef std::map<std::tuple<uint64 /*casterGuid*/, uint32 /*spellId*/, uint8 /*effMask*/>, SavedAuraData> SavedAurasMap;
+
 struct TradeStatusInfo
 {
     TradeStatusInfo() : Status(TRADE_STATUS_BUSY), TraderGuid(), Result(EQUIP_ERR_OK),
@@ -1563,6 +1588,10 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         bool m_mailsLoaded;
         bool m_mailsUpdated;
 
+        // Number of SaveToDB calls and statements they generated, since server start
+        static uint64 GetSaveCount() { return s_saveCount; }
+        static uint64 GetSaveStatementCount() { return s_saveStatementCount; }
+
         void SetBindPoint(ObjectGuid guid);
         void SendTalentWipeConfirm(ObjectGuid guid);
         void RewardRage( uint32 damage, uint32 weaponSpeedHitFactor, bool attacker );
@@ -2097,6 +2126,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void SendInitWorldStates(uint32 zoneid, uint32 areaid);
         void SendUpdateWorldState(uint32 Field, uint32 Value);
         void SendDirectMessage(WorldPacket *data) const;
+        void SendDirectMessage(SharedWorldPacket const& data) const;
 
         void SendAuraDurationsForTarget(Unit* target);
 
@@ -2437,6 +2467,16 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         BgBattlegroundQueueID_Rec m_bgBattlegroundQueueID[PLAYER_MAX_BATTLEGROUND_QUEUES];
         BGData                    m_bgData;
 
+        // Auras and BG data as last written to DB, so that saves only write what changed.
+        // Not valid until the first save since login, which rewrites everything.
+        SavedAurasMap m_savedAuras;
+        bool m_aurasSaved;
+        BGData m_savedBGData;
+        bool m_bgDataSaved;
+
+        static std::atomic<uint64> s_saveCount;
+        static std::atomic<uint64> s_saveStatementCount;
+
         uint8 m_bgAfkReportedCount;
         time_t m_bgAfkReportedTimer;
         uint32 m_regenTimerCount;
@@ -141,8 +141,9 @@ void MotionTransport::BuildUpdate(UpdateDataMapType& data_map, UpdatePlayerSet&)
     if (players.isEmpty())
         return;
 
+    ValuesUpdateCache valuesCache;
     for (const auto & player : players)
-        BuildFieldsUpdate(player.GetSource(), data_map);
+        BuildFieldsUpdate(player.GetSource(), data_map, valuesCache);
 
     ClearUpdateMask(true);
 }
@@ -903,8 +904,9 @@ void StaticTransport::BuildUpdate(UpdateDataMapType& data_map, UpdatePlayerSet&)
     if (players.isEmpty())
         return;
 
+    ValuesUpdateCache valuesCache;
     for (const auto & player : players)
-        BuildFieldsUpdate(player.GetSource(), data_map);
+        BuildFieldsUpdate(player.GetSource(), data_map, valuesCache);
 
     ClearUpdateMask(true);
 }
@@ -3022,6 +3022,41 @@ uint32 Unit::GetWeaponSkillValue(WeaponAttackType attType, Unit const* target) c
    return value;
 }
 
+bool Unit::IsValuesUpdateShareable(uint8 updateType) const
+{
+    // Keep in sync with BuildValuesUpdate, any field sent with a target specific value prevents sharing. Gamemaster status is already part of the cache key.
+    auto isSent = [&](uint16 index)
+    {
+        return (_fieldNotifyFlags & UnitUpdateFieldFlags[index]) || (updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index] != 0);
+    };
+
+    if (isSent(UNIT_FIELD_AURASTATE) || HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK))
+        return false;
+
+    if (isSent(UNIT_DYNAMIC_FLAGS))
+    {
+        if (m_uint32Values[UNIT_DYNAMIC_FLAGS] & UNIT_DYNFLAG_TRACK_UNIT)
+            return false;
+
+        if (Creature const* creature = ToCreature())
+            if (creature->hasLootRecipient() || (m_uint32Values[UNIT_DYNAMIC_FLAGS] & UNIT_DYNFLAG_LOOTABLE))
+                return false;
+    }
+
+#ifdef LICH_KING
+    if (isSent(UNIT_NPC_FLAGS) && GetTypeId() == TYPEID_UNIT)
+        return false;
+
+    if (isSent(UNIT_FIELD_BYTES_2) && IsControlledByPlayer())
+        return false;
+#endif
+
+    if (isSent(UNIT_FIELD_FACTIONTEMPLATE) && IsControlledByPlayer() && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP))
+        return false;
+
+    return true;
+}
+
 void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const
 {
     if (!target)
@@ -12582,6 +12617,31 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    InvalidateAuraModifierCache(aurEff->GetAuraType());
+}
+
+void Unit::InvalidateAuraModifierCache(AuraType auraType)
+{
+    m_auraModifierCache.erase(std::remove_if(m_auraModifierCache.begin(), m_auraModifierCache.end(), [auraType](AuraModifierCacheEntry const& entry)
+    {
+        return entry.EffectType == auraType;
+    }), m_auraModifierCache.end());
+}
+
+Unit::AuraModifierCacheEntry* Unit::GetAuraModifierCacheEntry(AuraType auraType, AuraModifierCacheType type, uint32 miscMask /*= 0*/) const
+{
+    for (AuraModifierCacheEntry& entry : m_auraModifierCache)
+        if (entry.EffectType == auraType && entry.Type == type && entry.MiscMask == miscMask)
+            return &entry;
+
+    return nullptr;
+}
+
+Unit::AuraModifierCacheEntry& Unit::AddAuraModifierCacheEntry(AuraType auraType, AuraModifierCacheType type, uint32 miscMask /*= 0*/) const
+{
+    m_auraModifierCache.push_back({ auraType, type, miscMask, 0, 1.0f });
+    return m_auraModifierCache.back();
 }
 
 // All aura base removes should go through this function!
@@ -13795,12 +13855,28 @@ int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType, std::function<bool(Aur
 
 int32 Unit::GetTotalAuraModifier(AuraType auraType) const
 {
-    return GetTotalAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    if (m_modAuras[auraType].empty())
+        return 0;
+
+    if (AuraModifierCacheEntry const* entry = GetAuraModifierCacheEntry(auraType, AURA_MODIFIER_CACHE_TOTAL_MODIFIER))
+        return entry->Modifier;
+
+    int32 const modifier = GetTotalAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    AddAuraModifierCacheEntry(auraType, AURA_MODIFIER_CACHE_TOTAL_MODIFIER).Modifier = modifier;
+    return modifier;
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auraType) const
 {
-    return GetTotalAuraMultiplier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    if (m_modAuras[auraType].empty())
+        return 1.0f;
+
+    if (AuraModifierCacheEntry const* entry = GetAuraModifierCacheEntry(auraType, AURA_MODIFIER_CACHE_TOTAL_MULTIPLIER))
+        return entry->Multiplier;
+
+    float const multiplier = GetTotalAuraMultiplier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    AddAuraModifierCacheEntry(auraType, AURA_MODIFIER_CACHE_TOTAL_MULTIPLIER).Multiplier = multiplier;
+    return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auraType) const
@@ -13815,22 +13891,38 @@ int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType) const
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetTotalAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+    if (m_modAuras[auraType].empty())
+        return 0;
+
+    if (AuraModifierCacheEntry const* entry = GetAuraModifierCacheEntry(auraType, AURA_MODIFIER_CACHE_MODIFIER_BY_MISC_MASK, miscMask))
+        return entry->Modifier;
+
+    int32 const modifier = GetTotalAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
     {
         if ((aurEff->GetMiscValue() & miscMask) != 0)
             return true;
         return false;
     });
+    AddAuraModifierCacheEntry(auraType, AURA_MODIFIER_CACHE_MODIFIER_BY_MISC_MASK, miscMask).Modifier = modifier;
+    return modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetTotalAuraMultiplier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+    if (m_modAuras[auraType].empty())
+        return 1.0f;
+
+    if (AuraModifierCacheEntry const* entry = GetAuraModifierCacheEntry(auraType, AURA_MODIFIER_CACHE_MULTIPLIER_BY_MISC_MASK, miscMask))
+        return entry->Multiplier;
+
+    float const multiplier = GetTotalAuraMultiplier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
     {
         if ((aurEff->GetMiscValue() & miscMask) != 0)
             return true;
         return false;
     });
+    AddAuraModifierCacheEntry(auraType, AURA_MODIFIER_CACHE_MULTIPLIER_BY_MISC_MASK, miscMask).Multiplier = multiplier;
+    return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auraType, uint32 miscMask, AuraEffect const* except /*= nullptr*/) const
@@ -1238,6 +1238,7 @@ class TC_GAME_API Unit : public WorldObject
         bool CanDualWield() const { return m_canDualWield; }
         void SetCanDualWield(bool value) { m_canDualWield = value; }
         float GetCombatReach() const override { return m_floatValues[UNIT_FIELD_COMBATREACH]; }
+        void SetCombatReach(float combatReach) { SetFloatValue(UNIT_FIELD_COMBATREACH, combatReach); UpdateGridPosition(); }
         bool IsWithinCombatRange(Unit const* obj, float dist2compare) const;
         bool IsWithinMeleeRange(Unit const* obj) const { return IsWithinMeleeRangeAt(GetPosition(), obj); }
         bool IsWithinMeleeRangeAt(Position const& pos, Unit const* obj) const;
@@ -1709,6 +1710,8 @@ class TC_GAME_API Unit : public WorldObject
         void _UnapplyAura(AuraApplication* aurApp, AuraRemoveMode removeMode);
         void _RemoveNoStackAurasDueToAura(Aura* aura, bool checkStrongerAura = false);
         void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+        // Must be called when an applied aura effect of this type changes amount without being registered again
+        void InvalidateAuraModifierCache(AuraType auraType);
 
         // m_ownedAuras container management
         AuraMap      & GetOwnedAuras() { return m_ownedAuras; }
@@ -2261,6 +2264,7 @@ class TC_GAME_API Unit : public WorldObject
         explicit Unit (bool isWorldObject);
 
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+        bool IsValuesUpdateShareable(uint8 updatetype) const override;
 
         bool _last_in_water_status;
         Position _lastInWaterCheckPosition;
@@ -2299,6 +2303,30 @@ class TC_GAME_API Unit : public WorldObject
         uint32 m_removedAurasCount; //count how much auras were removed (does not reset at each update)
 
         AuraEffectList m_modAuras[TOTAL_AURAS]; //all aura effects applied on this unit
+
+        enum AuraModifierCacheType : uint8
+        {
+            AURA_MODIFIER_CACHE_TOTAL_MODIFIER,
+            AURA_MODIFIER_CACHE_TOTAL_MULTIPLIER,
+            AURA_MODIFIER_CACHE_MODIFIER_BY_MISC_MASK,
+            AURA_MODIFIER_CACHE_MULTIPLIER_BY_MISC_MASK,
+        };
+
+        struct AuraModifierCacheEntry
+        {
+            AuraType EffectType;
+            AuraModifierCacheType Type;
+            uint32 MiscMask;
+            int32 Modifier;
+            float Multiplier;
+        };
+
+        AuraModifierCacheEntry* GetAuraModifierCacheEntry(AuraType auraType, AuraModifierCacheType type, uint32 miscMask = 0) const;
+        AuraModifierCacheEntry& AddAuraModifierCacheEntry(AuraType auraType, AuraModifierCacheType type, uint32 miscMask = 0) const;
+
+        // Results of GetTotalAuraModifier/GetTotalAuraMultiplier and their ByMiscMask variants. Entries of an aura type are dropped
+        // when one of its effects is registered, unregistered or changes amount. Few are in use at once, a linear search is enough.
+        mutable std::vector<AuraModifierCacheEntry> m_auraModifierCache;
         AuraList m_scAuras;                     // casted singlecast auras. List auras casted on other units with the flag SPELL_ATTR5_SINGLE_TARGET_SPELL, such as polymorph
         AuraApplicationList m_interruptableAuras;          // auras on this unit with an AuraInterruptFlags
         AuraApplicationList m_ccAuras; //crowd control aura with a chance of being interrupted by damage
@@ -1246,7 +1246,7 @@ void GameEventMgr::ChangeEquipOrModel(int16 event_id, bool activate)
                             creature->SetDisplayId(itr.second.modelid);
                             creature->SetNativeDisplayId(itr.second.modelid);
                             creature->SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, minfo->bounding_radius);
-                            creature->SetFloatValue(UNIT_FIELD_COMBATREACH, minfo->combat_reach);
+                            creature->SetCombatReach(minfo->combat_reach);
                         }
                     }
                 }
@@ -1261,7 +1261,7 @@ void GameEventMgr::ChangeEquipOrModel(int16 event_id, bool activate)
                             creature->SetDisplayId(itr.second.modelid_prev);
                             creature->SetNativeDisplayId(itr.second.modelid_prev);
                             creature->SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, minfo->bounding_radius);
-                            creature->SetFloatValue(UNIT_FIELD_COMBATREACH, minfo->combat_reach);
+                            creature->SetCombatReach(minfo->combat_reach);
                         }
                     }
                 }
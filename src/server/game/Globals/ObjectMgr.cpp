@@ -1,6 +1,7 @@
 
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/QuerySnapshotCache.h"
 
 #include "Log.h"
 #include "CreatureAIFactory.h"
@@ -217,7 +218,7 @@ void ObjectMgr::LoadCreatureTemplates(bool reload /* = false */)
     uint32 oldMSTime = GetMSTime();
 
     //                                                 
-    QueryResult result = WorldDatabase.Query("SELECT entry, difficulty_entry_1, modelid1, modelid2, modelid3, "
+    QueryResult result = sQuerySnapshotCache->Query(WorldDatabase, "SELECT entry, difficulty_entry_1, modelid1, modelid2, modelid3, "
                                              //   5
                                              "modelid4, name, subname, IconName, gossip_menu_id, minlevel, maxlevel, exp, faction, npcflag, speed_walk, speed_run, "
                                              //
@@ -232,7 +233,8 @@ void ObjectMgr::LoadCreatureTemplates(bool reload /* = false */)
                                              "HealthModifier, ManaModifier, ArmorModifier, DamageModifier, ExperienceModifier, RacialLeader, RegenHealth, "
                                              //   
                                              "mechanic_immune_mask, spell_school_immune_mask, flags_extra, ScriptName, ctm.Ground, ctm.Swim, ctm.Flight, ctm.Rooted "
-                                             "FROM creature_template ct LEFT JOIN creature_template_movement ctm ON ct.entry = ctm.CreatureId");
+                                             "FROM creature_template ct LEFT JOIN creature_template_movement ctm ON ct.entry = ctm.CreatureId",
+                                             { "creature_template", "creature_template_movement" });
 
     if (!result)
     {
@@ -1166,16 +1168,21 @@ void ObjectMgr::LoadCreatures()
     _creatureDataStore.clear();
 
     uint32 count = 0;
+    // Creatures and gameobjects are loaded in parallel, resolve default groups once instead of using operator[] on the shared store
+    // (both are always created by LoadSpawnGroupTemplates)
+    SpawnGroupTemplateData* const defaultGroup = &_spawnGroupDataStore.at(0);
+    SpawnGroupTemplateData* const legacyGroup = &_spawnGroupDataStore.at(1);
+
     //                                                0                1    2          3
-    QueryResult result = WorldDatabase.Query("SELECT creature.spawnID, map, spawnMask, modelid, "
+    QueryResult result = sQuerySnapshotCache->Query(WorldDatabase, "SELECT creature.spawnID, map, spawnMask, modelid, "
     //   4           5           6           7            8              9         10
         "position_x, position_y, position_z, orientation, spawntimesecs, spawndist, currentwaypoint, "
     //   11         12       13            14          15                   16     17       18 
         "curhealth, curmana, MovementType, unit_flags, creature.ScriptName, event, pool_id, pool_entry "
         "FROM creature "
         "LEFT OUTER JOIN game_event_creature ON creature.SpawnID = game_event_creature.guid "
-        "LEFT OUTER JOIN pool_creature ON creature.SpawnID = pool_creature.guid "
-        );
+        "LEFT OUTER JOIN pool_creature ON creature.SpawnID = pool_creature.guid ",
+        { "creature", "game_event_creature", "pool_creature" });
 
     if(!result)
     {
@@ -1183,7 +1190,7 @@ void ObjectMgr::LoadCreatures()
         return;
     }
 
-    QueryResult result2 = WorldDatabase.Query("SELECT spawnID, entry, equipment_id FROM creature_entry");
+    QueryResult result2 = sQuerySnapshotCache->Query(WorldDatabase, "SELECT spawnID, entry, equipment_id FROM creature_entry", { "creature_entry" });
     if (!result2)
     {
         TC_LOG_ERROR("server.loading", ">> Loaded 0 creature entries. DB table `creature_entry` is empty.");
@@ -1266,9 +1273,9 @@ void ObjectMgr::LoadCreatures()
         data.poolId          = fields[17].GetUInt32(); //Old WR pool system
         //sun: use legacy group by default for instances, else it would break a lot of existing scripts. This will be overriden by any entry in spawn_group table.
         if(mapEntry->Instanceable())
-            data.spawnGroupData = &_spawnGroupDataStore[1]; //Legacy group
+            data.spawnGroupData = legacyGroup;
         else
-            data.spawnGroupData = &_spawnGroupDataStore[0]; //Default group
+            data.spawnGroupData = defaultGroup;
 
         uint32 poolId = fields[18].GetUInt32();
 
@@ -1278,7 +1285,7 @@ void ObjectMgr::LoadCreatures()
             if (data.spawnMask & ~spawnMasks[data.spawnPoint.GetMapId()])
                 TC_LOG_ERROR("sql.sql", "Table `creature` has creature (GUID: %u) that have wrong spawn mask %u including unsupported difficulty modes for map (Id: %u).", spawnId, data.spawnMask, data.spawnPoint.GetMapId());
         } else
-            data.spawnGroupData = &_spawnGroupDataStore[1]; // force compatibility group for transport spawns
+            data.spawnGroupData = legacyGroup; // force compatibility group for transport spawns
 
         if (data.displayid != 0)
         {
@@ -1343,6 +1350,7 @@ void ObjectMgr::DeleteCreatureData(ObjectGuid::LowType spawnId)
 
 bool ObjectMgr::AddCreatureToGrid(ObjectGuid::LowType spawnId, CreatureData const* data)
 {
+    std::lock_guard<std::mutex> lock(_mapObjectGuidsLock);
     uint8 mask = data->spawnMask;
     bool inserted = false;
     for(uint8 i = 0; mask != 0; i++, mask >>= 1)
@@ -1365,6 +1373,7 @@ bool ObjectMgr::AddCreatureToGrid(ObjectGuid::LowType spawnId, CreatureData cons
 
 void ObjectMgr::RemoveCreatureFromGrid(ObjectGuid::LowType spawnId, CreatureData const* data)
 {
+    std::lock_guard<std::mutex> lock(_mapObjectGuidsLock);
     uint8 mask = data->spawnMask;
     for(uint8 i = 0; mask != 0; i++, mask >>= 1)
     {
@@ -1382,15 +1391,19 @@ void ObjectMgr::RemoveCreatureFromGrid(ObjectGuid::LowType spawnId, CreatureData
 void ObjectMgr::LoadGameObjects()
 {
     uint32 count = 0;
+    // Creatures and gameobjects are loaded in parallel, resolve default groups once instead of using operator[] on the shared store
+    // (both are always created by LoadSpawnGroupTemplates)
+    SpawnGroupTemplateData* const defaultGroup = &_spawnGroupDataStore.at(0);
+    SpawnGroupTemplateData* const legacyGroup = &_spawnGroupDataStore.at(1);
 
     //                                                0                1   2    3           4           5           6
-    QueryResult result = WorldDatabase.Query("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation,"
+    QueryResult result = sQuerySnapshotCache->Query(WorldDatabase, "SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation,"
     //   7          8          9          10         11             12            13     14         15         16         17
         "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnMask, event, ScriptName, pool_entry "
         "FROM gameobject "
         "LEFT OUTER JOIN game_event_gameobject ON gameobject.guid = game_event_gameobject.guid "
-        "LEFT OUTER JOIN pool_gameobject ON gameobject.guid = pool_gameobject.guid "
-    );
+        "LEFT OUTER JOIN pool_gameobject ON gameobject.guid = pool_gameobject.guid ",
+        { "gameobject", "game_event_gameobject", "pool_gameobject" });
 
     if(!result)
     {
@@ -1452,9 +1465,9 @@ void ObjectMgr::LoadGameObjects()
         data.ScriptId = GetScriptId(fields[16].GetString());
         //sun: use legacy group by default for instances, else it would break a lot of existing scripts. This will be overriden by any entry in spawn_group table.
         if (mapEntry->Instanceable())
-            data.spawnGroupData = &_spawnGroupDataStore[1]; //Legacy group
+            data.spawnGroupData = legacyGroup;
         else
-            data.spawnGroupData = &_spawnGroupDataStore[0]; //Default group
+            data.spawnGroupData = defaultGroup;
         uint32 PoolId = fields[17].GetUInt32();
 
         if (data.spawntimesecs == 0 && gInfo->IsDespawnAtAction())
@@ -1721,6 +1734,7 @@ void ObjectMgr::OnDeleteSpawnData(SpawnData const* data)
 bool ObjectMgr::AddGameobjectToGrid(ObjectGuid::LowType spawnId, GameObjectData const* data)
 {
     assert(data);
+    std::lock_guard<std::mutex> lock(_mapObjectGuidsLock);
 
     uint8 mask = data->spawnMask;
     bool inserted = false;
@@ -1744,6 +1758,7 @@ bool ObjectMgr::AddGameobjectToGrid(ObjectGuid::LowType spawnId, GameObjectData
 
 void ObjectMgr::RemoveGameobjectFromGrid(ObjectGuid::LowType spawnId, GameObjectData const* data)
 {
+    std::lock_guard<std::mutex> lock(_mapObjectGuidsLock);
     uint8 mask = data->spawnMask;
     for(uint8 i = 0; mask != 0; i++, mask >>= 1)
     {
@@ -1887,7 +1902,7 @@ void ObjectMgr::LoadItemTemplates()
     uint32 oldMSTime = GetMSTime();
 
     //                                                 0      1       2               3              4        5        6       7       8            9        10        11
-    QueryResult result = WorldDatabase.Query("SELECT entry, class, subclass, SoundOverrideSubclass, name, displayid, Quality, Flags, BuyCount, BuyPrice, SellPrice, InventoryType, "
+    QueryResult result = sQuerySnapshotCache->Query(WorldDatabase, "SELECT entry, class, subclass, SoundOverrideSubclass, name, displayid, Quality, Flags, BuyCount, BuyPrice, SellPrice, InventoryType, "
     //                                              12                                                                                                        19
                                              "AllowableClass, AllowableRace, ItemLevel, RequiredLevel, RequiredSkill, RequiredSkillRank, requiredspell, requiredhonorrank, "
     //                                              20
@@ -1919,7 +1934,7 @@ void ObjectMgr::LoadItemTemplates()
     //                                            131                   132                 133                134        135
                                              "GemProperties, RequiredDisenchantSkill, ArmorDamageModifier, ScriptName, DisenchantID, "
     //                                           136         137         138         139 
-                                             "FoodType, minMoneyLoot, maxMoneyLoot, Duration FROM item_template");
+                                             "FoodType, minMoneyLoot, maxMoneyLoot, Duration FROM item_template", { "item_template" });
 
     if (!result)
     {
@@ -3202,7 +3217,7 @@ void ObjectMgr::LoadQuests()
     mExclusiveQuestGroups.clear();
 
     //                                               0                     1       2           3             4         5           6     7              8
-    QueryResult result = WorldDatabase.Query("SELECT quest_template.entry, Method, ZoneOrSort, SkillOrClass, MinLevel, QuestLevel, Type, RequiredRaces, RequiredSkillValue,"
+    QueryResult result = sQuerySnapshotCache->Query(WorldDatabase, "SELECT quest_template.entry, Method, ZoneOrSort, SkillOrClass, MinLevel, QuestLevel, Type, RequiredRaces, RequiredSkillValue,"
     //   9                    10                 11                     12                   13                     14                   15                16
         "RepObjectiveFaction, RepObjectiveValue, RequiredMinRepFaction, RequiredMinRepValue, RequiredMaxRepFaction, RequiredMaxRepValue, SuggestedPlayers, LimitTime,"
     //   17          18            19           20           21           22              23                24         25            26
@@ -3219,8 +3234,8 @@ void ObjectMgr::LoadQuests()
         "RewRepFaction1, RewRepFaction2, RewRepFaction3, RewRepFaction4, RewRepFaction5, RewRepValue1, RewRepValue2, RewRepValue3, RewRepValue4, RewRepValue5,"
         "RewHonorableKills, RewOrReqMoney, RewMoneyMaxLevel, RewSpell, RewSpellCast, RewMailTemplateId, RewMailDelaySecs, PointMapId, PointX, PointY, PointOpt,"
         "StartScript, CompleteScript"
-        " FROM quest_template "
-    );
+        " FROM quest_template ",
+        { "quest_template" });
 
     if(result == nullptr)
     {
@@ -8005,8 +8020,8 @@ void ObjectMgr::LoadSpellTemplates()
 
     std::string request = select_fields_str + std::string(" FROM spell_template ORDER BY entry");
     std::string request_override = select_fields_str + std::string(", customAttributesFlags FROM spell_template_override ORDER BY entry");
-    QueryResult result = WorldDatabase.Query(request.c_str());
-    QueryResult result_override = WorldDatabase.Query(request_override.c_str());
+    QueryResult result = sQuerySnapshotCache->Query(WorldDatabase, request.c_str(), { "spell_template" });
+    QueryResult result_override = sQuerySnapshotCache->Query(WorldDatabase, request_override.c_str(), { "spell_template_override" });
     if (!result) 
     {
         TC_LOG_ERROR("server.loading", "Table spell_template loading failed");
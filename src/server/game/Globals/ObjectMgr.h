@@ -18,6 +18,7 @@
 #include <string>
 #include <map>
 #include <limits>
+#include <mutex>
 #include <unordered_map>
 
 class Group;
@@ -1253,6 +1254,7 @@ class TC_GAME_API ObjectMgr
         HalfNameMap PetHalfName1;
 
         MapObjectGuids _mapObjectGuidsStore;
+        std::mutex _mapObjectGuidsLock; // creatures and gameobjects spawns may be loaded concurrently
         CreatureDataContainer _creatureDataStore;
         CreatureLocaleContainer _creatureLocaleStore;
         GameObjectDataContainer _gameObjectDataStore;
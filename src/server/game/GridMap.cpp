@@ -6,6 +6,8 @@
 #include "DBCStores.h"
 #include "Management/VMapFactory.h"
 #include "Management/MMapManager.h"
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 
 u_map_magic MapMagic        = { {'M','A','P','S'} };
 u_map_magic MapVersionMagic = { {'v','1','.','8'} };
@@ -51,142 +53,218 @@ GridMap::~GridMap()
     unloadData();
 }
 
-bool GridMap::loadData(char* filename)
+std::string GridMap::GetFileName(uint32 mapId, uint32 gx, uint32 gy)
+{
+    return Trinity::StringFormat("%smaps/%03u%02u%02u.map", sWorld->GetDataPath().c_str(), mapId, gx, gy);
+}
+
+bool GridMap::loadData(char const* filename)
 {
     // Unload old data if exist
     unloadData();
 
-    map_fileheader header;
+    if (sWorld->getBoolConfig(CONFIG_GRIDMAP_MMAP))
+    {
+        // Not return error if file not found
+        if (!boost::filesystem::exists(filename))
+            return true;
+
+        try
+        {
+            _mappedFile = std::make_unique<boost::iostreams::mapped_file_source>(filename);
+        }
+        catch (std::exception const& e)
+        {
+            TC_LOG_ERROR("maps", "Could not map file '%s' (%s)", filename, e.what());
+            _mappedFile.reset();
+            return false;
+        }
+
+        if (!loadFileData(reinterpret_cast<uint8 const*>(_mappedFile->data()), _mappedFile->size(), filename))
+        {
+            unloadData();
+            return false;
+        }
+        return true;
+    }
+
     // Not return error if file not found
     FILE* in = fopen(filename, "rb");
     if (!in)
         return true;
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    // read the whole file at once, arrays are copied from it
+    fseek(in, 0, SEEK_END);
+    long const fileSize = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    std::vector<uint8> fileData(fileSize > 0 ? size_t(fileSize) : 0);
+    bool const readOk = fileSize > 0 && fread(fileData.data(), 1, fileData.size(), in) == fileData.size();
+    fclose(in);
+
+    if (!readOk || !loadFileData(fileData.data(), fileData.size(), filename))
     {
-        fclose(in);
+        unloadData();
         return false;
     }
+    return true;
+}
+
+bool GridMap::loadFileData(uint8 const* data, size_t size, char const* filename)
+{
+    map_fileheader header;
+    if (size < sizeof(header))
+        return false;
+
+    memcpy(&header, data, sizeof(header));
 
     if (header.mapMagic.asUInt == MapMagic.asUInt && header.versionMagic.asUInt == MapVersionMagic.asUInt)
     {
         // load up area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header.areaMapOffset && !loadAreaData(data, size, header.areaMapOffset))
         {
             TC_LOG_ERROR("maps", "Error loading map area data\n");
-            fclose(in);
             return false;
         }
         // load up height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+        if (header.heightMapOffset && !loadHeightData(data, size, header.heightMapOffset))
         {
             TC_LOG_ERROR("maps", "Error loading map height data\n");
-            fclose(in);
             return false;
         }
         // load up liquid data
-        if (header.liquidMapOffset && !loadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header.liquidMapOffset && !loadLiquidData(data, size, header.liquidMapOffset))
         {
             TC_LOG_ERROR("maps", "Error loading map liquids data\n");
-            fclose(in);
             return false;
         }
         // loadup holes data (if any. check header.holesOffset)
-        if (header.holesSize && !loadHolesData(in, header.holesOffset, header.holesSize))
+        if (header.holesSize && !loadHolesData(data, size, header.holesOffset))
         {
             TC_LOG_ERROR("maps", "Error loading map holes data\n");
-        fclose(in);
             return false;
         }
-        fclose(in);
         return true;
     }
 
     TC_LOG_ERROR("maps", "Map file '%s' is from an incompatible map version (%.*s %.*s), %.*s %.*s is expected. Please recreate using the mapextractor.",
         filename, 4, header.mapMagic.asChar, 4, header.versionMagic.asChar, 4, MapMagic.asChar, 4, MapVersionMagic.asChar);
-    fclose(in);
     return false;
 }
 
+template<class T>
+bool GridMap::loadArray(T*& array, uint8 const* data, size_t size, size_t offset, size_t count)
+{
+    if (offset + count * sizeof(T) > size)
+        return false;
+
+    uint8 const* src = data + offset;
+    if (_mappedFile && reinterpret_cast<uintptr_t>(src) % alignof(T) == 0)
+    {
+        // mapping is read only, arrays are never written to
+        array = reinterpret_cast<T*>(const_cast<uint8*>(src));
+        return true;
+    }
+
+    array = new T[count];
+    memcpy(array, src, count * sizeof(T));
+    return true;
+}
+
+template<class T>
+void GridMap::unloadArray(T*& array)
+{
+    uint8 const* ptr = reinterpret_cast<uint8 const*>(array);
+    bool const mapped = _mappedFile && ptr >= reinterpret_cast<uint8 const*>(_mappedFile->data())
+        && ptr < reinterpret_cast<uint8 const*>(_mappedFile->data()) + _mappedFile->size();
+    if (!mapped)
+        delete[] array;
+    array = nullptr;
+}
+
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
-    delete[] _holes;
-    delete[] _minHeight;
-    delete[] _maxHeight;
-    _areaMap = nullptr;
-    m_V9 = nullptr;
-    m_V8 = nullptr;
-    _maxHeight = nullptr;
-    _minHeight = nullptr;
-    _liquidEntry = nullptr;
-    _liquidFlags = nullptr;
-    _liquidMap  = nullptr;
-    _holes = nullptr;
+    unloadArray(_areaMap);
+    unloadArray(m_V9);
+    unloadArray(m_V8);
+    unloadArray(_liquidEntry);
+    unloadArray(_liquidFlags);
+    unloadArray(_liquidMap);
+    unloadArray(_holes);
+    unloadArray(_minHeight);
+    unloadArray(_maxHeight);
+    _mappedFile.reset();
     _gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+void GridMap::prefault() const
+{
+    if (!_mappedFile)
+        return;
+
+    char const* data = _mappedFile->data();
+    size_t const size = _mappedFile->size();
+    volatile char sink = 0;
+    for (size_t i = 0; i < size; i += 4096)
+        sink += data[i];
+    (void)sink;
+}
+
+bool GridMap::loadAreaData(uint8 const* data, size_t size, uint32 offset)
 {
     map_areaHeader header;
-    fseek(in, offset, SEEK_SET);
+    if (offset + sizeof(header) > size)
+        return false;
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapAreaMagic.asUInt)
+    memcpy(&header, data + offset, sizeof(header));
+    if (header.fourcc != MapAreaMagic.asUInt)
         return false;
 
     _gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
-    {
-        _areaMap = new uint16 [16*16];
-        if (fread(_areaMap, sizeof(uint16), 16*16, in) != 16*16)
+        if (!loadArray(_areaMap, data, size, offset + sizeof(header), 16*16))
             return false;
-    }
+
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(uint8 const* data, size_t size, uint32 offset)
 {
     map_heightHeader header;
-    fseek(in, offset, SEEK_SET);
+    if (offset + sizeof(header) > size)
+        return false;
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapHeightMagic.asUInt)
+    memcpy(&header, data + offset, sizeof(header));
+    if (header.fourcc != MapHeightMagic.asUInt)
         return false;
 
+    size_t pos = offset + sizeof(header);
     _gridHeight = header.gridHeight;
     if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129*129];
-            m_uint16_V8 = new uint16 [128*128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129*129, in) != 129*129 ||
-                fread(m_uint16_V8, sizeof(uint16), 128*128, in) != 128*128)
+            if (!loadArray(m_uint16_V9, data, size, pos, 129*129) ||
+                !loadArray(m_uint16_V8, data, size, pos + 129*129 * sizeof(uint16), 128*128))
                 return false;
+            pos += (129*129 + 128*128) * sizeof(uint16);
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             _gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129*129];
-            m_uint8_V8 = new uint8 [128*128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129*129, in) != 129*129 ||
-                fread(m_uint8_V8, sizeof(uint8), 128*128, in) != 128*128)
+            if (!loadArray(m_uint8_V9, data, size, pos, 129*129) ||
+                !loadArray(m_uint8_V8, data, size, pos + 129*129 * sizeof(uint8), 128*128))
                 return false;
+            pos += (129*129 + 128*128) * sizeof(uint8);
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             _gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129*129];
-            m_V8 = new float [128*128];
-            if (fread(m_V9, sizeof(float), 129*129, in) != 129*129 ||
-                fread(m_V8, sizeof(float), 128*128, in) != 128*128)
+            if (!loadArray(m_V9, data, size, pos, 129*129) ||
+                !loadArray(m_V8, data, size, pos + 129*129 * sizeof(float), 128*128))
                 return false;
+            pos += (129*129 + 128*128) * sizeof(float);
             _gridGetHeight = &GridMap::getHeightFromFloat;
         }
     }
@@ -196,22 +274,22 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (header.flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
     {
-        _maxHeight = new int16[3 * 3];
-        _minHeight = new int16[3 * 3];
-        if (fread(_maxHeight, sizeof(int16), 3 * 3, in) != 3 * 3 ||
-            fread(_minHeight, sizeof(int16), 3 * 3, in) != 3 * 3)
+        if (!loadArray(_maxHeight, data, size, pos, 3 * 3) ||
+            !loadArray(_minHeight, data, size, pos + 3 * 3 * sizeof(int16), 3 * 3))
             return false;
     }
 
     return true;
 }
 
-bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadLiquidData(uint8 const* data, size_t size, uint32 offset)
 {
     map_liquidHeader header;
-    fseek(in, offset, SEEK_SET);
+    if (offset + sizeof(header) > size)
+        return false;
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapLiquidMagic.asUInt)
+    memcpy(&header, data + offset, sizeof(header));
+    if (header.fourcc != MapLiquidMagic.asUInt)
         return false;
 
     _liquidType   = header.liquidType;
@@ -221,35 +299,28 @@ bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
     _liquidHeight = header.height;
     _liquidLevel  = header.liquidLevel;
 
+    size_t pos = offset + sizeof(header);
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        _liquidEntry = new uint16[16*16];
-        if (fread(_liquidEntry, sizeof(uint16), 16*16, in) != 16*16)
+        if (!loadArray(_liquidEntry, data, size, pos, 16*16))
             return false;
+        pos += 16*16 * sizeof(uint16);
 
-        _liquidFlags = new uint8[16*16];
-        if (fread(_liquidFlags, sizeof(uint8), 16*16, in) != 16*16)
+        if (!loadArray(_liquidFlags, data, size, pos, 16*16))
             return false;
+        pos += 16*16 * sizeof(uint8);
     }
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        _liquidMap = new float[uint32(_liquidWidth) * uint32(_liquidHeight)];
-        if (fread(_liquidMap, sizeof(float), _liquidWidth*_liquidHeight, in) != (uint32(_liquidWidth) * uint32(_liquidHeight)))
+        if (!loadArray(_liquidMap, data, size, pos, uint32(_liquidWidth) * uint32(_liquidHeight)))
             return false;
     }
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 size)
+bool GridMap::loadHolesData(uint8 const* data, size_t size, uint32 offset)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
-        return false;
-
-    _holes = new uint16[16 * 16];
-    if (fread(_holes, sizeof(uint16), 16 * 16, in) != 16 * 16)
-        return false;
-
-    return true;
+    return loadArray(_holes, data, size, offset, 16 * 16);
 }
 
 uint16 GridMap::getArea(float x, float y) const
@@ -695,7 +766,7 @@ ZLiquidStatus GridMap::GetLiquidStatus(float x, float y, float z, uint8 ReqLiqui
 
 bool GridMap::ExistMap(uint32 mapid, int gx, int gy)
 {
-    std::string fileName = Trinity::StringFormat("%smaps/%03u%02u%02u.map", sWorld->GetDataPath().c_str(), mapid, gx, gy);
+    std::string fileName = GetFileName(mapid, gx, gy);
 
     bool ret = false;
     FILE* pf = fopen(fileName.c_str(), "rb");
@@ -4,7 +4,15 @@
 #include "Define.h"
 #include "GridDefines.h"
 #include "WaterDefines.h"
+#include <memory>
 
+namespace boost
+{
+    namespace iostreams
+    {
+        class mapped_file_source;
+    }
+}
 
 // ******************************************
 // Map file format defines
@@ -96,10 +104,18 @@ class TC_GAME_API GridMap
 
     uint16* _holes;
 
-    bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-    bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-    bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
-    bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+    // Set when map file is memory mapped (see CONFIG_GRIDMAP_MMAP), data arrays then point directly into the mapping when possible
+    std::unique_ptr<boost::iostreams::mapped_file_source> _mappedFile;
+
+    bool loadFileData(uint8 const* data, size_t size, char const* filename);
+    bool loadAreaData(uint8 const* data, size_t size, uint32 offset);
+    bool loadHeightData(uint8 const* data, size_t size, uint32 offset);
+    bool loadLiquidData(uint8 const* data, size_t size, uint32 offset);
+    bool loadHolesData(uint8 const* data, size_t size, uint32 offset);
+    // Point array to count elements at offset in data if data is mapped and suitably aligned, else copy them in a new array
+    template<class T> bool loadArray(T*& array, uint8 const* data, size_t size, size_t offset, size_t count);
+    // Delete array, unless it points into the mapped file
+    template<class T> void unloadArray(T*& array);
     bool isHole(int row, int col) const;
 
     // Get height functions and pointers. walkableOnly NYI
@@ -113,8 +129,12 @@ class TC_GAME_API GridMap
 public:
     GridMap();
     ~GridMap();
-    bool loadData(char* filaname);
+    bool loadData(char const* filename);
     void unloadData();
+    // Read whole mapped file once so that it is paged in, does nothing if file isn't mapped
+    void prefault() const;
+
+    static std::string GetFileName(uint32 mapId, uint32 gx, uint32 gy);
 
     uint16 getArea(float x, float y) const;
     inline float getHeight(float x, float y, bool walkableOnly = false) const {return (this->*_gridGetHeight)(x, y, walkableOnly);}
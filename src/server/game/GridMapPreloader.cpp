@@ -0,0 +1,137 @@
+#include "GridMapPreloader.h"
+#include "GridMap.h"
+#include "Log.h"
+
+#include <algorithm>
+
+// max number of preloaded grid maps waiting to be taken, oldest ones are dropped first
+#define MAX_PRELOADED_GRID_MAPS 128
+
+GridMapPreloader::~GridMapPreloader()
+{
+    Stop();
+}
+
+void GridMapPreloader::Start()
+{
+    if (IsRunning())
+        return;
+
+    _stop = false;
+    _thread = std::thread(&GridMapPreloader::WorkerThread, this);
+    TC_LOG_INFO("maps", "GridMapPreloader: started");
+}
+
+void GridMapPreloader::Stop()
+{
+    if (!IsRunning())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _stop = true;
+    }
+    _condition.notify_all();
+    _thread.join();
+
+    for (auto& itr : _loaded)
+        delete itr.second;
+
+    _loaded.clear();
+    _loadedOrder.clear();
+    _pending.clear();
+    _requested.clear();
+}
+
+void GridMapPreloader::Request(uint32 mapId, uint32 gx, uint32 gy)
+{
+    if (!IsRunning())
+        return;
+
+    uint32 const key = MakeKey(mapId, gx, gy);
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_requested.count(key) || _loaded.count(key))
+            return;
+
+        _requested.insert(key);
+        _pending.push_back(key);
+    }
+    _condition.notify_all();
+}
+
+GridMap* GridMapPreloader::Take(uint32 mapId, uint32 gx, uint32 gy)
+{
+    if (!IsRunning())
+        return nullptr;
+
+    uint32 const key = MakeKey(mapId, gx, gy);
+    std::unique_lock<std::mutex> lock(_lock);
+
+    // being loaded right now, better wait for it than loading it a second time
+    _condition.wait(lock, [this, key] { return !_loading || _loadingKey != key; });
+
+    // still pending: the caller will load it itself, make sure the worker skips it
+    _requested.erase(key);
+
+    auto itr = _loaded.find(key);
+    if (itr == _loaded.end())
+        return nullptr;
+
+    GridMap* gridMap = itr->second;
+    _loaded.erase(itr);
+    _loadedOrder.erase(std::find(_loadedOrder.begin(), _loadedOrder.end(), key));
+    return gridMap;
+}
+
+void GridMapPreloader::WorkerThread()
+{
+    while (true)
+    {
+        uint32 key;
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _condition.wait(lock, [this] { return _stop || !_pending.empty(); });
+            if (_stop)
+                return;
+
+            key = _pending.front();
+            _pending.pop_front();
+            if (!_requested.count(key))
+                continue; // already taken
+
+            _loadingKey = key;
+            _loading = true;
+        }
+
+        std::string const fileName = GridMap::GetFileName(key >> 12, (key >> 6) & 0x3F, key & 0x3F);
+        GridMap* gridMap = new GridMap();
+        if (gridMap->loadData(fileName.c_str()))
+            gridMap->prefault();
+        else
+        {
+            // let the map load it itself and log the error
+            delete gridMap;
+            gridMap = nullptr;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _loading = false;
+            _requested.erase(key);
+            if (gridMap)
+            {
+                _loaded[key] = gridMap;
+                _loadedOrder.push_back(key);
+                while (_loaded.size() > MAX_PRELOADED_GRID_MAPS)
+                {
+                    auto itr = _loaded.find(_loadedOrder.front());
+                    delete itr->second;
+                    _loaded.erase(itr);
+                    _loadedOrder.pop_front();
+                }
+            }
+        }
+        _condition.notify_all();
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef TRINITY_GRIDMAPPRELOADER_H
+#define TRINITY_GRIDMAPPRELOADER_H
+
+#include "Define.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+class GridMap;
+
+/**
+Load GridMaps on a background thread, so that creating a grid doesn't have to wait for disk reads.
+Base maps request the grids around each grid they create, Map::LoadMap then takes the preloaded GridMap if there is one.
+See CONFIG_GRIDMAP_PRELOAD.
+*/
+class TC_GAME_API GridMapPreloader
+{
+public:
+    static GridMapPreloader* instance()
+    {
+        static GridMapPreloader instance;
+        return &instance;
+    }
+
+    void Start();
+    void Stop();
+    bool IsRunning() const { return _thread.joinable(); }
+
+    // Queue loading of given grid map. Does nothing if it's already queued or loaded.
+    void Request(uint32 mapId, uint32 gx, uint32 gy);
+    // Take preloaded grid map, caller gets ownership. Wait for it if it's currently being loaded, return nullptr if loading has not started.
+    GridMap* Take(uint32 mapId, uint32 gx, uint32 gy);
+
+private:
+    GridMapPreloader() : _loadingKey(0), _loading(false), _stop(false) { }
+    ~GridMapPreloader();
+
+    static uint32 MakeKey(uint32 mapId, uint32 gx, uint32 gy) { return (mapId << 12) | (gx << 6) | gy; }
+
+    void WorkerThread();
+
+    std::thread _thread;
+    std::mutex _lock;
+    // notified when a request is pushed or a grid map finished loading
+    std::condition_variable _condition;
+    // keys waiting to be loaded. A key may be removed from _requested while still in this queue, it is then skipped.
+    std::deque<uint32> _pending;
+    std::unordered_set<uint32> _requested;
+    // loaded grid maps not taken yet, oldest first in _loadedOrder
+    std::unordered_map<uint32, GridMap*> _loaded;
+    std::deque<uint32> _loadedOrder;
+    uint32 _loadingKey;
+    bool _loading;
+    bool _stop;
+};
+
+#define sGridMapPreloader GridMapPreloader::instance()
+
+#endif // TRINITY_GRIDMAPPRELOADER_H
@@ -14,49 +14,71 @@ using namespace Trinity;
 
 void VisibleNotifier::SendToSelf()
 {
-    // at this moment i_clientGUIDs have guids that not iterate at grid level checks
-    // but exist one case when this possible and object not out of range: transports
-    if (Transport* transport = i_player.GetTransport())
+    // Objects at client which were not visited are out of range. Most of the time every one of them was visited,
+    // which counting is enough to tell.
+    GuidUnorderedSet& clientGUIDs = i_player.m_clientGUIDs;
+    std::size_t const visitedAtClient = std::count_if(i_visited.begin(), i_visited.end(), [&clientGUIDs](ObjectGuid const& guid)
     {
-        for (Transport::PassengerSet::const_iterator itr = transport->GetPassengers().begin(); itr != transport->GetPassengers().end(); ++itr)
+        return clientGUIDs.find(guid) != clientGUIDs.end();
+    });
+
+    if (visitedAtClient != clientGUIDs.size())
+    {
+        std::sort(i_visited.begin(), i_visited.end());
+        auto wasVisited = [this](ObjectGuid const& guid)
         {
-            if (vis_guids.find((*itr)->GetGUID()) != vis_guids.end())
-            {
-                vis_guids.erase((*itr)->GetGUID());
+            return std::binary_search(i_visited.begin(), i_visited.end(), guid);
+        };
 
-                switch ((*itr)->GetTypeId())
+        // exist one case when an object is not visited at grid level and not out of range: transports
+        std::vector<ObjectGuid> passengers;
+        if (Transport* transport = i_player.GetTransport())
+        {
+            for (Transport::PassengerSet::const_iterator itr = transport->GetPassengers().begin(); itr != transport->GetPassengers().end(); ++itr)
+            {
+                if (clientGUIDs.find((*itr)->GetGUID()) != clientGUIDs.end() && !wasVisited((*itr)->GetGUID()))
                 {
-                case TYPEID_GAMEOBJECT:
-                    i_player.UpdateVisibilityOf((*itr)->ToGameObject(), i_data, i_visibleNow);
-                    break;
-                case TYPEID_PLAYER:
-                    i_player.UpdateVisibilityOf((*itr)->ToPlayer(), i_data, i_visibleNow);
-                    if (!(*itr)->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-                        (*itr)->ToPlayer()->UpdateVisibilityOf(&i_player);
-                    break;
-                case TYPEID_UNIT:
-                    i_player.UpdateVisibilityOf((*itr)->ToCreature(), i_data, i_visibleNow);
-                    break;
-                case TYPEID_DYNAMICOBJECT:
-                    i_player.UpdateVisibilityOf((*itr)->ToDynObject(), i_data, i_visibleNow);
-                    break;
-                default:
-                    break;
+                    passengers.push_back((*itr)->GetGUID());
+
+                    switch ((*itr)->GetTypeId())
+                    {
+                    case TYPEID_GAMEOBJECT:
+                        i_player.UpdateVisibilityOf((*itr)->ToGameObject(), i_data, i_visibleNow);
+                        break;
+                    case TYPEID_PLAYER:
+                        i_player.UpdateVisibilityOf((*itr)->ToPlayer(), i_data, i_visibleNow);
+                        if (!(*itr)->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
+                            (*itr)->ToPlayer()->UpdateVisibilityOf(&i_player);
+                        break;
+                    case TYPEID_UNIT:
+                        i_player.UpdateVisibilityOf((*itr)->ToCreature(), i_data, i_visibleNow);
+                        break;
+                    case TYPEID_DYNAMICOBJECT:
+                        i_player.UpdateVisibilityOf((*itr)->ToDynObject(), i_data, i_visibleNow);
+                        break;
+                    default:
+                        break;
+                    }
                 }
             }
         }
-    }
 
-    for (auto it = vis_guids.begin(); it != vis_guids.end(); ++it)
-    {
-        i_player.m_clientGUIDs.erase(*it);
-        i_data.AddOutOfRangeGUID(*it);
+        std::vector<ObjectGuid> outOfRange;
+        for (ObjectGuid const& guid : clientGUIDs)
+            if (!wasVisited(guid) && std::find(passengers.begin(), passengers.end(), guid) == passengers.end())
+                outOfRange.push_back(guid);
 
-        if (it->IsPlayer())
+        for (ObjectGuid const& guid : outOfRange)
         {
-            Player* player = ObjectAccessor::FindPlayer(*it);
-            if (player && !player->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-                player->UpdateVisibilityOf(&i_player);
+            clientGUIDs.erase(guid);
+            i_data.AddOutOfRangeGUID(guid);
+
+            if (guid.IsPlayer())
+            {
+                Player* player = ObjectAccessor::FindPlayer(guid);
+                if (player && !player->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
+                    player->UpdateVisibilityOf(&i_player);
+            }
         }
     }
 
@@ -111,7 +133,7 @@ void PlayerRelocationNotifier::Visit(PlayerMapType &m)
     {
         Player* player = iter->GetSource();
 
-        vis_guids.erase(player->GetGUID());
+        i_visited.push_back(player->GetGUID());
 
         i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
 
@@ -130,7 +152,7 @@ void PlayerRelocationNotifier::Visit(CreatureMapType &m)
     {
         Creature* c = iter->GetSource();
 
-        vis_guids.erase(c->GetGUID());
+        i_visited.push_back(c->GetGUID());
 
         i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
 
@@ -167,52 +189,6 @@ void CreatureRelocationNotifier::Visit(CreatureMapType &m)
     }
 }
 
-void DelayedUnitRelocation::Visit(CreatureMapType &m)
-{
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-    {
-        Creature* unit = iter->GetSource();
-        if (!unit->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-            continue;
-
-        CreatureRelocationNotifier relocate(*unit);
-
-        TypeContainerVisitor<CreatureRelocationNotifier, WorldTypeMapContainer > c2world_relocation(relocate);
-        TypeContainerVisitor<CreatureRelocationNotifier, GridTypeMapContainer >  c2grid_relocation(relocate);
-
-        cell.Visit(p, c2world_relocation, i_map, *unit, i_radius);
-        cell.Visit(p, c2grid_relocation, i_map, *unit, i_radius);
-    }
-}
-
-void DelayedUnitRelocation::Visit(PlayerMapType &m)
-{
-    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-    {
-        Player* player = iter->GetSource();
-        WorldObject const* viewPoint = player->m_seer;
-
-        if (!viewPoint->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-            continue;
-
-        if (player != viewPoint && !viewPoint->IsPositionValid())
-            continue;
-
-        CellCoord pair2(Trinity::ComputeCellCoord(viewPoint->GetPositionX(), viewPoint->GetPositionY()));
-        Cell cell2(pair2);
-        //cell.SetNoCreate(); need load cells around viewPoint or player, that's why its commented
-
-        PlayerRelocationNotifier relocate(*player);
-        TypeContainerVisitor<PlayerRelocationNotifier, WorldTypeMapContainer > c2world_relocation(relocate);
-        TypeContainerVisitor<PlayerRelocationNotifier, GridTypeMapContainer >  c2grid_relocation(relocate);
-
-        cell2.Visit(pair2, c2world_relocation, i_map, *viewPoint, i_radius);
-        cell2.Visit(pair2, c2grid_relocation, i_map, *viewPoint, i_radius);
-
-        relocate.SendToSelf();
-    }
-}
-
 void AIRelocationNotifier::Visit(CreatureMapType &m)
 {
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -21,9 +21,9 @@ namespace Trinity
 		Player &i_player;
 		UpdateData i_data;
 		std::set<Unit*> i_visibleNow;
-		GuidUnorderedSet vis_guids;
+		std::vector<ObjectGuid> i_visited; // compared to the client guids once visiting is done, instead of copying them
 
-		VisibleNotifier(Player &player) : i_player(player), vis_guids(player.m_clientGUIDs) { }
+		VisibleNotifier(Player &player) : i_player(player) { i_visited.reserve(player.m_clientGUIDs.size()); }
 		template<class T> void Visit(GridRefManager<T> &m);
 		void SendToSelf(void);
 	};
@@ -57,19 +57,6 @@ namespace Trinity
 		void Visit(PlayerMapType &);
 	};
 
-	struct TC_GAME_API DelayedUnitRelocation
-	{
-		Map &i_map;
-		Cell &cell;
-		CellCoord &p;
-		const float i_radius;
-		DelayedUnitRelocation(Cell &c, CellCoord &pair, Map &map, float radius) :
-			i_map(map), cell(c), p(pair), i_radius(radius) { }
-		template<class T> void Visit(GridRefManager<T> &) { }
-		void Visit(CreatureMapType &);
-		void Visit(PlayerMapType   &);
-	};
-
 	struct TC_GAME_API AIRelocationNotifier
 	{ 
 		Unit &i_unit;
@@ -102,6 +89,7 @@ namespace Trinity
 	{
 		WorldObject* i_source;
 		WorldPacket const* i_message;
+		SharedWorldPacket i_sharedMessage; // copy of i_message sent to all receivers, made for the first one
 		uint32 i_phaseMask;
 		float i_distSq;
 		Team team;
@@ -129,7 +117,10 @@ namespace Trinity
 			if (!player->HaveAtClient(i_source))
 				return;
 
-			player->GetSession()->SendPacket(i_message);
+			if (!i_sharedMessage)
+				i_sharedMessage = std::make_shared<WorldPacket const>(*i_message);
+
+			player->GetSession()->SendPacket(i_sharedMessage);
 		}
 	};
 
@@ -233,6 +224,40 @@ namespace Trinity
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
     };
 
+    /* Same as WorldObjectListSearcher for checks which only accept objects within a range of a position. Objects of each cell
+    are first filtered by distance in the grid positions index, only the ones in range go through the check.
+    rangeZ is the accepted distance on the z axis, the radius of the objects (combat reach, gameobject model size) is added to
+    both ranges, the check is still the one deciding.
+    Gameobjects are in range when within range of their model box on each axis (GameObject::IsInRange), the corners of the grown
+    box are up to range * sqrt(2) away from the box in 2d and range away on the z axis, ranges are widened to include them. */
+    template<class Check>
+    struct WorldObjectListAreaSearcher : ContainerInserter<WorldObject*>
+    {
+        uint32 i_mapTypeMask;
+        Check& i_check;
+        float i_x, i_y, i_z;
+        float i_range;
+        float i_rangeZ;
+        std::vector<uint32> i_slots;
+
+        template<typename Container>
+        WorldObjectListAreaSearcher(Container& container, Check & check, Position const& center, float range, float rangeZ, uint32 mapTypeMask = GRID_MAP_TYPE_MASK_ALL) :
+            ContainerInserter<WorldObject*>(container), i_mapTypeMask(mapTypeMask), i_check(check),
+            i_x(center.GetPositionX()), i_y(center.GetPositionY()), i_z(center.GetPositionZ()), i_range(range), i_rangeZ(rangeZ) {}
+
+        void Visit(PlayerMapType &m) { VisitInRange(m, GRID_MAP_TYPE_MASK_PLAYER); }
+        void Visit(CreatureMapType &m) { VisitInRange(m, GRID_MAP_TYPE_MASK_CREATURE); }
+        void Visit(CorpseMapType &m) { VisitInRange(m, GRID_MAP_TYPE_MASK_CORPSE); }
+        void Visit(GameObjectMapType &m) { VisitInRange(m, GRID_MAP_TYPE_MASK_GAMEOBJECT, i_range * float(M_SQRT2), std::max(i_range, i_rangeZ)); }
+        void Visit(DynamicObjectMapType &m) { VisitInRange(m, GRID_MAP_TYPE_MASK_DYNAMICOBJECT); }
+
+        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+
+    private:
+        template<class T> void VisitInRange(GridRefManager<T> &m, uint32 typeMask) { VisitInRange(m, typeMask, i_range, i_rangeZ); }
+        template<class T> void VisitInRange(GridRefManager<T> &m, uint32 typeMask, float range, float rangeZ);
+    };
+
     template<class Do>
     struct WorldObjectWorker
     {
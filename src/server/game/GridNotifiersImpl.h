@@ -41,7 +41,7 @@ inline void Trinity::VisibleNotifier::Visit(GridRefManager<T> &m)
 {
 	for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
 	{
-		vis_guids.erase(iter->GetSource()->GetGUID());
+		i_visited.push_back(iter->GetSource()->GetGUID());
 		i_player.UpdateVisibilityOf(iter->GetSource(), i_data, i_visibleNow);
 	}
 }
@@ -286,6 +286,23 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(DynamicObjectMapType &m)
             Insert(itr.GetSource());
 }
 
+template<class Check>
+template<class T>
+void Trinity::WorldObjectListAreaSearcher<Check>::VisitInRange(GridRefManager<T> &m, uint32 typeMask, float range, float rangeZ)
+{
+    if (!(i_mapTypeMask & typeMask))
+        return;
+
+    i_slots.clear();
+    m.GetPositions().Filter(i_x, i_y, i_z, range, rangeZ, i_slots);
+    for (uint32 slot : i_slots)
+    {
+        T* object = m.GetIndexedObject(slot);
+        if (i_check(object))
+            Insert(object);
+    }
+}
+
 // Gameobject searchers
 
 template<class Check>
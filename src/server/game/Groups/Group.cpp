@@ -1839,6 +1839,8 @@ void Group::UpdatePlayerOutOfRange(Player* player)
 
 void Group::BroadcastPacket(WorldPacket *packet, bool ignorePlayersInBGRaid, int group, ObjectGuid ignoredPlayer)
 {
+    // copied once for all members
+    SharedWorldPacket sharedPacket;
     for(GroupReference *itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
         Player* player = itr->GetSource();
@@ -1846,7 +1848,12 @@ void Group::BroadcastPacket(WorldPacket *packet, bool ignorePlayersInBGRaid, int
             continue;
 
         if (player->GetSession() && (group == -1 || itr->getSubGroup() == group))
-            player->SendDirectMessage(packet);
+        {
+            if (!sharedPacket)
+                sharedPacket = std::make_shared<WorldPacket const>(*packet);
+
+            player->SendDirectMessage(sharedPacket);
+        }
     }
 }
 
@@ -5,10 +5,11 @@
 #include "World.h"
 #include "ObjectMgr.h"
 #include "AccountMgr.h"
+#include <chrono>
 
 #define NO_SESSION_STRING "no session"
 
-LogsDatabaseAccessor::LogsDatabaseAccessor() : max_trade_id(0)
+LogsDatabaseAccessor::LogsDatabaseAccessor() : max_trade_id(0), _stopping(false)
 {
     PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_SEL_CHAR_TRADE_MAX_ID);
     if (PreparedQueryResult result = LogsDatabase.Query(stmt))
@@ -18,6 +19,163 @@ LogsDatabaseAccessor::LogsDatabaseAccessor() : max_trade_id(0)
     else {
         TC_LOG_FATAL("misc", "LogsDatabaseAccessor could get max trade id. Starting with trade id 0 again.");
     }
+
+    if (sWorld->getConfig(CONFIG_DBLOG_BUFFER))
+    {
+        // Own connection, so that long flushes don't hold one of the synchronous connections of the pool
+        _flushConnection = LogsDatabase.OpenDedicatedConnection();
+        if (_flushConnection)
+            _flushThread = std::thread(&LogsDatabaseAccessor::FlushThread, this);
+        else
+            TC_LOG_ERROR("misc", "LogsDatabaseAccessor could not open its flush connection, logs are not buffered.");
+    }
+}
+
+LogsDatabaseAccessor::~LogsDatabaseAccessor()
+{
+    StopBuffer();
+}
+
+void LogsDatabaseAccessor::StopBuffer()
+{
+    {
+        std::lock_guard<std::mutex> lock(_bufferLock);
+        if (!_flushThread.joinable())
+            return;
+
+        _stopping = true;
+    }
+
+    _bufferCondition.notify_one();
+    _flushThread.join();
+    _flushConnection.reset();
+}
+
+void LogsDatabaseAccessor::Write(PreparedStatement* stmt, bool droppable /*= false*/)
+{
+    {
+        std::lock_guard<std::mutex> lock(_bufferLock);
+        if (_flushThread.joinable() && !_stopping)
+        {
+            if (_buffer.size() < sWorld->getConfig(CONFIG_DBLOG_BUFFER_MAX_SIZE))
+            {
+                _buffer.push_back(stmt);
+                ++_bufferStats.buffered;
+                if (_buffer.size() == sWorld->getConfig(CONFIG_DBLOG_BUFFER_FLUSH_SIZE))
+                    _bufferCondition.notify_one();
+
+                return;
+            }
+
+            // Flush thread can't keep up
+            if (droppable)
+            {
+                ++_bufferStats.dropped;
+                delete stmt;
+                return;
+            }
+
+            ++_bufferStats.overflowed;
+        }
+    }
+
+    LogsDatabase.Execute(stmt);
+}
+
+void LogsDatabaseAccessor::FlushThread()
+{
+    std::vector<PreparedStatement*> statements;
+    bool stopping = false;
+    while (!stopping)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_bufferLock);
+            _bufferCondition.wait_for(lock, std::chrono::milliseconds(sWorld->getConfig(CONFIG_DBLOG_BUFFER_FLUSH_INTERVAL)), [this]
+            {
+                return _stopping || _buffer.size() >= sWorld->getConfig(CONFIG_DBLOG_BUFFER_FLUSH_SIZE);
+            });
+
+            stopping = _stopping;
+            statements.swap(_buffer);
+        }
+
+        if (statements.empty())
+            continue;
+
+        // Synchronous commit on this thread, so that the buffer fills up (instead of the async queue) if the database is slow
+        uint32 uncertain = 0;
+        uint32 const failed = FlushStatements(statements, uncertain);
+        if (failed)
+            TC_LOG_ERROR("misc", "LogsDatabaseAccessor: %u of %u buffered log statements could not be written.", failed, uint32(statements.size()));
+        if (uncertain)
+            TC_LOG_ERROR("misc", "LogsDatabaseAccessor: connection lost while committing %u buffered log statements, they may not have been written.", uncertain);
+
+        {
+            std::lock_guard<std::mutex> lock(_bufferLock);
+            _bufferStats.flushed += statements.size() - failed - uncertain;
+            _bufferStats.failed += failed;
+            _bufferStats.uncertain += uncertain;
+            ++_bufferStats.flushes;
+        }
+
+        for (PreparedStatement* stmt : statements)
+            delete stmt;
+
+        statements.clear();
+    }
+}
+
+uint32 LogsDatabaseAccessor::FlushStatements(std::vector<PreparedStatement*> const& statements, uint32& uncertain)
+{
+    LogsDatabaseConnection& connection = *_flushConnection;
+    uncertain = 0;
+    uint32 const reconnectCount = connection.GetReconnectCount();
+    auto connectionLost = [&connection, reconnectCount]() { return connection.GetReconnectCount() != reconnectCount; };
+
+    // A statement (or START TRANSACTION) failing because the connection was lost must not be executed again by itself on the
+    // new connection, it would run outside of the transaction or open one that is never committed
+    connection.SetRetryAfterReconnect(false);
+
+    connection.BeginTransaction();
+    bool writeAll = connectionLost();
+    for (size_t i = 0; i < statements.size() && !writeAll; ++i)
+        if (!connection.Execute(statements[i]) || connectionLost())
+            writeAll = true;
+
+    if (!writeAll)
+    {
+        bool const committed = connection.Execute("COMMIT");
+
+        // Don't write them twice, the server may have committed them before the connection was lost
+        if (connectionLost())
+            uncertain = uint32(statements.size());
+        else if (!committed)
+            writeAll = true;
+    }
+
+    connection.SetRetryAfterReconnect(true);
+
+    if (!writeAll)
+        return 0;
+
+    // A statement failed and aborted the transaction, or the transaction was lost with the connection
+    if (!connectionLost())
+        connection.RollbackTransaction();
+
+    uint32 failed = 0;
+    for (PreparedStatement* stmt : statements)
+        if (!connection.Execute(stmt))
+            ++failed;
+
+    return failed;
+}
+
+LogsDatabaseAccessor::BufferStats LogsDatabaseAccessor::GetBufferStats()
+{
+    std::lock_guard<std::mutex> lock(_bufferLock);
+    BufferStats stats = _bufferStats;
+    stats.pending = _buffer.size();
+    return stats;
 }
 
 bool LogsDatabaseAccessor::ShouldLog(WorldConfigs configIndex, WorldConfigs configIndexGM, bool gmInvolved)
@@ -46,7 +204,7 @@ void LogsDatabaseAccessor::Enchantment(Player const* caster, Player const* targe
     stmt->setString(6, caster->GetSession()->GetRemoteAddress());
     stmt->setString(7, targetPlayer->GetSession()->GetRemoteAddress());
     stmt->setBool(8, gmInvolved);
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 void LogsDatabaseAccessor::BattlegroundStats(uint32 mapId, time_t start, time_t end, Team winner, uint32 scoreAlliance, uint32 scoreHorde)
@@ -75,7 +233,7 @@ void LogsDatabaseAccessor::BattlegroundStats(uint32 mapId, time_t start, time_t
     stmt->setUInt32(5, scoreHorde);
     //+ also log brackets? GetUniqueBracketId()
 
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 void LogsDatabaseAccessor::BossDown(Creature const* victim, std::string const& bossName, std::string const& bossNameFr, uint32 downByGuildId, std::string const& guildName, uint32 guildPercentage, uint32 leaderGuid)
@@ -94,7 +252,7 @@ void LogsDatabaseAccessor::BossDown(Creature const* victim, std::string const& b
     stmt->setUInt32(5, guildPercentage);
     stmt->setUInt32(6, leaderGuid);
 
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 void LogsDatabaseAccessor::CharacterDelete(WorldSession const* session, ObjectGuid::LowType playerGUID, std::string const& charName, uint8 /* level */, std::string const& IP)
@@ -113,7 +271,7 @@ void LogsDatabaseAccessor::CharacterDelete(WorldSession const* session, ObjectGu
     stmt->setString(3, IP);
     stmt->setBool(4, gmInvolved);
 
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 void LogsDatabaseAccessor::CharacterRename(WorldSession const* session, ObjectGuid::LowType playerGUID, std::string const& oldName, std::string const& newName, std::string const& IP)
@@ -131,7 +289,7 @@ void LogsDatabaseAccessor::CharacterRename(WorldSession const* session, ObjectGu
     stmt->setString(3, newName);
     stmt->setString(4, IP);
     stmt->setBool(5, gmInvolved);
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 void LogsDatabaseAccessor::GMCommand(WorldSession const* m_session, Unit const* target, std::string const& fullcmd)
@@ -202,7 +360,7 @@ void LogsDatabaseAccessor::GMCommand(WorldSession const* m_session, Unit const*
     stmt->setFloat(15, (player && player->GetSelectedUnit()) ? player->GetSelectedUnit()->GetPositionZ() : 0);
     stmt->setString(16, fullcmd);
     stmt->setString(17, m_session ? m_session->GetRemoteAddress() : NO_SESSION_STRING);
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 void LogsDatabaseAccessor::CharacterChat(ChatMsg type, Language lang, Player const* player, Player const* toPlayer, uint32 logChannelId, std::string const& to, std::string const& msg)
@@ -232,7 +390,8 @@ void LogsDatabaseAccessor::CharacterChat(ChatMsg type, Language lang, Player con
     stmt->setString(7, session->GetRemoteAddress());
     stmt->setBool(  8, gmInvolved);
 
-    LogsDatabase.Execute(stmt);
+    // Chat is by far the most frequent log, it's the one to give up when the buffer is full
+    sLogsDatabaseAccessor->Write(stmt, true);
 }
 
 
@@ -254,7 +413,7 @@ void LogsDatabaseAccessor::GuildMoneyTransfer(Player const* player, uint32 guild
     stmt->setString(4, player->GetSession()->GetRemoteAddress());
     stmt->setBool(5, gmInvolved);
 
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 
@@ -278,7 +437,7 @@ void LogsDatabaseAccessor::GuildBankItemTransfer(Player const* player, bool depo
     stmt->setString(7, player->GetSession()->GetRemoteAddress());
     stmt->setBool(8, gmInvolved);
 
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 void LogsDatabaseAccessor::CharacterItemDelete(Player const* player, Item const* item)
@@ -298,7 +457,7 @@ void LogsDatabaseAccessor::CharacterItemDelete(Player const* player, Item const*
     stmt->setString(4, player->GetSession()->GetRemoteAddress());
     stmt->setBool(5, gmInvolved);
 
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 void LogsDatabaseAccessor::Sanction(WorldSession const* authorSession, uint32 targetAccount, ObjectGuid::LowType targetGUID, SanctionType type, uint32 durationSecs, std::string const& reason)
@@ -326,7 +485,7 @@ void LogsDatabaseAccessor::Sanction(WorldSession const* authorSession, uint32 ta
     stmt->setString(7, reason);
     stmt->setString(8, authorSession ? authorSession->GetRemoteAddress() : NO_SESSION_STRING);
 
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 void LogsDatabaseAccessor::RemoveSanction(WorldSession const* authorSession, uint32 targetAccount, ObjectGuid::LowType targetGUID, std::string const& targetIP, SanctionType type)
@@ -345,7 +504,7 @@ void LogsDatabaseAccessor::RemoveSanction(WorldSession const* authorSession, uin
     stmt->setUInt8(5, uint8(type));
     stmt->setString(6, authorSession ? authorSession->GetRemoteAddress() : NO_SESSION_STRING);
 
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 void LogsDatabaseAccessor::Mail(uint32 mailId, MailMessageType type, uint32 sender_guidlow_or_entry, uint32 receiver_guidlow, std::string const subject, std::string const body, MailDraft::MailItemMap const& items, uint32 money, uint32 cod)
@@ -372,8 +531,6 @@ void LogsDatabaseAccessor::Mail(uint32 mailId, MailMessageType type, uint32 send
     
     //## Insert into database
 
-    SQLTransaction trans = LogsDatabase.BeginTransaction();
-
     //PrepareStatement(LOGS_INS_CHAR_MAIL, "INSERT INTO mail (id, type, sender_account, sender_guid_or_entry, receiver_guid, subject, message, money, time, IP, gm_involved) VALUES (?,?,?,?,?,?,?,?,UNIX_TIMESTAMP(),?,?)", CONNECTION_ASYNC)
     PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_MAIL);
     stmt->setUInt32(0, mailId);
@@ -387,7 +544,7 @@ void LogsDatabaseAccessor::Mail(uint32 mailId, MailMessageType type, uint32 send
     stmt->setUInt32(8, cod);
     stmt->setString(9, IP);
     stmt->setBool(9, gmInvolved);
-    trans->Append(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 
     uint32 mail_itemId = 0;
     for (auto itr : items)
@@ -399,10 +556,8 @@ void LogsDatabaseAccessor::Mail(uint32 mailId, MailMessageType type, uint32 send
         stmt->setUInt32(2, itr.second->GetGUID().GetCounter());
         stmt->setUInt32(3, itr.second->GetEntry());
         stmt->setUInt16(4, itr.second->GetCount());
-        trans->Append(stmt);
+        sLogsDatabaseAccessor->Write(stmt);
     }
-
-    LogsDatabase.CommitTransaction(trans);
 }
 
 void LogsDatabaseAccessor::CharacterTrade(Player const* p1, Player const* p2, std::vector<Item*> const& p1Items, std::vector<Item*> const& p2Items, uint32 p1Gold, uint32 p2Gold)
@@ -414,8 +569,6 @@ void LogsDatabaseAccessor::CharacterTrade(Player const* p1, Player const* p2, st
     if (!ShouldLog(CONFIG_LOG_CHAR_ITEM_TRADE, CONFIG_GM_LOG_CHAR_ITEM_TRADE, gmInvolved))
         return;
 
-    SQLTransaction trans = LogsDatabase.BeginTransaction();
-
     //PrepareStatement(LOGS_INS_CHAR_TRADE, "INSERT INTO char_trade (id, player1_account, player2_account, player1_guid, player2_guid, money1, money2, player1_IP, player2_IP, time, gm_involved) VALUES (?,?,?,?,?,?,?,UNIX_TIMESTAMP(),?)", CONNECTION_ASYNC);
     PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_TRADE);
     stmt->setUInt32(0, max_trade_id);
@@ -428,7 +581,7 @@ void LogsDatabaseAccessor::CharacterTrade(Player const* p1, Player const* p2, st
     stmt->setString(7, p1->GetSession()->GetRemoteAddress());
     stmt->setString(8, p2->GetSession()->GetRemoteAddress());
     stmt->setBool(9, gmInvolved);
-    trans->Append(stmt);
+    Write(stmt);
 
     auto logItemTrade = [&](Item* item, bool p1top2)
     { 
@@ -444,7 +597,7 @@ void LogsDatabaseAccessor::CharacterTrade(Player const* p1, Player const* p2, st
         stmt->setUInt32(3, item->GetEntry());
         stmt->setUInt8(4, item->GetCount());
 
-        trans->Append(stmt);
+        Write(stmt);
     };
 
     for (auto itr : p1Items)
@@ -452,8 +605,6 @@ void LogsDatabaseAccessor::CharacterTrade(Player const* p1, Player const* p2, st
 
     for (auto itr : p2Items)
         logItemTrade(itr, false);
-
-    LogsDatabase.CommitTransaction(trans);
 }
 
 void LogsDatabaseAccessor::CleanupOldMonitorLogs()
@@ -497,7 +648,7 @@ void LogsDatabaseAccessor::WonAuction(uint32 bidderAccount, ObjectGuid::LowType
     stmt->setUInt16(6, itemCount);
     stmt->setBool(7, gmInvolved);
 
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 void LogsDatabaseAccessor::CreateAuction(Player const* player, ObjectGuid::LowType itemGUID, uint32 itemEntry, uint32 itemCount)
@@ -521,7 +672,7 @@ void LogsDatabaseAccessor::CreateAuction(Player const* player, ObjectGuid::LowTy
     stmt->setString(5, session->GetRemoteAddress());
     stmt->setBool(6, gmInvolved);
 
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 void LogsDatabaseAccessor::BuyOrSellItemToVendor(BuyTransactionType type, Player const* player, Item const* item, Unit const* vendor)
@@ -555,7 +706,7 @@ void LogsDatabaseAccessor::BuyOrSellItemToVendor(BuyTransactionType type, Player
     stmt->setString(6, player->GetSession()->GetRemoteAddress());
     stmt->setBool(7, gmInvolved);
 
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
 
 void LogsDatabaseAccessor::CleanupOldLogs()
@@ -633,5 +784,5 @@ void LogsDatabaseAccessor::LogConnectionIP(WorldSession const* session)
     stmt->setString(1, session->GetRemoteAddress());
     stmt->setBool(2, gmInvolved);
 
-    LogsDatabase.Execute(stmt);
+    sLogsDatabaseAccessor->Write(stmt);
 }
\ No newline at end of file
@@ -4,8 +4,14 @@
 #include "Define.h"
 #include "SharedDefines.h"
 #include "Mail.h"
+#include "DatabaseEnvFwd.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 class Creature;
+class LogsDatabaseConnection;
 class Player;
 enum MailMessageType : uint32;
 class WorldSession;
@@ -24,6 +30,23 @@ public:
     }
 
     LogsDatabaseAccessor();
+    ~LogsDatabaseAccessor();
+
+    struct BufferStats
+    {
+        uint64 buffered = 0;   // statements added to the buffer
+        uint64 flushed = 0;    // statements written by the flush thread
+        uint64 flushes = 0;    // transactions committed by the flush thread
+        uint64 failed = 0;     // statements the flush thread could not write
+        uint64 uncertain = 0;  // statements being committed when the connection was lost, maybe not written
+        uint64 dropped = 0;    // chat lines discarded because the buffer was full
+        uint64 overflowed = 0; // other statements sent to the async workers because the buffer was full
+        uint32 pending = 0;    // statements currently waiting in the buffer
+    };
+
+    BufferStats GetBufferStats();
+    // Write everything still buffered and stop the flush thread. Logs written after this are executed right away.
+    void StopBuffer();
 
     // Cleanup mon_* table according to config CONFIG_MONITORING_KEEP_DURATION
     static void CleanupOldMonitorLogs();
@@ -64,7 +87,24 @@ public:
 private:
     static bool ShouldLog(WorldConfigs configIndex, WorldConfigs configIndexGM, bool gmInvolved);
 
+    /* Buffer an insert, to be written in bulk by the flush thread (see DBLog.Buffer.* configs). If buffering is disabled, the statement is executed right away.
+    When the buffer is full, droppable statements are discarded and the others are executed right away. */
+    void Write(PreparedStatement* stmt, bool droppable = false);
+    void FlushThread();
+    /* Write statements in a transaction on the flush connection. If a statement fails, they are written one by one so that
+    only the failing ones are lost. Return the number of statements not written, uncertain is set to the number of statements
+    which may or may not have been written because the connection was lost while committing. */
+    uint32 FlushStatements(std::vector<PreparedStatement*> const& statements, uint32& uncertain);
+
     uint32 max_trade_id;
+
+    std::mutex _bufferLock;
+    std::condition_variable _bufferCondition;
+    std::vector<PreparedStatement*> _buffer;
+    std::thread _flushThread;
+    std::unique_ptr<LogsDatabaseConnection> _flushConnection; // owned by the flush thread, not shared with the pool
+    bool _stopping;
+    BufferStats _bufferStats;
 };
 
 #define sLogsDatabaseAccessor LogsDatabaseAccessor::instance()
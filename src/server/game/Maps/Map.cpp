@@ -7,6 +7,7 @@
 #include "CellImpl.h"
 #include "InstanceScript.h"
 #include "Map.h"
+#include "Monitor.h"
 #include "GridNotifiersImpl.h"
 #include "Transport.h"
 #include "ObjectAccessor.h"
@@ -30,6 +31,7 @@
 #include "DynamicTree.h"
 #include "BattleGround.h"
 #include "GridMap.h"
+#include "GridMapPreloader.h"
 #include "ObjectGridLoader.h"
 #include "Pet.h"
 #include "GridStates.h"
@@ -47,6 +49,10 @@
 #include <unordered_set>
 #include <vector>
 
+#ifdef PLAYERBOT
+#include "RandomPlayerbotMgr.h"
+#endif
+
 #define DEFAULT_GRID_EXPIRY     300
 #define MAX_GRID_LOAD_TIME      50
 #define MAX_CREATURE_ATTACK_RADIUS  (45.0f * sWorld->GetRate(RATE_CREATURE_AGGRO))
@@ -80,7 +86,9 @@ Map::~Map()
     if (!m_scriptSchedule.empty())
         sMapMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
-    MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), i_InstanceId);
+#ifdef PLAYERBOT
+    sRandomPlayerbotMgr.GetScheduler().RemoveMapBudget(GetId(), GetInstanceId());
+#endif
 }
 
 void Map::ReloadMMap(int gx, int gy)
@@ -94,12 +102,16 @@ void Map::LoadMMap(int gx, int gy)
     /*if (!DisableMgr::IsPathfindingEnabled(GetId()))
         return;*/
 
-    bool mmapLoadResult = MMAP::MMapFactory::createOrGetMMapManager()->loadMap((sWorld->GetDataPath() + "mmaps").c_str(), GetId(), gx, gy);
-
-    if (mmapLoadResult)
-        TC_LOG_DEBUG("mmaps", "MMAP loaded name:%s, id:%d, x:%d, y:%d (mmap rep.: x:%d, y:%d)", GetMapName(), GetId(), gx, gy, gx, gy);
-    else
-        TC_LOG_ERROR("mmaps", "Could not load MMAP name:%s, id:%d, x:%d, y:%d (mmap rep.: x:%d, y:%d)", GetMapName(), GetId(), gx, gy, gx, gy);
+    // tile is read in background if tile loader is started, callback is then called from ProcessLoadedTiles in this map update
+    uint32 const mapId = GetId();
+    char const* mapName = GetMapName();
+    MMAP::MMapFactory::createOrGetMMapManager()->loadMapAsync(mapId, gx, gy, [mapId, mapName, gx, gy](bool mmapLoadResult)
+    {
+        if (mmapLoadResult)
+            TC_LOG_DEBUG("mmaps", "MMAP loaded name:%s, id:%d, x:%d, y:%d (mmap rep.: x:%d, y:%d)", mapName, mapId, gx, gy, gx, gy);
+        else
+            TC_LOG_ERROR("mmaps", "Could not load MMAP name:%s, id:%d, x:%d, y:%d (mmap rep.: x:%d, y:%d)", mapName, mapId, gx, gy, gx, gy);
+    });
 }
 
 void Map::LoadVMap(int x,int y)
@@ -112,6 +124,7 @@ void Map::LoadVMap(int x,int y)
     {
         case VMAP::VMAP_LOAD_RESULT_OK:
             TC_LOG_DEBUG("maps","VMAP loaded name:%s, id:%d, x:%d, y:%d (vmap rep.: x:%d, y:%d)", GetMapName(), GetId(), x,y, x,y);
+            _collisionCache.InvalidateVMaps();
             break;
         case VMAP::VMAP_LOAD_RESULT_ERROR:
             TC_LOG_DEBUG("maps","Could not load VMAP name:%s, id:%d, x:%d, y:%d (vmap rep.: x:%d, y:%d)", GetMapName(), GetId(), x,y, x,y);
@@ -151,19 +164,23 @@ void Map::LoadMap(int gx, int gy, bool reload)
         GridMaps[gx][gy] = nullptr;
     }
 
-    // map file name
-    char *tmp = nullptr;
-    // Pihhan: dataPath length + "maps/" + 3+2+2+ ".map" length may be > 32 !
-    int len = sWorld->GetDataPath().length()+strlen("maps/%03u%02u%02u.map")+1;
-    tmp = new char[len];
-    snprintf(tmp, len, (char *)(sWorld->GetDataPath() + "maps/%03u%02u%02u.map").c_str(), GetId(), gx, gy);
-    TC_LOG_DEBUG("maps","Loading map %s",tmp);
-    // loading data
-    GridMaps[gx][gy] = new GridMap();
-    if (!GridMaps[gx][gy]->loadData(tmp))
-        TC_LOG_ERROR("maps","ERROR loading map file: \n %s\n", tmp);
+    // take it from preloader if it was loaded in background
+    GridMaps[gx][gy] = sGridMapPreloader->Take(GetId(), gx, gy);
+    if (!GridMaps[gx][gy])
+    {
+        std::string const fileName = GridMap::GetFileName(GetId(), gx, gy);
+        TC_LOG_DEBUG("maps", "Loading map %s", fileName.c_str());
+        // loading data
+        GridMaps[gx][gy] = new GridMap();
+        if (!GridMaps[gx][gy]->loadData(fileName.c_str()))
+            TC_LOG_ERROR("maps", "ERROR loading map file: \n %s\n", fileName.c_str());
+    }
 
-    delete [] tmp;
+    // players are likely to move to surrounding grids next
+    for (int x = std::max(gx - 1, 0); x <= std::min(gx + 1, MAX_NUMBER_OF_GRIDS - 1); ++x)
+        for (int y = std::max(gy - 1, 0); y <= std::min(gy + 1, MAX_NUMBER_OF_GRIDS - 1); ++y)
+            if (!GridMaps[x][y])
+                sGridMapPreloader->Request(GetId(), x, y);
 
     sScriptMgr->OnLoadGridMap(this, GridMaps[gx][gy], gx, gy);
 }
@@ -218,6 +235,14 @@ Map::Map(MapType type, uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnM
 
     Map::InitVisibilityDistance();
 
+    // Instances only cover a small area and can be numerous
+    uint32 collisionCacheSize = sWorld->getIntConfig(CONFIG_VMAP_CACHE_SIZE);
+    if (Instanceable())
+        collisionCacheSize /= 4;
+
+    _collisionCache.Initialize(collisionCacheSize, sWorld->GetRate(RATE_VMAP_CACHE_PRECISION));
+    _recordLineOfSight = sLog->ShouldLog("maps.los", LOG_LEVEL_TRACE);
+
     sScriptMgr->OnCreateMap(this);
 }
 
@@ -533,6 +558,8 @@ bool Map::AddPlayerToMap(Player* player)
     SendZoneDynamicInfo(player);
 
     player->m_clientGUIDs.clear();
+    // notify flags left from another map were not queued in this one
+    player->ResetAllNotifies();
     player->UpdateObjectVisibility(false);
 
     if (player->IsAlive())
@@ -574,6 +601,8 @@ bool Map::AddToMap(T* obj, bool checkTransport)
 {
     static_assert(!std::is_same<Player, T>::value, "Players must use AddPlayerToMap function");
 
+    auto lock = LockForRegionUpdate();
+
     /// @todo Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
     {
@@ -602,6 +631,9 @@ bool Map::AddToMap(T* obj, bool checkTransport)
     AddToGrid(obj, cell);
     //TC_LOG_DEBUG("maps", "Object %s enters grid[%u, %u]", obj->GetGUID().ToString().c_str(), cell.GridX(), cell.GridY());
 
+    // notify flags set before entering this map were not queued, visibility is updated on create below anyway
+    obj->ResetAllNotifies();
+
     //Must already be set before AddToMap. Usually during obj->Create.
     //obj->SetMap(this);
     obj->AddToWorld();
@@ -683,17 +715,11 @@ bool Map::IsGridLoaded(const GridCoord &p) const
     return ( getNGrid(p.x_coord, p.y_coord) && isGridObjectDataLoaded(p.x_coord, p.y_coord));
 }
 
-struct ResetNotifier
+void Map::AddToRelocationNotify(WorldObject* obj)
 {
-    template<class T>inline void resetNotify(GridRefManager<T> &m)
-    {
-        for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
-            iter->GetSource()->ResetAllNotifies();
-    }
-    template<class T> void Visit(GridRefManager<T> &) { }
-    void Visit(CreatureMapType &m) { resetNotify<Creature>(m); }
-    void Visit(PlayerMapType &m) { resetNotify<Player>(m); }
-};
+    auto lock = LockForRegionUpdate();
+    _relocationNotifyQueue.push_back(obj->GetGUID());
+}
 
 void Map::ProcessRelocationNotifies(const uint32 diff)
 {
@@ -705,38 +731,44 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
             continue;
 
         grid->getGridInfoRef()->getRelocationTimer().TUpdate(diff);
-        if (!grid->getGridInfoRef()->getRelocationTimer().TPassed())
-            continue;
+    }
 
-        uint32 gx = grid->getX(), gy = grid->getY();
+    // Only objects flagged with NOTIFY_VISIBILITY_CHANGED are in the queue, the marked cells are no longer scanned for them.
+    // Objects in a grid whose timer has not passed yet or in a cell not marked wait for a later call, as they did when scanning cells.
+    std::vector<ObjectGuid> waiting;
+    std::vector<ObjectGuid> notified;
+    for (std::size_t i = 0; i < _relocationNotifyQueue.size(); ++i) // notifiers may queue more objects
+    {
+        ObjectGuid const guid = _relocationNotifyQueue[i];
+        WorldObject* obj = GetWorldObject(guid);
+        Unit* unit = obj ? obj->ToUnit() : nullptr;
+        if (!unit || !unit->IsInWorld() || !unit->GetNotifyFlags())
+            continue;
 
-        CellCoord cell_min(gx*MAX_NUMBER_OF_CELLS, gy*MAX_NUMBER_OF_CELLS);
-        CellCoord cell_max(cell_min.x_coord + MAX_NUMBER_OF_CELLS, cell_min.y_coord + MAX_NUMBER_OF_CELLS);
+        CellCoord const cellCoord = Trinity::ComputeCellCoord(unit->GetPositionX(), unit->GetPositionY());
+        if (!cellCoord.IsCoordValid())
+            continue;
 
-        for (uint32 x = cell_min.x_coord; x < cell_max.x_coord; ++x)
+        Cell const cell(cellCoord);
+        NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
+        if (!grid || grid->GetGridState() != GRID_STATE_ACTIVE || !grid->getGridInfoRef()->getRelocationTimer().TPassed() || !isCellMarked(cellCoord.GetId()))
         {
-            for (uint32 y = cell_min.y_coord; y < cell_max.y_coord; ++y)
-            {
-                uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                if (!isCellMarked(cell_id))
-                    continue;
-
-                CellCoord pair(x, y);
-                Cell cell(pair);
-                cell.SetNoCreate();
-
-                Trinity::DelayedUnitRelocation cell_relocation(cell, pair, *this, MAX_VISIBILITY_DISTANCE);
-                TypeContainerVisitor<Trinity::DelayedUnitRelocation, GridTypeMapContainer  > grid_object_relocation(cell_relocation);
-                TypeContainerVisitor<Trinity::DelayedUnitRelocation, WorldTypeMapContainer > world_object_relocation(cell_relocation);
-                Visit(cell, grid_object_relocation);
-                Visit(cell, world_object_relocation);
-            }
+            waiting.push_back(guid);
+            continue;
         }
+
+        // flags are reset only once all objects are notified, notifiers skip the objects which will do their own update
+        notified.push_back(guid);
+        if (unit->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
+            ProcessRelocationNotify(unit);
     }
 
-    ResetNotifier reset;
-    TypeContainerVisitor<ResetNotifier, GridTypeMapContainer >  grid_notifier(reset);
-    TypeContainerVisitor<ResetNotifier, WorldTypeMapContainer > world_notifier(reset);
+    _relocationNotifyQueue.swap(waiting);
+
+    for (ObjectGuid const& guid : notified)
+        if (WorldObject* obj = GetWorldObject(guid))
+            obj->ResetAllNotifies();
+
     for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end(); ++i)
     {
         NGridType *grid = i->GetSource();
@@ -748,27 +780,43 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
             continue;
 
         grid->getGridInfoRef()->getRelocationTimer().TReset(diff, m_VisibilityNotifyPeriod);
+    }
+}
 
-        uint32 gx = grid->getX(), gy = grid->getY();
+void Map::ProcessRelocationNotify(Unit* unit)
+{
+    if (Creature* creature = unit->ToCreature())
+    {
+        Trinity::CreatureRelocationNotifier relocate(*creature);
+        Cell::VisitAllObjects(creature, relocate, MAX_VISIBILITY_DISTANCE);
+    }
 
-        CellCoord cell_min(gx*MAX_NUMBER_OF_CELLS, gy*MAX_NUMBER_OF_CELLS);
-        CellCoord cell_max(cell_min.x_coord + MAX_NUMBER_OF_CELLS, cell_min.y_coord + MAX_NUMBER_OF_CELLS);
+    // Players looking through this unit
+    std::vector<Player*> players;
+    if (Player* player = unit->ToPlayer())
+    {
+        if (player->m_seer == player)
+            players.push_back(player);
+    }
 
-        for (uint32 x = cell_min.x_coord; x < cell_max.x_coord; ++x)
-        {
-            for (uint32 y = cell_min.y_coord; y < cell_max.y_coord; ++y)
-            {
-                uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                if (!isCellMarked(cell_id))
-                    continue;
+    // A player can also be a viewpoint for other players (Mind Vision)
+    if (unit->HasSharedVision())
+    {
+        for (Player* player : unit->GetSharedVisionList())
+            if (player->m_seer == unit && player->IsInWorld() && player->GetMap() == this)
+                players.push_back(player);
+    }
 
-                CellCoord pair(x, y);
-                Cell cell(pair);
-                cell.SetNoCreate();
-                Visit(cell, grid_notifier);
-                Visit(cell, world_notifier);
-            }
-        }
+    for (Player* player : players)
+    {
+        WorldObject const* viewPoint = player->m_seer;
+        if (player != viewPoint && !viewPoint->IsPositionValid())
+            continue;
+
+        // need load cells around viewPoint or player
+        Trinity::PlayerRelocationNotifier relocate(*player);
+        Cell::VisitAllObjects(viewPoint, relocate, MAX_VISIBILITY_DISTANCE, false);
+        relocate.SendToSelf();
     }
 }
 
@@ -822,6 +870,8 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
     if (oldZone == newZone)
         return;
 
+    auto lock = LockForRegionUpdate();
+
     if (oldZone != MAP_INVALID_ZONE)
     {
         uint32& oldZoneCount = _zonePlayerCountMap[oldZone];
@@ -837,23 +887,32 @@ void Map::Update(const uint32& t_diff)
     GameMSTime = GetMSTime();
 
     _dynamicTree.update(t_diff);
+
+    // add navmesh tiles read in background since last update (only base maps load them)
+    if (i_InstanceId == 0)
+        MMAP::MMapFactory::createOrGetMMapManager()->processLoadedTiles(GetId());
+
     /// update worldsessions for existing players
-    for(m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* plr = m_mapRefIter->GetSource();
-        if(plr && plr->IsInWorld())
+        MapPhaseTimer phaseTimer(MAP_UPDATE_PHASE_SESSIONS);
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            //plr->Update(t_diff);
-            WorldSession * pSession = plr->GetSession();
-            MapSessionFilter updater(pSession);
+            Player* plr = m_mapRefIter->GetSource();
+            if (plr && plr->IsInWorld())
+            {
+                //plr->Update(t_diff);
+                WorldSession * pSession = plr->GetSession();
+                MapSessionFilter updater(pSession);
 
-            pSession->Update(t_diff, updater);
+                pSession->Update(t_diff, updater);
+            }
         }
     }
 
     /// process any due respawns
     if (_respawnCheckTimer <= t_diff)
     {
+        MapPhaseTimer phaseTimer(MAP_UPDATE_PHASE_RESPAWNS);
         ProcessRespawns();
         _respawnCheckTimer = sWorld->getIntConfig(CONFIG_RESPAWN_MINCHECKINTERVALMS);
     }
@@ -868,6 +927,15 @@ void Map::Update(const uint32& t_diff)
     // for pets
     TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
+    // if enabled, players and their nearby cells are updated per region on several threads,
+    // what's left in the loop below is done afterwards as a serial merge phase
+    bool regionsUpdated;
+    _regionUpdatedPlayers.clear();
+    {
+        MapPhaseTimer phaseTimer(MAP_UPDATE_PHASE_PLAYERS);
+        regionsUpdated = sWorld->IsParallelRegionsUpdateMap(GetId()) && UpdatePlayerRegionsInParallel(t_diff);
+    }
+
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
     for(m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -877,14 +945,24 @@ void Map::Update(const uint32& t_diff)
         if (!player || !player->IsInWorld())
             continue;
 
-        // update players at tick
-        player->Update(t_diff);
+        // players left out of the regions are updated here
+        if (!regionsUpdated || !_regionUpdatedPlayers.count(player))
+        {
+            // update players at tick
+            {
+                MapPhaseTimer phaseTimer(MAP_UPDATE_PHASE_PLAYERS);
+                player->Update(t_diff);
+            }
+
+            MapPhaseTimer phaseTimer(MAP_UPDATE_PHASE_GRID_VISITS);
+            VisitNearbyCellsOf(player, grid_object_update, world_object_update);
 
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+            // If player is using far sight or mind vision, visit that object too
+            if (WorldObject* viewPoint = player->GetViewpoint())
+                VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
+        }
 
-        // If player is using far sight or mind vision, visit that object too
-        if (WorldObject* viewPoint = player->GetViewpoint())
-            VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
+        MapPhaseTimer phaseTimer(MAP_UPDATE_PHASE_GRID_VISITS);
 
         // Handle updates for creatures in combat with player and are more than 60 yards away
         if (player->IsInCombat())
@@ -912,51 +990,271 @@ void Map::Update(const uint32& t_diff)
     }
 
     //must be done before creatures update
-    for (auto itr : CreatureGroupHolder)
-        itr.second->Update(t_diff);
-    
+    {
+        MapPhaseTimer phaseTimer(MAP_UPDATE_PHASE_CREATURE_GROUPS);
+        for (auto itr : CreatureGroupHolder)
+            itr.second->Update(t_diff);
+    }
+
     // non-player active objects, increasing iterator in the loop in case of object removal
-    for (m_activeForcedNonPlayersIter = m_activeForcedNonPlayers.begin(); m_activeForcedNonPlayersIter != m_activeForcedNonPlayers.end();)
     {
-        WorldObject* obj = *m_activeForcedNonPlayersIter;
-        ++m_activeForcedNonPlayersIter;
+        MapPhaseTimer phaseTimer(MAP_UPDATE_PHASE_GRID_VISITS);
+        for (m_activeForcedNonPlayersIter = m_activeForcedNonPlayers.begin(); m_activeForcedNonPlayersIter != m_activeForcedNonPlayers.end();)
+        {
+            WorldObject* obj = *m_activeForcedNonPlayersIter;
+            ++m_activeForcedNonPlayersIter;
 
-        if (!obj || !obj->IsInWorld())
-            continue;
+            if (!obj || !obj->IsInWorld())
+                continue;
 
-        VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+            VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+        }
     }
 
     //update our transports
-    for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
     {
-        MotionTransport* obj = *_transportsUpdateIter; 
-        ++_transportsUpdateIter;
+        MapPhaseTimer phaseTimer(MAP_UPDATE_PHASE_TRANSPORTS);
+        for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
+        {
+            MotionTransport* obj = *_transportsUpdateIter;
+            ++_transportsUpdateIter;
 
-        if (!obj->IsInWorld())
-            continue;
+            if (!obj->IsInWorld())
+                continue;
 
-        DEBUG_ASSERT(obj->GetMap() == this);
-        obj->Update(t_diff);
+            DEBUG_ASSERT(obj->GetMap() == this);
+            obj->Update(t_diff);
+        }
     }
 
-    SendObjectUpdates();
+    {
+        MapPhaseTimer phaseTimer(MAP_UPDATE_PHASE_SEND_OBJECT_UPDATES);
+        SendObjectUpdates();
+    }
 
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
     {
+        MapPhaseTimer phaseTimer(MAP_UPDATE_PHASE_SCRIPTS);
         i_scriptLock = true;
         ScriptsProcess();
         i_scriptLock = false;
     }
 
-    MoveAllCreaturesInMoveList();
-    MoveAllGameObjectsInMoveList();
+    {
+        MapPhaseTimer phaseTimer(MAP_UPDATE_PHASE_RELOCATION_NOTIFIES);
+        MoveAllCreaturesInMoveList();
+        MoveAllGameObjectsInMoveList();
 
-    if (!m_mapRefManager.isEmpty() || !m_activeForcedNonPlayers.empty())
-        ProcessRelocationNotifies(t_diff);
+        if (!m_mapRefManager.isEmpty() || !m_activeForcedNonPlayers.empty())
+            ProcessRelocationNotifies(t_diff);
+    }
 
-    sScriptMgr->OnMapUpdate(this, t_diff);
+    {
+        MapPhaseTimer phaseTimer(MAP_UPDATE_PHASE_SCRIPTS);
+        sScriptMgr->OnMapUpdate(this, t_diff);
+    }
+
+    sMonitor->MapPhasesUpdateEnd(*this);
+    if (_collisionCache.IsEnabled())
+        sMonitor->AddMapCollisionCacheStats(GetId(), _collisionCache.TakeStats());
+}
+
+bool Map::UpdatePlayerRegionsInParallel(uint32 t_diff)
+{
+    MapUpdater* updater = sMapMgr->GetMapUpdater();
+    if (!updater->activated())
+        return false;
+
+    auto gridIdOf = [](CellCoord const& cell) { return (cell.x_coord / MAX_NUMBER_OF_CELLS) * MAX_NUMBER_OF_GRIDS + (cell.y_coord / MAX_NUMBER_OF_CELLS); };
+
+    // players and viewpoints, with the area they activate
+    std::vector<std::pair<Player*, CellArea>> seeds;
+    // grids of objects of this map a player update may modify (group members, combat, auras, controlled units, viewpoint),
+    // they are put in the region of the player
+    std::vector<std::pair<uint32 /*playerGridId*/, uint32 /*linkedGridId*/>> links;
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* player = itr->GetSource();
+        if (!player || !player->IsInWorld() || !player->IsPositionValid())
+            continue; // updated by the serial merge phase
+
+        uint32 const playerGridId = gridIdOf(Trinity::ComputeCellCoord(player->GetPositionX(), player->GetPositionY()));
+        std::vector<uint32> linkedGridIds;
+        bool linksValid = true;
+        auto addLink = [&](WorldObject const* linked)
+        {
+            if (!linked || linked == player || !linked->IsInWorld() || linked->FindMap() != this)
+                return;
+
+            if (!linked->IsPositionValid())
+            {
+                linksValid = false;
+                return;
+            }
+
+            linkedGridIds.push_back(gridIdOf(Trinity::ComputeCellCoord(linked->GetPositionX(), linked->GetPositionY())));
+        };
+
+        if (Group* group = player->GetGroup())
+            for (GroupReference* ref = group->GetFirstMember(); ref != nullptr; ref = ref->next())
+                addLink(ref->GetSource());
+
+        for (auto const& pair : player->GetCombatManager().GetPvECombatRefs())
+            addLink(pair.second->GetOther(player));
+        for (auto const& pair : player->GetCombatManager().GetPvPCombatRefs())
+            addLink(pair.second->GetOther(player));
+
+        for (auto const& pair : player->GetAppliedAuras())
+            addLink(pair.second->GetBase()->GetCaster());
+        for (auto const& pair : player->GetOwnedAuras())
+            for (auto const& application : pair.second->GetApplicationMap())
+                addLink(application.second->GetTarget());
+
+        for (Unit* controlled : player->m_Controlled)
+            addLink(controlled);
+        addLink(player->GetCharmed());
+        addLink(player->GetCharmerOrOwner());
+
+        WorldObject* viewPoint = player->GetViewpoint();
+        addLink(viewPoint);
+
+        if (!linksValid)
+            continue; // updated by the serial merge phase
+
+        seeds.emplace_back(player, Cell::CalculateCellArea(player->GetPositionX(), player->GetPositionY(), player->GetGridActivationRange()));
+        if (viewPoint && viewPoint != player)
+            seeds.emplace_back(nullptr, Cell::CalculateCellArea(viewPoint->GetPositionX(), viewPoint->GetPositionY(), viewPoint->GetGridActivationRange()));
+
+        for (uint32 linkedGridId : linkedGridIds)
+            links.emplace_back(playerGridId, linkedGridId);
+    }
+
+    if (seeds.size() < 2)
+        return false;
+
+    // union find over active grids
+    std::unordered_map<uint32 /*gridId*/, uint32 /*parentGridId*/> parents;
+    auto findRoot = [&parents](uint32 gridId)
+    {
+        while (parents[gridId] != gridId)
+        {
+            parents[gridId] = parents[parents[gridId]];
+            gridId = parents[gridId];
+        }
+        return gridId;
+    };
+    auto unite = [&](uint32 a, uint32 b)
+    {
+        a = findRoot(a);
+        b = findRoot(b);
+        if (a != b)
+            parents[a] = b;
+    };
+    for (auto const& seed : seeds)
+    {
+        uint32 const firstGridId = gridIdOf(seed.second.low_bound);
+        parents.emplace(firstGridId, firstGridId);
+        for (uint32 x = seed.second.low_bound.x_coord / MAX_NUMBER_OF_CELLS; x <= seed.second.high_bound.x_coord / MAX_NUMBER_OF_CELLS; ++x)
+        {
+            for (uint32 y = seed.second.low_bound.y_coord / MAX_NUMBER_OF_CELLS; y <= seed.second.high_bound.y_coord / MAX_NUMBER_OF_CELLS; ++y)
+            {
+                uint32 const gridId = x * MAX_NUMBER_OF_GRIDS + y;
+                parents.emplace(gridId, gridId);
+                unite(firstGridId, gridId);
+            }
+        }
+    }
+
+    for (auto const& link : links)
+    {
+        parents.emplace(link.second, link.second);
+        unite(link.first, link.second);
+    }
+
+    // regions must never touch each other, merge adjacent grids as well
+    std::vector<uint32> activeGrids;
+    activeGrids.reserve(parents.size());
+    for (auto const& itr : parents)
+        activeGrids.push_back(itr.first);
+
+    for (uint32 gridId : activeGrids)
+    {
+        int32 const gx = gridId / MAX_NUMBER_OF_GRIDS;
+        int32 const gy = gridId % MAX_NUMBER_OF_GRIDS;
+        for (int32 x = std::max(gx - 1, 0); x <= std::min(gx + 1, MAX_NUMBER_OF_GRIDS - 1); ++x)
+            for (int32 y = std::max(gy - 1, 0); y <= std::min(gy + 1, MAX_NUMBER_OF_GRIDS - 1); ++y)
+                if (parents.find(x * MAX_NUMBER_OF_GRIDS + y) != parents.end())
+                    unite(gridId, x * MAX_NUMBER_OF_GRIDS + y);
+    }
+
+    struct UpdateRegion
+    {
+        std::vector<Player*> players;
+        std::vector<CellCoord> cells;
+    };
+
+    std::unordered_map<uint32 /*rootGridId*/, uint32 /*region index*/> regionIndexes;
+    for (uint32 gridId : activeGrids)
+        regionIndexes.emplace(findRoot(gridId), uint32(regionIndexes.size()));
+
+    if (regionIndexes.size() < 2)
+        return false; // a single region, nothing to parallelize
+
+    std::vector<UpdateRegion> regions(regionIndexes.size());
+    for (auto const& seed : seeds)
+    {
+        UpdateRegion& region = regions[regionIndexes[findRoot(gridIdOf(seed.second.low_bound))]];
+        if (seed.first)
+        {
+            region.players.push_back(seed.first);
+            _regionUpdatedPlayers.insert(seed.first);
+        }
+
+        // marked cells are those that have been visited, also used by the serial merge phase
+        for (uint32 x = seed.second.low_bound.x_coord; x <= seed.second.high_bound.x_coord; ++x)
+        {
+            for (uint32 y = seed.second.low_bound.y_coord; y <= seed.second.high_bound.y_coord; ++y)
+            {
+                uint32 const cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+                if (isCellMarked(cell_id))
+                    continue;
+
+                markCell(cell_id);
+                region.cells.emplace_back(x, y);
+            }
+        }
+    }
+
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(regions.size());
+    for (UpdateRegion const& region : regions)
+    {
+        tasks.push_back([this, &region, t_diff]()
+        {
+            Trinity::ObjectUpdater updater(t_diff);
+            TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> grid_object_update(updater);
+            TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> world_object_update(updater);
+
+            for (Player* player : region.players)
+                if (player->IsInWorld() && player->FindMap() == this)
+                    player->Update(t_diff);
+
+            for (CellCoord const& coord : region.cells)
+            {
+                Cell cell(coord);
+                cell.SetNoCreate();
+                Visit(cell, grid_object_update);
+                Visit(cell, world_object_update);
+            }
+        });
+    }
+
+    _regionUpdateInProgress = true;
+    updater->run_parallel_tasks(tasks);
+    _regionUpdateInProgress = false;
+
+    return true;
 }
 
 void Map::RemovePlayerFromMap(Player *player, bool remove)
@@ -989,6 +1287,8 @@ void Map::RemovePlayerFromMap(Player *player, bool remove)
 template<class T>
 void Map::RemoveFromMap(T *obj, bool remove)
 {
+    auto lock = LockForRegionUpdate();
+
     bool const inWorld = obj->IsInWorld() && obj->GetTypeId() >= TYPEID_UNIT && obj->GetTypeId() <= TYPEID_GAMEOBJECT;
     obj->RemoveFromWorld();
 
@@ -1197,6 +1497,8 @@ void Map::AddCreatureToMoveList(Creature *c, float x, float y, float z, float an
     if (_creatureToMoveLock) //can this happen?
         return;
 
+    auto lock = LockForRegionUpdate();
+
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _creaturesToMove.push_back(c);
     c->SetNewCellPosition(x, y, z, ang);
@@ -1207,6 +1509,8 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
     if (_creatureToMoveLock) //can this happen?
         return;
 
+    auto lock = LockForRegionUpdate();
+
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_ACTIVE)
         c->_moveState = MAP_OBJECT_CELL_MOVE_INACTIVE;
 }
@@ -1216,6 +1520,8 @@ void Map::AddGameObjectToMoveList(GameObject* go, float x, float y, float z, flo
     if (_gameObjectsToMoveLock) //can this happen?
         return;
 
+    auto lock = LockForRegionUpdate();
+
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _gameObjectsToMove.push_back(go);
     go->SetNewCellPosition(x, y, z, ang);
@@ -1226,6 +1532,8 @@ void Map::RemoveGameObjectFromMoveList(GameObject* go)
     if (_gameObjectsToMoveLock) //can this happen?
         return;
 
+    auto lock = LockForRegionUpdate();
+
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_ACTIVE)
         go->_moveState = MAP_OBJECT_CELL_MOVE_INACTIVE;
 }
@@ -1235,6 +1543,8 @@ void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj, float x, float y, fl
     if (_dynamicObjectsToMoveLock) //can this happen?
         return;
 
+    auto lock = LockForRegionUpdate();
+
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _dynamicObjectsToMove.push_back(dynObj);
     dynObj->SetNewCellPosition(x, y, z, ang);
@@ -1245,6 +1555,8 @@ void Map::RemoveDynamicObjectFromMoveList(DynamicObject* dynObj)
     if (_dynamicObjectsToMoveLock) //can this happen?
         return;
 
+    auto lock = LockForRegionUpdate();
+
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_ACTIVE)
         dynObj->_moveState = MAP_OBJECT_CELL_MOVE_INACTIVE;
 }
@@ -1688,6 +2000,7 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
                 delete GridMaps[gx][gy];
             }
             VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId(), gx, gy);
+            _collisionCache.InvalidateVMaps();
             MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId(), gx, gy);
         }
         else
@@ -1716,7 +2029,7 @@ bool Map::getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float
 bool Map::IsPlayerWalkable(Position pos) const
 {
     MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
-    const dtNavMeshQuery* m_navMeshQuery = mmap->GetNavMeshQuery(GetId(), GetInstanceId());
+    const dtNavMeshQuery* m_navMeshQuery = mmap->GetNavMeshQuery(GetId());
     if (!m_navMeshQuery)
     {
         //  No nav mesh loaded !
@@ -1780,7 +2093,11 @@ float Map::GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, fl
 
 float Map::GetHeight(uint32 phasemask, float x, float y, float z, bool checkVMap /*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/, float collisionHeight, bool walkableOnly /*= false*/) const
 {
-    return std::max<float>(GetHeight(x, y, z, checkVMap, maxSearchDist, collisionHeight, walkableOnly), _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask)); //walkableOnly not implemented in dynamicTree
+    float const dynamicHeight = _collisionCache.GetHeight(true, phasemask, x, y, z, maxSearchDist, [&]()
+    {
+        return _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask);
+    });
+    return std::max<float>(GetHeight(x, y, z, checkVMap, maxSearchDist, collisionHeight, walkableOnly), dynamicHeight); //walkableOnly not implemented in dynamicTree
 }
 
 Transport* Map::GetTransportForPos(uint32 phase, float x, float y, float z, WorldObject* worldobject)
@@ -1835,7 +2152,7 @@ float Map::GetHeight(float x, float y, float z, bool checkVMap, float maxSearchD
     float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;
     VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
     if (vmgr->isHeightCalcEnabled())
-        vmapHeight = vmgr->getHeight(GetId(), x, y, z + collisionHeight, maxSearchDist);   // look from a bit higher pos to find the floor
+        vmapHeight = GetVMapHeight(x, y, z + collisionHeight, maxSearchDist);   // look from a bit higher pos to find the floor
     
     // no valid vmap height found, we're done, return map height
     if(vmapHeight == VMAP_INVALID_HEIGHT_VALUE)
@@ -1872,7 +2189,7 @@ float Map::_GetHeight(float x, float y, float z, bool pUseVmaps, float maxSearch
         VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
         if (vmgr->isHeightCalcEnabled())
         {
-            vmapHeight = vmgr->getHeight(GetId(), x, y, z, maxSearchDist);
+            vmapHeight = GetVMapHeight(x, y, z, maxSearchDist);
         }
         else
             vmapHeight = VMAP_INVALID_HEIGHT_VALUE;
@@ -1929,7 +2246,15 @@ float Map::GetGridMapHeight(float x, float y) const
 
 float Map::GetVMapFloor(float x, float y, float z, float maxSearchDist, float collisionHeight) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->getHeight(GetId(), x, y, z + collisionHeight, maxSearchDist);
+    return GetVMapHeight(x, y, z + collisionHeight, maxSearchDist);
+}
+
+float Map::GetVMapHeight(float x, float y, float z, float maxSearchDist) const
+{
+    return _collisionCache.GetHeight(false, 0, x, y, z, maxSearchDist, [&]()
+    {
+        return VMAP::VMapFactory::createOrGetVMapManager()->getHeight(GetId(), x, y, z, maxSearchDist);
+    });
 }
 
 static inline bool IsInWMOInterior(uint32 mogpFlags)
@@ -2254,15 +2579,66 @@ float Map::GetGameObjectCeil(uint32 phasemask, float x, float y, float z, float
 
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
+    if (_recordLineOfSight)
+        TC_LOG_TRACE("maps.los", "%u %f %f %f %f %f %f", GetId(), x1, y1, z1, x2, y2, z2);
+
     if ((checks & LINEOFSIGHT_CHECK_VMAP)
-        && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags))
+        && !_collisionCache.GetLineOfSight(false, uint32(ignoreFlags), x1, y1, z1, x2, y2, z2, [&]()
+        {
+            return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags);
+        }))
         return false;
     if (/*sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && */(checks & LINEOFSIGHT_CHECK_GOBJECT)
-        && !_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask))
+        && !_collisionCache.GetLineOfSight(true, phasemask, x1, y1, z1, x2, y2, z2, [&]()
+        {
+            return _dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask);
+        }))
         return false;
     return true;
 }
 
+void Map::isInLineOfSight(std::vector<VMAP::LineOfSightQuery>& queries, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    for (VMAP::LineOfSightQuery& query : queries)
+    {
+        if (_recordLineOfSight)
+            TC_LOG_TRACE("maps.los", "%u %f %f %f %f %f %f", GetId(), query.x1, query.y1, query.z1, query.x2, query.y2, query.z2);
+        query.result = true;
+    }
+
+    if (queries.empty())
+        return;
+
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+        _collisionCache.GetLineOfSight(false, uint32(ignoreFlags), queries.data(), uint32(queries.size()), [&](VMAP::LineOfSightQuery* missed, uint32 count)
+        {
+            VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), missed, count, ignoreFlags);
+        });
+
+    if (/*sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && */checks & LINEOFSIGHT_CHECK_GOBJECT)
+    {
+        // Only queries still in line of sight
+        std::vector<VMAP::LineOfSightQuery> dynamicQueries;
+        std::vector<size_t> indexes;
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            if (!queries[i].result)
+                continue;
+
+            dynamicQueries.push_back(queries[i]);
+            indexes.push_back(i);
+        }
+
+        _collisionCache.GetLineOfSight(true, phasemask, dynamicQueries.data(), uint32(dynamicQueries.size()), [&](VMAP::LineOfSightQuery* missed, uint32 count)
+        {
+            _dynamicTree.isInLineOfSight(missed, count, phasemask);
+        });
+
+        for (size_t i = 0; i < dynamicQueries.size(); ++i)
+            queries[indexes[i]].result = dynamicQueries[i].result;
+    }
+}
+
 bool Map::IsInWater(float x, float y, float pZ, LiquidData *data) const
 {
     LiquidData liquid_status;
@@ -2403,6 +2779,9 @@ inline void Map::setNGrid(NGridType *grid, uint32 x, uint32 y)
     i_grids[x][y] = grid;
 }
 
+// below this count, packets are built in map thread
+#define MIN_PLAYERS_FOR_PARALLEL_UPDATE_PACKETS 10
+
 void Map::SendObjectUpdates()
 {
     //build updates for each objects
@@ -2418,13 +2797,43 @@ void Map::SendObjectUpdates()
         obj->BuildUpdate(update_players, player_set);
     }
 
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
+    // building and compressing packets does not touch the map anymore, spread it on map updater threads when there are enough players
+    MapUpdater* updater = sMapMgr->GetMapUpdater();
+    size_t const chunkCount = update_players.size() >= MIN_PLAYERS_FOR_PARALLEL_UPDATE_PACKETS ? std::min(update_players.size() / MIN_PLAYERS_FOR_PARALLEL_UPDATE_PACKETS, updater->workers_count() + 1) : 1;
+    if (chunkCount <= 1)
+    {
+        WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
+        for (auto & update_player : update_players)
+        {
+            update_player.second.BuildPacket(&packet, false);
+            update_player.first->GetSession()->SendPacket(&packet);
+            packet.clear();                                     // clean the string
+        }
+        return;
+    }
+
+    std::vector<UpdateDataMapType::value_type*> updates;
+    updates.reserve(update_players.size());
     for (auto & update_player : update_players)
+        updates.push_back(&update_player);
+
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(chunkCount);
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk)
     {
-        update_player.second.BuildPacket(&packet, false);
-        update_player.first->GetSession()->SendPacket(&packet);
-        packet.clear();                                     // clean the string
+        tasks.push_back([&updates, chunk, chunkCount]()
+        {
+            WorldPacket packet;
+            for (size_t i = chunk; i < updates.size(); i += chunkCount)
+            {
+                updates[i]->second.BuildPacket(&packet, false);
+                updates[i]->first->GetSession()->SendPacket(&packet);
+                packet.clear();
+            }
+        });
     }
+
+    updater->run_parallel_tasks(tasks);
 }
 
 void Map::AddFarSpellCallback(FarSpellCallback&& callback)
@@ -2475,6 +2884,8 @@ void Map::AddObjectToRemoveList(WorldObject *obj)
 {
     assert(obj->GetMapId()==GetId() && obj->GetInstanceId()==GetInstanceId());
 
+    auto lock = LockForRegionUpdate();
+
     obj->CleanupsBeforeDelete(false); 
 
     i_objectsToRemove.insert(obj);
@@ -2485,6 +2896,8 @@ void Map::AddObjectToSwitchList(WorldObject *obj, bool on)
 {
     assert(obj->GetMapId()==GetId() && obj->GetInstanceId()==GetInstanceId());
 
+    auto lock = LockForRegionUpdate();
+
     auto itr = i_objectsToSwitch.find(obj);
     if(itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -2660,26 +3073,31 @@ Player* Map::GetPlayer(ObjectGuid const& guid)
 
 Corpse* Map::GetCorpse(ObjectGuid const& guid)
 {
+    auto lock = LockForRegionUpdate();
     return _objectsStore.Find<Corpse>(guid);
 }
 
 Creature* Map::GetCreature(ObjectGuid guid)
 {
+    auto lock = LockForRegionUpdate();
     return _objectsStore.Find<Creature>(guid);
 }
 
 GameObject* Map::GetGameObject(ObjectGuid const& guid)
 {
+    auto lock = LockForRegionUpdate();
     return _objectsStore.Find<GameObject>(guid);
 }
 
 Pet* Map::GetPet(ObjectGuid const& guid)
 {
+    auto lock = LockForRegionUpdate();
     return _objectsStore.Find<Pet>(guid);
 }
 
 DynamicObject* Map::GetDynamicObject(ObjectGuid const& guid)
 {
+    auto lock = LockForRegionUpdate();
     return _objectsStore.Find<DynamicObject>(guid);
 }
 
@@ -2871,9 +3289,6 @@ InstanceMap::~InstanceMap()
         delete i_data;
         i_data = nullptr;
     }
-    
-    // unload instance specific navigation data
-    MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), GetInstanceId());
 }
 
 float InstanceMap::GetDefaultVisibilityDistance() const
@@ -3648,6 +4063,8 @@ bool Map::IsBattlegroundOrArena() const { return i_mapEntry && i_mapEntry->IsBat
 
 void Map::SaveRespawnTime(SpawnObjectType type, ObjectGuid::LowType spawnId, uint32 entry, time_t respawnTime, uint32 zoneId, uint32 gridId, bool writeDB, bool replace, SQLTransaction dbTrans)
 {
+    auto lock = LockForRegionUpdate();
+
     if (!respawnTime)
     {
         // Delete only
@@ -4159,6 +4576,8 @@ void Map::Respawn(std::vector<RespawnInfo*>& respawnData, bool force, SQLTransac
 
 void Map::AddRespawnInfo(RespawnInfo& info, bool replace)
 {
+    auto lock = LockForRegionUpdate();
+
     if (!info.spawnId)
         return;
 
@@ -4192,6 +4611,8 @@ static void PushRespawnInfoFrom(std::vector<RespawnInfo*>& data, RespawnInfoMap
 }
 void Map::GetRespawnInfo(std::vector<RespawnInfo*>& respawnData, SpawnObjectTypeMask types, uint32 zoneId) const
 {
+    auto lock = LockForRegionUpdate();
+
     if (types & SPAWN_TYPEMASK_CREATURE)
         PushRespawnInfoFrom(respawnData, _creatureRespawnTimesBySpawnId, zoneId);
     if (types & SPAWN_TYPEMASK_GAMEOBJECT)
@@ -4200,6 +4621,8 @@ void Map::GetRespawnInfo(std::vector<RespawnInfo*>& respawnData, SpawnObjectType
 
 RespawnInfo* Map::GetRespawnInfo(SpawnObjectType type, ObjectGuid::LowType spawnId) const
 {
+    auto lock = LockForRegionUpdate();
+
     RespawnInfoMap const& map = GetRespawnMapForType(type);
     auto it = map.find(spawnId);
     if (it == map.end())
@@ -4218,6 +4641,8 @@ void Map::DeleteRespawnInfo() // delete everything
 
 void Map::DeleteRespawnInfo(RespawnInfo* info)
 {
+    auto lock = LockForRegionUpdate();
+
     // Delete from all relevant containers to ensure consistency
     ASSERT(info);
 
@@ -4234,6 +4659,8 @@ void Map::DeleteRespawnInfo(RespawnInfo* info)
 
 void Map::RemoveRespawnTime(RespawnInfo* info, bool doRespawn, SQLTransaction dbTrans)
 {
+    auto lock = LockForRegionUpdate();
+
     PreparedStatement* stmt;
     switch (info->type)
     {
@@ -4322,10 +4749,14 @@ void Map::ApplyDynamicModeRespawnScaling(WorldObject const* obj, ObjectGuid::Low
     if (!data || !data->spawnGroupData || !(data->spawnGroupData->flags & SPAWNGROUP_FLAG_DYNAMIC_SPAWN_RATE))
         return;
 
-    auto it = _zonePlayerCountMap.find(obj->GetZoneId());
-    if (it == _zonePlayerCountMap.end())
-        return;
-    uint32 const playerCount = it->second;
+    uint32 playerCount;
+    {
+        auto lock = LockForRegionUpdate();
+        auto it = _zonePlayerCountMap.find(obj->GetZoneId());
+        if (it == _zonePlayerCountMap.end())
+            return;
+        playerCount = it->second;
+    }
     if (!playerCount)
         return;
     double const adjustFactor = sWorld->getFloatConfig(type == SPAWN_TYPE_GAMEOBJECT ? CONFIG_RESPAWN_DYNAMICRATE_GAMEOBJECT : CONFIG_RESPAWN_DYNAMICRATE_CREATURE) / playerCount;
@@ -4490,6 +4921,7 @@ void Map::RemoveGameObjectModel(GameObjectModel const& model)
 { 
     TC_LOG_TRACE("maps", "Map %u - Removed model %s", GetId(), model.name.c_str());
     _dynamicTree.remove(model); 
+    _collisionCache.InvalidateGameObjectModels();
 }
 
 void Map::InsertGameObjectModel(GameObjectModel const& model) 
@@ -4497,6 +4929,7 @@ void Map::InsertGameObjectModel(GameObjectModel const& model)
     TC_LOG_TRACE("maps", "Map %u - Added model %s", GetId(), model.name.c_str());
     DEBUG_ASSERT(!_dynamicTree.contains(model));
     _dynamicTree.insert(model); 
+    _collisionCache.InvalidateGameObjectModels();
 }
 
 bool Map::ContainsGameObjectModel(GameObjectModel const& model) const 
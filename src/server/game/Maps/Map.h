@@ -10,15 +10,18 @@
 #include "MPSCQueue.h"
 #include "DynamicTree.h"
 #include "Models/GameObjectModel.h"
+#include "MapCollisionCache.h"
 #include <boost/heap/fibonacci_heap.hpp>
 #include "ObjectGuid.h"
 #include "SpawnData.h"
 #include "Transaction.h"
 #include "SharedDefines.h"
 
+#include <atomic>
 #include <bitset>
 #include <list>
 #include <mutex>
+#include <unordered_set>
 
 class Unit;
 class WorldPacket;
@@ -31,7 +34,7 @@ class GridMap;
 class Transport;
 class MotionTransport;
 namespace Trinity { struct ObjectUpdater; }
-namespace VMAP { enum class ModelIgnoreFlags : uint32; }
+namespace VMAP { enum class ModelIgnoreFlags : uint32; struct LineOfSightQuery; }
 struct MapDifficulty;
 struct MapEntry;
 enum Difficulty : uint8;
@@ -241,14 +244,26 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
 		void AddUpdateObject(Object* obj)
 		{
+			auto lock = LockForRegionUpdate();
 			_updateObjects.insert(obj);
 		}
 
 		void RemoveUpdateObject(Object* obj)
 		{
+			auto lock = LockForRegionUpdate();
 			_updateObjects.erase(obj);
 		}
 
+        /* Lock containers shared by the whole map while regions are updated in parallel (see MapUpdate.ParallelRegions.Maps).
+        Returns an empty lock the rest of the time. */
+        std::unique_lock<std::recursive_mutex> LockForRegionUpdate() const
+        {
+            if (!_regionUpdateInProgress)
+                return std::unique_lock<std::recursive_mutex>();
+
+            return std::unique_lock<std::recursive_mutex>(_regionUpdateLock);
+        }
+
         // some calls like isInWater should not use vmaps due to processor power
         // can return INVALID_HEIGHT if under z+2 z coord not found height
         float _GetHeight(float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
@@ -276,6 +291,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void RemoveGameObjectModel(GameObjectModel const& model);
         void InsertGameObjectModel(GameObjectModel const& model);
         bool ContainsGameObjectModel(GameObjectModel const& model) const;
+        // Must be called when a model in this map is changed without being removed and inserted again (enabled, phase...)
+        void GameObjectModelChanged() { _collisionCache.InvalidateGameObjectModels(); }
         float GetGameObjectFloor(uint32 phasemask, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH, float collisionHeight = 0.0f) const
         {
             return _dynamicTree.getHeight(x, y, z, maxSearchDist + collisionHeight, phasemask);
@@ -283,18 +300,24 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         Transport* GetTransportForPos(uint32 phase, float x, float y, float z, WorldObject* worldobject = nullptr);
 
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+        // Set result of each query, rays are intersected by packets with vmaps and gameobject models
+        void isInLineOfSight(std::vector<VMAP::LineOfSightQuery>& queries, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+        // Line of sight checks are only worth checking together in advance if the results are kept until the real checks
+        bool IsCollisionCacheEnabled() const { return _collisionCache.IsEnabled(); }
         void Balance() { _dynamicTree.balance(); }
         //get dynamic collision (gameobjects only ?)
         bool getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist);
 
         time_t GetCreatureRespawnTime(ObjectGuid::LowType dbGuid) const
         {
+            auto lock = LockForRegionUpdate();
             RespawnInfoMap::const_iterator itr = _creatureRespawnTimesBySpawnId.find(dbGuid);
             return itr != _creatureRespawnTimesBySpawnId.end() ? itr->second->respawnTime : 0;
         }
 
         time_t GetGORespawnTime(ObjectGuid::LowType dbGuid) const
         {
+            auto lock = LockForRegionUpdate();
             RespawnInfoMap::const_iterator itr = _gameObjectRespawnTimesBySpawnId.find(dbGuid);
             return itr != _gameObjectRespawnTimesBySpawnId.end() ? itr->second->respawnTime : 0;
         }
@@ -390,6 +413,9 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         bool isCellMarked(uint32 pCellId) { return marked_cells.test(pCellId); }
         void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
 
+        // Called by WorldObject::AddToNotify when an object gets its first notify flag, see ProcessRelocationNotifies
+        void AddToRelocationNotify(WorldObject* obj);
+
 		TempSummon* SummonCreature(uint32 entry, Position const& pos, SummonPropertiesEntry const* properties = nullptr, uint32 duration = 0, Unit* summoner = nullptr, uint32 spellId = 0);
         void SummonCreatureGroup(uint8 group, std::list<TempSummon*>* list = nullptr);
         Player* GetPlayer(ObjectGuid const& guid);
@@ -529,6 +555,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 		inline ObjectGuid::LowType GenerateLowGuid()
 		{
 			static_assert(ObjectGuidTraits<high>::MapSpecific, "Only map specific guid can be generated in Map context");
+			auto lock = LockForRegionUpdate();
 			return GetGuidSequenceGenerator<high>().Generate();
 		}
 
@@ -623,6 +650,11 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint32 m_unloadTimer;
         float m_VisibleDistance;
         DynamicMapTree _dynamicTree;
+        mutable MapCollisionCache _collisionCache;
+        // Log line of sight queries to "maps.los" at trace level, to be replayed by the vmap los benchmark
+        bool _recordLineOfSight;
+        // vmgr->getHeight through _collisionCache
+        float GetVMapHeight(float x, float y, float z, float maxSearchDist) const;
 
         MapRefManager m_mapRefManager;
         MapRefManager::iterator m_mapRefIter;
@@ -655,6 +687,23 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 		//these functions used to process player/mob aggro reactions and
 		//visibility calculations. Highly optimized for massive calculations
 		void ProcessRelocationNotifies(const uint32 diff);
+        void ProcessRelocationNotify(Unit* unit);
+        std::vector<ObjectGuid> _relocationNotifyQueue;     // objects with notify flags, not yet notified
+
+        /* Split players into regions of active grids not adjacent to each other, and update each region (players and
+        their nearby cells) in parallel on the map updater workers. Return false if nothing was done, in which case
+        the regular serial update must be used.
+        A region task may only modify objects of its own region. Objects of this map a player update can reach without
+        being near it (group members, combat references, aura casters and targets, controlled units, viewpoint) are put
+        in the region of the player, players for which one of them has no valid position are left to the serial merge
+        phase. Containers shared by the whole map (object stores, zone player counts, respawn times, forced active objects...)
+        are locked with LockForRegionUpdate, other maps and sessions are
+        reached like from any map update. Path generation relies on navmesh queries being per thread (MMapManager). */
+        bool UpdatePlayerRegionsInParallel(uint32 t_diff);
+        std::unordered_set<Player*> _regionUpdatedPlayers; // players updated by the last UpdatePlayerRegionsInParallel
+        // set while UpdatePlayerRegionsInParallel tasks are running
+        std::atomic<bool> _regionUpdateInProgress{ false };
+        mutable std::recursive_mutex _regionUpdateLock;
 
 		bool i_scriptLock;
         std::set<WorldObject *> i_objectsToRemove;
@@ -687,6 +736,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         }
         void DeleteRespawnInfo(SpawnObjectTypeMask types, uint32 zoneId = 0)
         {
+            auto lock = LockForRegionUpdate();
             std::vector<RespawnInfo*> v;
             GetRespawnInfo(v, types, zoneId);
             if (!v.empty())
@@ -694,6 +744,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         }
         void DeleteRespawnInfo(SpawnObjectType type, ObjectGuid::LowType spawnId)
         {
+            auto lock = LockForRegionUpdate();
             if (RespawnInfo* info = GetRespawnInfo(type, spawnId))
                 DeleteRespawnInfo(info);
         }
@@ -703,6 +754,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         RespawnInfo* GetRespawnInfo(SpawnObjectType type, ObjectGuid::LowType spawnId) const;
         void ForceRespawn(SpawnObjectType type, ObjectGuid::LowType spawnId)
         {
+            auto lock = LockForRegionUpdate();
             if (RespawnInfo* info = GetRespawnInfo(type, spawnId))
                 Respawn(info, true);
         }
@@ -710,6 +762,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void RemoveRespawnTime(std::vector<RespawnInfo*>& respawnData, bool doRespawn = false, SQLTransaction dbTrans = nullptr);
         void RemoveRespawnTime(SpawnObjectTypeMask types = SPAWN_TYPEMASK_ALL, uint32 zoneId = 0, bool doRespawn = false, SQLTransaction dbTrans = nullptr)
         {
+            auto lock = LockForRegionUpdate();
             std::vector<RespawnInfo*> v;
             GetRespawnInfo(v, types, zoneId);
             if (!v.empty())
@@ -717,6 +770,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         }
         void RemoveRespawnTime(SpawnObjectType type, ObjectGuid::LowType spawnId, bool doRespawn = false, SQLTransaction dbTrans = nullptr)
         {
+            auto lock = LockForRegionUpdate();
             if (RespawnInfo* info = GetRespawnInfo(type, spawnId))
                 RemoveRespawnTime(info, doRespawn, dbTrans);
         }
@@ -748,12 +802,14 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         template<class T>
         void AddToForceActiveHelper(T* obj)
         {
+            auto lock = LockForRegionUpdate();
             m_activeForcedNonPlayers.insert(obj);
         }
 
         template<class T>
         void RemoveFromForceActiveHelper(T* obj)
         {
+            auto lock = LockForRegionUpdate();
             // Map::Update for active object in proccess
             if(m_activeForcedNonPlayersIter != m_activeForcedNonPlayers.end())
             {
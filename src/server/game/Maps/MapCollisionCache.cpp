@@ -0,0 +1,131 @@
+#include "MapCollisionCache.h"
+#include <cmath>
+#include <cstring>
+
+MapCollisionCache::MapCollisionCache() :
+    _entryCount(0), _mask(0), _inversePrecision(1.0f), _vmapsGeneration(0), _modelsGeneration(0)
+{
+}
+
+void MapCollisionCache::Initialize(uint32 size, float precision)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    uint32 entryCount = 0;
+    if (size)
+    {
+        entryCount = 1;
+        while (entryCount * 2 <= size)
+            entryCount *= 2;
+    }
+
+    _entries.clear();
+    _entries.shrink_to_fit();
+
+    _entryCount = entryCount;
+    _mask = entryCount ? entryCount - 1 : 0;
+    _inversePrecision = precision > 0.0f ? 1.0f / precision : 1.0f;
+}
+
+bool MapCollisionCache::Key::operator==(Key const& right) const
+{
+    return coords == right.coords && maxSearchDist == right.maxSearchDist && param == right.param && query == right.query && dynamic == right.dynamic;
+}
+
+MapCollisionCache::Key MapCollisionCache::MakeKey(MapCollisionQuery query, bool dynamic, uint32 param, float maxSearchDist, std::array<float, 6> const& coords) const
+{
+    Key key;
+    for (uint8 i = 0; i < coords.size(); ++i)
+        key.coords[i] = int32(std::lround(coords[i] * _inversePrecision));
+
+    key.maxSearchDist = maxSearchDist;
+    key.param = param;
+    key.query = query;
+    key.dynamic = dynamic;
+    return key;
+}
+
+uint32 MapCollisionCache::Hash(Key const& key)
+{
+    // FNV-1a over the fields, not the struct memory which has padding
+    uint32 hash = 2166136261u;
+    auto add = [&hash](uint32 value)
+    {
+        for (uint8 i = 0; i < 4; ++i)
+        {
+            hash = (hash ^ (value & 0xFF)) * 16777619u;
+            value >>= 8;
+        }
+    };
+
+    for (int32 coord : key.coords)
+        add(uint32(coord));
+
+    uint32 maxSearchDist;
+    std::memcpy(&maxSearchDist, &key.maxSearchDist, sizeof(maxSearchDist));
+    add(maxSearchDist);
+    add(key.param);
+    add(uint32(key.query) | (uint32(key.dynamic) << 8));
+    return hash;
+}
+
+bool MapCollisionCache::Find(Key const& key, float& result, uint32& generation)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    generation = GetGeneration(key);
+    if (_entries.empty())
+    {
+        ++_stats.misses[key.query];
+        return false;
+    }
+
+    Entry const& entry = _entries[Hash(key) & _mask];
+    if (entry.used && entry.generation == generation && entry.key == key)
+    {
+        result = entry.result;
+        ++_stats.hits[key.query];
+        return true;
+    }
+
+    ++_stats.misses[key.query];
+    return false;
+}
+
+void MapCollisionCache::Store(Key const& key, float result, uint32 generation)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    if (generation != GetGeneration(key))
+        return;
+
+    if (_entries.empty())
+        _entries.assign(_entryCount, Entry());
+
+    Entry& entry = _entries[Hash(key) & _mask];
+    entry.key = key;
+    entry.generation = generation;
+    entry.result = result;
+    entry.used = true;
+}
+
+void MapCollisionCache::InvalidateVMaps()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    ++_vmapsGeneration;
+}
+
+void MapCollisionCache::InvalidateGameObjectModels()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    ++_modelsGeneration;
+}
+
+MapCollisionCacheStats MapCollisionCache::TakeStats()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    MapCollisionCacheStats stats = _stats;
+    _stats = MapCollisionCacheStats();
+    return stats;
+}
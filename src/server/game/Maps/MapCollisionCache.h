@@ -0,0 +1,164 @@
+#ifndef MAPCOLLISIONCACHE_H
+#define MAPCOLLISIONCACHE_H
+
+#include "Define.h"
+#include <array>
+#include <mutex>
+#include <vector>
+
+enum MapCollisionQuery : uint8
+{
+    MAP_COLLISION_QUERY_LOS,
+    MAP_COLLISION_QUERY_HEIGHT,
+
+    MAP_COLLISION_QUERY_COUNT
+};
+
+struct MapCollisionCacheStats
+{
+    std::array<uint64, MAP_COLLISION_QUERY_COUNT> hits = { };
+    std::array<uint64, MAP_COLLISION_QUERY_COUNT> misses = { };
+};
+
+/* Line of sight and height results of a map, so that positions queried again and again (standing creatures, casts between
+the same units...) do not go through vmaps and gameobject models each time. Coordinates are rounded to the cache precision,
+the first result computed in a rounded position is used for all of it.
+The table has a fixed size, a new result replaces the one which had the same slot. Results from vmaps and from gameobject
+models are invalidated separately: vmaps ones when a vmap tile is loaded or unloaded for the map, models ones whenever a model
+is inserted, removed or enabled/disabled in the map. */
+class TC_GAME_API MapCollisionCache
+{
+public:
+    MapCollisionCache();
+
+    // size is rounded down to a power of 2, 0 disables the cache. Entries are only allocated when the first result is stored.
+    void Initialize(uint32 size, float precision);
+    bool IsEnabled() const { return _entryCount != 0; }
+
+    // compute() is only called on cache miss, without the cache locked
+    template<class Compute>
+    bool GetLineOfSight(bool dynamic, uint32 param, float x1, float y1, float z1, float x2, float y2, float z2, Compute compute)
+    {
+        if (!IsEnabled())
+            return compute();
+
+        Key const key = MakeKey(MAP_COLLISION_QUERY_LOS, dynamic, param, 0.0f, { x1, y1, z1, x2, y2, z2 });
+        float result;
+        uint32 generation;
+        if (Find(key, result, generation))
+            return result != 0.0f;
+
+        bool const inLineOfSight = compute();
+        Store(key, inLineOfSight ? 1.0f : 0.0f, generation);
+        return inLineOfSight;
+    }
+
+    /* Same as GetLineOfSight for several queries, each having x1, y1, z1, x2, y2, z2 and result fields.
+    compute(queries, count) is called once with copies of the queries not found. */
+    template<class Query, class Compute>
+    void GetLineOfSight(bool dynamic, uint32 param, Query* queries, uint32 count, Compute compute)
+    {
+        if (!IsEnabled())
+        {
+            compute(queries, count);
+            return;
+        }
+
+        std::vector<Query> missedQueries;
+        std::vector<MissedKey> missedKeys;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            Query& query = queries[i];
+            Key const key = MakeKey(MAP_COLLISION_QUERY_LOS, dynamic, param, 0.0f, { query.x1, query.y1, query.z1, query.x2, query.y2, query.z2 });
+            float result;
+            uint32 generation;
+            if (Find(key, result, generation))
+                query.result = result != 0.0f;
+            else
+            {
+                missedQueries.push_back(query);
+                missedKeys.push_back({ key, generation, i });
+            }
+        }
+
+        if (missedQueries.empty())
+            return;
+
+        compute(missedQueries.data(), uint32(missedQueries.size()));
+        for (size_t i = 0; i < missedQueries.size(); ++i)
+        {
+            queries[missedKeys[i].index].result = missedQueries[i].result;
+            Store(missedKeys[i].key, missedQueries[i].result ? 1.0f : 0.0f, missedKeys[i].generation);
+        }
+    }
+
+    template<class Compute>
+    float GetHeight(bool dynamic, uint32 param, float x, float y, float z, float maxSearchDist, Compute compute)
+    {
+        if (!IsEnabled())
+            return compute();
+
+        Key const key = MakeKey(MAP_COLLISION_QUERY_HEIGHT, dynamic, param, maxSearchDist, { x, y, z, 0.0f, 0.0f, 0.0f });
+        float result;
+        uint32 generation;
+        if (Find(key, result, generation))
+            return result;
+
+        result = compute();
+        Store(key, result, generation);
+        return result;
+    }
+
+    void InvalidateVMaps();
+    void InvalidateGameObjectModels();
+
+    // Return counters since the last call and reset them
+    MapCollisionCacheStats TakeStats();
+
+private:
+    struct Key
+    {
+        std::array<int32, 6> coords;
+        float maxSearchDist;
+        uint32 param;                   // phase mask for dynamic queries, ignore flags for vmaps line of sight
+        MapCollisionQuery query;
+        bool dynamic;
+
+        bool operator==(Key const& right) const;
+    };
+
+    struct MissedKey
+    {
+        Key key;
+        uint32 generation;
+        uint32 index;
+    };
+
+    struct Entry
+    {
+        Key key;
+        uint32 generation;
+        float result;
+        bool used;
+    };
+
+    Key MakeKey(MapCollisionQuery query, bool dynamic, uint32 param, float maxSearchDist, std::array<float, 6> const& coords) const;
+    static uint32 Hash(Key const& key);
+    uint32 GetGeneration(Key const& key) const { return key.dynamic ? _modelsGeneration : _vmapsGeneration; }
+    // On miss, generation is set to the one the result must be computed for
+    bool Find(Key const& key, float& result, uint32& generation);
+    // Result is dropped if the cache was invalidated since Find
+    void Store(Key const& key, float result, uint32 generation);
+
+    std::mutex _lock;
+    std::vector<Entry> _entries;
+    uint32 _entryCount;
+    uint32 _mask;
+    float _inversePrecision;
+    // entries from an older generation are stale
+    uint32 _vmapsGeneration;
+    uint32 _modelsGeneration;
+    MapCollisionCacheStats _stats;
+};
+
+#endif
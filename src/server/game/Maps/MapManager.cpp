@@ -215,6 +215,13 @@ void MapManager::Update(time_t diff)
     if (!i_timer.Passed())
         return;
 
+    /* We keep instances updates looping while continents are updated.
+    Once all continents are done, we wait for the current instances updates to finish and stop.
+    Enable it before scheduling anything so that instances picked up early keep being updated too.
+    */
+    if (m_updater.activated())
+        m_updater.enableUpdateLoop(true);
+
     for (auto & i_map : i_maps)
     {
         if (m_updater.activated())
@@ -225,10 +232,6 @@ void MapManager::Update(time_t diff)
 
     if (m_updater.activated())
     {
-        /* We keep instances updates looping while continents are updated.
-        Once all continents are done, we wait for the current instances updates to finish and stop.
-        */
-        m_updater.enableUpdateLoop(true);
         m_updater.waitUpdateOnces();
         m_updater.enableUpdateLoop(false);
         m_updater.waitUpdateLoops();
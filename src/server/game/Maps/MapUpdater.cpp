@@ -1,6 +1,7 @@
 
 #include <mutex>
 #include <condition_variable>
+#include <algorithm>
 
 #include "MapUpdater.h"
 #include "Map.h"
@@ -9,6 +10,8 @@
 #include "MapManager.h"
 
 #define MINIMUM_MAP_UPDATE_INTERVAL 30
+// number of world ticks used to estimate the update cost of a once map
+#define MAP_UPDATE_COST_SAMPLE_COUNT 5
 
 class MapUpdateRequest
 {
@@ -18,18 +21,36 @@ class MapUpdateRequest
         MapUpdater& m_updater;
         uint32 m_diff;
         uint32 m_loopCount;
+        uint32 m_cost;
+        bool m_loop;
 
     public:
 
-        MapUpdateRequest(Map& m, MapUpdater& u, uint32 d) :
-            m_map(m), 
-            m_updater(u), 
-            m_diff(d), 
-            m_loopCount(0)
+        MapUpdateRequest(Map& m, MapUpdater& u, uint32 d, bool loop) :
+            m_map(m),
+            m_updater(u),
+            m_diff(d),
+            m_loopCount(0),
+            m_cost(0),
+            m_loop(loop)
         {
+            // Average is more reliable but also more costly to compute, only use it for once maps (there are only a few of them)
+            if (!m_loop)
+                m_cost = sMonitor->GetAverageDiffForMap(m_map, MAP_UPDATE_COST_SAMPLE_COUNT);
+            if (!m_cost)
+                m_cost = sMonitor->GetLastDiffForMap(m_map);
         }
 
         Map const* getMap() { return &m_map; }
+        uint32 getCost() const { return m_cost; }
+        bool isLoop() const { return m_loop; }
+        uint32 getLoopCount() const { return m_loopCount; }
+        // time to wait before the map can be updated without waiting for MINIMUM_MAP_UPDATE_INTERVAL, 0 if it can be right away
+        uint32 getTimeUntilDue() const
+        {
+            uint32 const elapsed = GetMSTimeDiffToNow(m_map.GetLastMapUpdateTime());
+            return elapsed >= MINIMUM_MAP_UPDATE_INTERVAL ? 0 : MINIMUM_MAP_UPDATE_INTERVAL - elapsed;
+        }
 
         void call()
         {
@@ -48,32 +69,54 @@ MapUpdater::~MapUpdater()
 
 void MapUpdater::activate(size_t num_threads)
 {
-    //spawn instances & battlegrounds threads
+    _cancelationToken = false;
+
     for (size_t i = 0; i < num_threads; ++i)
-        _loop_maps_workerThreads.push_back(std::thread(&MapUpdater::LoopWorkerThread, this, &_enable_updates_loop));
+        _queues.push_back(std::make_unique<WorkerQueue>());
 
-    //continents threads are spawned later when request are received
+    //spawn all workers now, continents, instances & battlegrounds all share them
+    for (size_t i = 0; i < num_threads; ++i)
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
 }
 
 void MapUpdater::deactivate()
 {
-    _cancelationToken = true;
-
-    _loop_queue.Cancel();
-    _once_queue.Cancel();
-
-    waitUpdateOnces();
-    waitUpdateLoops();
+    {
+        std::lock_guard<std::mutex> lock(_queuedLock);
+        _cancelationToken = true;
+    }
+    _queued_condition.notify_all();
 
-    for (auto& thread : _once_maps_workerThreads)
+    for (auto& thread : _workerThreads)
         thread.join();
 
-    _once_maps_workerThreads.clear();
+    _workerThreads.clear();
 
-    for (auto& thread : _loop_maps_workerThreads)
-        thread.join();
+    clearQueues();
+    _queues.clear();
+}
+
+void MapUpdater::clearQueues()
+{
+    for (auto& queue : _queues)
+    {
+        std::lock_guard<std::mutex> lock(queue->lock);
+        for (MapUpdateRequest* request : queue->onceRequests)
+        {
+            delete request;
+            onceMapFinished();
+        }
+        queue->onceRequests.clear();
 
-    _loop_maps_workerThreads.clear();
+        for (MapUpdateRequest* request : queue->loopRequests)
+        {
+            delete request;
+            loopMapFinished();
+        }
+        queue->loopRequests.clear();
+        queue->queuedCost = 0;
+    }
+    _queuedRequests = 0;
 }
 
 void MapUpdater::waitUpdateOnces()
@@ -101,87 +144,250 @@ void MapUpdater::waitUpdateLoops()
     lock.unlock();
 }
 
-void MapUpdater::spawnMissingOnceUpdateThreads()
-{
-    for (uint32 i = _once_maps_workerThreads.size(); i < pending_once_maps; i++)
-        _once_maps_workerThreads.push_back(std::thread(&MapUpdater::OnceWorkerThread, this));
-}
-
 void MapUpdater::schedule_update(Map& map, uint32 diff)
 {
-    std::lock_guard<std::mutex> lock(_lock);
-
-    MapUpdateRequest* request = new MapUpdateRequest(map, *this, diff);
     // MapInstanced re schedule the instances it contains by itself, so we want to call it only once
     // Also currently test maps needs to be updated once per world update
-    if((map.Instanceable() && map.GetMapType() != MAP_TYPE_MAP_INSTANCED) || map.GetMapType() == MAP_TYPE_TEST_MAP) 
-    { 
+    bool const loop = (map.Instanceable() && map.GetMapType() != MAP_TYPE_MAP_INSTANCED) || map.GetMapType() == MAP_TYPE_TEST_MAP;
+
+    MapUpdateRequest* request = new MapUpdateRequest(map, *this, diff, loop);
+    if (loop)
         pending_loop_maps++;
-        _loop_queue.Push(request);
-    } 
-    else 
-    {
+    else
         pending_once_maps++;
-        _once_queue.Push(request);
+
+    pushRequest(request);
+}
+
+void MapUpdater::pushRequest(MapUpdateRequest* request)
+{
+    ASSERT(!_queues.empty());
+
+    //pick least loaded queue, start search at a rotating index so that equal queues get filled evenly
+    size_t const queueCount = _queues.size();
+    size_t const start = _nextQueue++ % queueCount;
+    WorkerQueue* target = _queues[start].get();
+    for (size_t i = 1; i < queueCount; ++i)
+    {
+        WorkerQueue* queue = _queues[(start + i) % queueCount].get();
+        if (queue->queuedCost < target->queuedCost)
+            target = queue;
+    }
+
+    //count it before it's actually available, so that _queuedRequests never gets lower than the number of requests in queues
+    {
+        std::lock_guard<std::mutex> lock(_queuedLock);
+        _queuedRequests++;
+        _pushedRequests++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(target->lock);
+        if (request->isLoop())
+            target->loopRequests.push_back(request);
+        else
+        {
+            //keep once requests sorted by descending cost, heaviest maps must start first
+            auto itr = target->onceRequests.begin();
+            while (itr != target->onceRequests.end() && (*itr)->getCost() >= request->getCost())
+                ++itr;
+            target->onceRequests.insert(itr, request);
+        }
+        target->queuedCost += request->getCost();
     }
 
-    spawnMissingOnceUpdateThreads();
+    _queued_condition.notify_one();
 }
 
-bool MapUpdater::activated()
+MapUpdateRequest* MapUpdater::popOnceRequest(WorkerQueue& queue)
 {
-    return _loop_maps_workerThreads.size() > 0;
+    std::lock_guard<std::mutex> lock(queue.lock);
+    if (queue.onceRequests.empty())
+        return nullptr;
+
+    MapUpdateRequest* request = queue.onceRequests.front();
+    queue.onceRequests.pop_front();
+    queue.queuedCost -= request->getCost();
+    return request;
 }
 
-void MapUpdater::LoopWorkerThread(std::atomic<bool>* enable_instance_updates_loop)
+MapUpdateRequest* MapUpdater::popLoopRequest(WorkerQueue& queue, uint32& waitTime)
 {
-    while (1)
+    std::lock_guard<std::mutex> lock(queue.lock);
+    for (auto itr = queue.loopRequests.begin(); itr != queue.loopRequests.end(); ++itr)
     {
-        MapUpdateRequest* request = nullptr;
-
-        _loop_queue.WaitAndPop(request);
-
-        if (_cancelationToken) 
+        MapUpdateRequest* request = *itr;
+        //no need to wait for requests that will be deleted without being updated again
+        bool const discarded = !_enable_updates_loop && request->getLoopCount() > 0;
+        if (!discarded)
         {
-            if(request)
-                loopMapFinished();
-            return;
+            if (uint32 timeUntilDue = request->getTimeUntilDue())
+            {
+                if (!waitTime || timeUntilDue < waitTime)
+                    waitTime = timeUntilDue;
+                continue;
+            }
         }
 
-        ASSERT(request);
-        request->call();
+        queue.loopRequests.erase(itr);
+        queue.queuedCost -= request->getCost();
+        return request;
+    }
+    return nullptr;
+}
 
-        //repush at end of queue, or delete if loop has been disabled by MapManager
-        if(!(*enable_instance_updates_loop))
+MapUpdateRequest* MapUpdater::takeRequest(size_t workerIndex, uint32& waitTime)
+{
+    size_t const queueCount = _queues.size();
+    MapUpdateRequest* request = nullptr;
+    waitTime = 0;
+
+    //once maps first, those are the ones the world update is waiting for
+    for (size_t i = 0; i < queueCount && !request; ++i)
+        request = popOnceRequest(*_queues[(workerIndex + i) % queueCount]);
+
+    //then loop maps, leave the ones updated too recently in queue so that the worker doesn't sleep with them in Map::DoUpdate
+    for (size_t i = 0; i < queueCount && !request; ++i)
+        request = popLoopRequest(*_queues[(workerIndex + i) % queueCount], waitTime);
+
+    if (request)
+    {
+        _queuedRequests--;
+        waitTime = 0;
+    }
+
+    return request;
+}
+
+void MapUpdater::run_parallel_tasks(std::vector<std::function<void()>> const& tasks)
+{
+    if (!activated() || tasks.size() <= 1)
+    {
+        for (auto const& task : tasks)
+            task();
+        return;
+    }
+
+    auto batch = std::make_shared<TaskBatch>(tasks);
+    {
+        std::lock_guard<std::mutex> lock(_queuedLock);
+        _taskBatches.push_back(batch);
+    }
+    _queued_condition.notify_all();
+
+    runTaskBatch(*batch);
+
+    {
+        std::lock_guard<std::mutex> lock(_queuedLock);
+        auto itr = std::find(_taskBatches.begin(), _taskBatches.end(), batch);
+        if (itr != _taskBatches.end())
+            _taskBatches.erase(itr);
+    }
+
+    //wait for tasks started by other workers
+    std::unique_lock<std::mutex> lock(batch->lock);
+    batch->done_condition.wait(lock, [&batch] { return batch->remaining == 0; });
+}
+
+void MapUpdater::runTaskBatch(TaskBatch& batch)
+{
+    size_t index;
+    while ((index = batch.next++) < batch.count)
+    {
+        batch.tasks[index]();
+        if (--batch.remaining == 0)
         {
-            delete request;
-            loopMapFinished();
-        } else {
-            _loop_queue.Push(request);
+            std::lock_guard<std::mutex> lock(batch.lock);
+            batch.done_condition.notify_all();
         }
     }
 }
 
-void MapUpdater::OnceWorkerThread()
+bool MapUpdater::helpTaskBatch()
 {
-    while (1)
+    std::shared_ptr<TaskBatch> batch;
     {
-        MapUpdateRequest* request = nullptr;
+        std::lock_guard<std::mutex> lock(_queuedLock);
+        if (_taskBatches.empty())
+            return false;
+
+        batch = _taskBatches.front();
+    }
+
+    runTaskBatch(*batch);
+
+    //nothing left to start in this batch, make sure other workers don't pick it again
+    std::lock_guard<std::mutex> lock(_queuedLock);
+    if (!_taskBatches.empty() && _taskBatches.front() == batch)
+        _taskBatches.pop_front();
 
-        _once_queue.WaitAndPop(request);
+    return true;
+}
 
-        if (_cancelationToken) 
+bool MapUpdater::activated()
+{
+    return _workerThreads.size() > 0;
+}
+
+void MapUpdater::WorkerThread(size_t workerIndex)
+{
+    while (1)
+    {
         {
-            if(request)
-                onceMapFinished();
+            std::unique_lock<std::mutex> lock(_queuedLock);
+            _queued_condition.wait(lock, [this] { return _cancelationToken || _queuedRequests > 0 || !_taskBatches.empty(); });
+        }
+
+        if (_cancelationToken)
             return;
+
+        //tasks batches first, a map update is waiting for them
+        if (helpTaskBatch())
+            continue;
+
+        uint32 const pushedRequests = _pushedRequests;
+        uint32 waitTime;
+        MapUpdateRequest* request = takeRequest(workerIndex, waitTime);
+        if (!request)
+        {
+            //only loop maps not due yet are left, wait for the earliest one unless something else comes in
+            if (waitTime)
+            {
+                std::unique_lock<std::mutex> lock(_queuedLock);
+                _queued_condition.wait_for(lock, std::chrono::milliseconds(waitTime), [this, pushedRequests]
+                {
+                    return _cancelationToken || _pushedRequests != pushedRequests || !_taskBatches.empty();
+                });
+            }
+            continue; //else another worker was faster
+        }
+
+        if (!request->isLoop())
+        {
+            request->call();
+            delete request;
+            onceMapFinished();
+            continue;
+        }
+
+        //loop has been disabled by MapManager, no need to update again a map already updated this tick
+        if (!_enable_updates_loop && request->getLoopCount() > 0)
+        {
+            delete request;
+            loopMapFinished();
+            continue;
         }
 
-        ASSERT(request);
         request->call();
 
-        delete request;
-        onceMapFinished();
+        //repush at end of queue, or delete if loop has been disabled by MapManager
+        if (!_enable_updates_loop)
+        {
+            delete request;
+            loopMapFinished();
+        }
+        else
+            pushRequest(request);
     }
 }
 
@@ -3,10 +3,14 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
+#include <atomic>
 #include <mutex>
 #include <thread>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
 #include <condition_variable>
-#include "ProducerConsumerQueue.h"
 
 class MapUpdateRequest;
 class Map;
@@ -15,12 +19,16 @@ class Map;
 Two kinds of maps:
 - Maps we update only once (continents, instances base maps)
 - Maps we keep updating until the first type has finished (instances, battlegrounds)
+
+Both kinds are handled by a fixed pool of workers. Each worker owns a queue, requests are pushed on the least
+loaded queue and idle workers steal from the others. Once maps always go before loop maps, and are ordered by
+their estimated cost (see Monitor::GetAverageDiffForMap) so that the heaviest maps start first.
 */
 class MapUpdater
 {
 public:
 
-    MapUpdater() : _cancelationToken(false), _enable_updates_loop(false), pending_once_maps(0), pending_loop_maps(0) {}
+    MapUpdater() : _cancelationToken(false), _enable_updates_loop(false), pending_once_maps(0), pending_loop_maps(0), _queuedRequests(0), _pushedRequests(0), _nextQueue(0) {}
     ~MapUpdater();
 
     friend class MapUpdateRequest;
@@ -37,19 +45,65 @@ public:
     void deactivate();
 
     bool activated();
+    size_t workers_count() const { return _workerThreads.size(); }
+
+    /* Run given tasks on the workers and return once all of them are done. Calling thread takes part in the work,
+    so this can safely be called from within a map update. Tasks are run in world thread if updater isn't activated.
+    */
+    void run_parallel_tasks(std::vector<std::function<void()>> const& tasks);
+
 private:
 
+    struct WorkerQueue
+    {
+        WorkerQueue() : queuedCost(0) {}
+
+        std::mutex lock;
+        //sorted by descending cost
+        std::deque<MapUpdateRequest*> onceRequests;
+        //fifo, requests are pushed back here after each update
+        std::deque<MapUpdateRequest*> loopRequests;
+        //sum of the estimated cost of all requests in this queue
+        std::atomic<uint32> queuedCost;
+    };
+
+    struct TaskBatch
+    {
+        TaskBatch(std::vector<std::function<void()>> const& _tasks) : tasks(_tasks), count(_tasks.size()), next(0), remaining(_tasks.size()) {}
+
+        //owned by caller, only valid until remaining reaches 0
+        std::vector<std::function<void()>> const& tasks;
+        size_t const count;
+        std::atomic<size_t> next;
+        std::atomic<size_t> remaining;
+        std::mutex lock;
+        //notified when remaining reaches 0
+        std::condition_variable done_condition;
+    };
+
+    //execute tasks from first batch in _taskBatches until there is none left. Return false if there was no batch.
+    bool helpTaskBatch();
+    //execute tasks from batch until there is none left to start
+    static void runTaskBatch(TaskBatch& batch);
+
     void onceMapFinished();
     void loopMapFinished();
 
-	//this will ensure once_map_workerThreads match the pending_once_maps count
-	void spawnMissingOnceUpdateThreads();
-
-    ProducerConsumerQueue<MapUpdateRequest*> _loop_queue;
-	ProducerConsumerQueue<MapUpdateRequest*> _once_queue;
-
-    std::vector<std::thread> _loop_maps_workerThreads; 
-    std::vector<std::thread> _once_maps_workerThreads; //created/deleted at each loop, one for each continent
+    //push request on the least loaded worker queue and wake up a worker
+    void pushRequest(MapUpdateRequest* request);
+    /* Get next request for given worker, from its own queue if possible else steal it from another one. Loop requests are only
+    returned once their minimum update interval has expired. Return nullptr if no request could be found, waitTime is then set
+    to the time until the earliest loop request is due (0 if there is none).
+    */
+    MapUpdateRequest* takeRequest(size_t workerIndex, uint32& waitTime);
+    static MapUpdateRequest* popOnceRequest(WorkerQueue& queue);
+    //return first due loop request, else lower waitTime to the time until the earliest one in this queue is due
+    MapUpdateRequest* popLoopRequest(WorkerQueue& queue, uint32& waitTime);
+    //delete all requests still in queues, used at deactivation
+    void clearQueues();
+
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
+    std::vector<std::thread> _workerThreads;
     std::atomic<bool> _cancelationToken;
     std::atomic<bool> _enable_updates_loop;
 
@@ -61,12 +115,20 @@ private:
     std::atomic<uint32> pending_once_maps;
     std::atomic<uint32> pending_loop_maps;
 
-    /* Loop workers keep running and processing _loop_queue, updating maps and requeuing them afterwards.
-    When onceMapsFinished becomes true, the worker finish the current request and delete the request instead of requeuing it.
+    //notified when a request is pushed in any queue
+    std::mutex _queuedLock;
+    std::condition_variable _queued_condition;
+    std::atomic<uint32> _queuedRequests;
+    //incremented on each push, lets workers waiting for a loop map to be due notice new requests
+    std::atomic<uint32> _pushedRequests;
+    std::atomic<uint32> _nextQueue;
+    //batches from run_parallel_tasks, also protected by _queuedLock
+    std::deque<std::shared_ptr<TaskBatch>> _taskBatches;
+
+    /* Workers keep running and processing requests from their queue (or stealing from the others).
+    Loop maps requests are requeued after each update as long as _enable_updates_loop is set, else they're deleted.
     */
-    void LoopWorkerThread(std::atomic<bool>* onceMapsFinished);
-    //Single update, descrease pending_once_maps when done
-	void OnceWorkerThread();
+    void WorkerThread(size_t workerIndex);
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
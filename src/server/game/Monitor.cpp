@@ -3,12 +3,16 @@
 #include "BattleGroundMgr.h"
 #include "Language.h"
 #include "Chat.h"
+#include "Config.h"
+#include "Log.h"
+
+#include <fstream>
 
 Monitor::Monitor()
     : _worldTickCount(0),
+    _mapPhasesExportTimer(0),
     _generalInfoTimer(0)
 {
-    _worldTicksInfo.reserve(DAY * 20); //already prepare 1 day worth of 20 updates per seconds
 }
 
 void Monitor::Update(uint32 diff)
@@ -19,6 +23,18 @@ void Monitor::Update(uint32 diff)
     UpdateGeneralInfosIfExpired(diff);
 
     smoothTD.Update(diff);
+
+    if (uint32 exportInterval = sWorld->getConfig(CONFIG_MONITORING_MAP_PHASES_EXPORT_INTERVAL) * IN_MILLISECONDS)
+    {
+        _mapPhasesExportTimer += diff;
+        if (_mapPhasesExportTimer >= exportInterval)
+        {
+            _mapPhasesExportTimer = 0;
+            std::string const fileName = sConfigMgr->GetStringDefault("Monitor.MapPhases.ExportFile", "map_phases.prom");
+            if (!ExportMapPhases(fileName))
+                TC_LOG_ERROR("misc", "Monitor: Failed to export map phases to file %s", fileName.c_str());
+        }
+    }
 }
 
 void SmoothedTimeDiff::Update(uint32 diff)
@@ -123,10 +139,25 @@ void Monitor::FinishedWorldLoop()
 
 
     //Store current world tick and reset it
-    _worldTicksInfo.push_back(std::move(_currentWorldTickInfo));
+    {
+        std::lock_guard<std::mutex> lock(_worldTicksInfoLock);
+        _worldTicksInfo.push_back(std::move(_currentWorldTickInfo));
+        uint32 const maxCount = GetWorldTicksInfoMaxCount();
+        while (_worldTicksInfo.size() > maxCount)
+            _worldTicksInfo.pop_front();
+    }
     _currentWorldTickInfo = {};
 }
 
+uint32 Monitor::GetWorldTicksInfoMaxCount() const
+{
+    //keep as much ticks as the biggest search count used on _worldTicksInfo (see GetAverageWorldDiff and GetAverageDiffForMap callers)
+    return std::max({ uint32(100),
+        sWorld->getConfig(CONFIG_MONITORING_LAG_AUTO_REBOOT_COUNT),
+        sWorld->getConfig(CONFIG_MONITORING_ALERT_THRESHOLD_COUNT),
+        sWorld->getConfig(CONFIG_MONITORING_DYNAMIC_VIEWDIST_AVERAGE_COUNT) });
+}
+
 void Monitor::UpdateGeneralInfosIfExpired(uint32 diff)
 {
     uint32 generalInfosUpdateTimeout = IN_MILLISECONDS * sWorld->getConfig(CONFIG_MONITORING_GENERALINFOS_UPDATE);
@@ -255,8 +286,8 @@ uint32 Monitor::GetAverageDiffForMap(Map const& map, uint32 searchCount)
     uint32 count = 0;
     for (uint32 i = _worldTicksInfo.size() - searchCount; i != _worldTicksInfo.size(); i++)
     {
-        auto ticks = _worldTicksInfo[i].updateInfos[map.GetId()][map.GetInstanceId()].ticks;
-        for (auto itr : ticks)
+        auto const& ticks = _worldTicksInfo[i].updateInfos[map.GetId()][map.GetInstanceId()].ticks;
+        for (auto const& itr : ticks)
         {
             sum += itr.second.diff();
             count++;
@@ -281,6 +312,235 @@ uint32 Monitor::GetLastDiffForMap(Map const& map)
     return itr->second;
 }
 
+// Phases times for map updates done on this thread, not yet moved to Monitor::_mapPhasesStats
+struct MapPhasesThreadBuffer
+{
+    static const uint32 RING_SIZE = 64;
+    //flush when we have this much records or when last flush is older than FLUSH_INTERVAL (ms)
+    static const uint32 FLUSH_COUNT = 16;
+    static const uint32 FLUSH_INTERVAL = 1000;
+
+    struct Record
+    {
+        uint32 mapId;
+        MapPhasesDurations phases;
+    };
+
+    //times for the map update in progress
+    MapPhasesDurations current = {};
+    std::array<Record, RING_SIZE> ring;
+    uint32 head = 0;
+    uint32 size = 0;
+    uint32 lastFlushTime = 0;
+};
+
+static thread_local MapPhasesThreadBuffer _mapPhasesThreadBuffer;
+
+MapPhaseTimer::MapPhaseTimer(MapUpdatePhase phase)
+    : _phase(phase), _enabled(sMonitor->IsMapPhasesProfilingEnabled())
+{
+    if (_enabled)
+        _start = std::chrono::steady_clock::now();
+}
+
+MapPhaseTimer::~MapPhaseTimer()
+{
+    if (!_enabled)
+        return;
+
+    auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start);
+    sMonitor->AddMapPhaseTime(_phase, uint32(elapsed.count()));
+}
+
+bool Monitor::IsMapPhasesProfilingEnabled() const
+{
+    return sWorld->getConfig(CONFIG_MONITORING_ENABLED) && sWorld->getConfig(CONFIG_MONITORING_MAP_PHASES);
+}
+
+void Monitor::AddMapPhaseTime(MapUpdatePhase phase, uint32 microseconds)
+{
+    _mapPhasesThreadBuffer.current[phase] += microseconds;
+}
+
+void Monitor::MapPhasesUpdateEnd(Map const& map)
+{
+    if (!IsMapPhasesProfilingEnabled())
+        return;
+
+    MapPhasesThreadBuffer& buffer = _mapPhasesThreadBuffer;
+    MapPhasesThreadBuffer::Record& record = buffer.ring[(buffer.head + buffer.size) % MapPhasesThreadBuffer::RING_SIZE];
+    record.mapId = map.GetId();
+    record.phases = buffer.current;
+    buffer.current = {};
+    if (buffer.size < MapPhasesThreadBuffer::RING_SIZE)
+        buffer.size++;
+    else
+        buffer.head = (buffer.head + 1) % MapPhasesThreadBuffer::RING_SIZE; //overwrote oldest record
+
+    uint32 const now = GetMSTime();
+    if (buffer.size >= MapPhasesThreadBuffer::FLUSH_COUNT || GetMSTimeDiff(buffer.lastFlushTime, now) >= MapPhasesThreadBuffer::FLUSH_INTERVAL)
+    {
+        FlushMapPhases();
+        buffer.lastFlushTime = now;
+    }
+}
+
+void Monitor::FlushMapPhases()
+{
+    MapPhasesThreadBuffer& buffer = _mapPhasesThreadBuffer;
+
+    std::lock_guard<std::mutex> lock(_mapPhasesLock);
+    for (; buffer.size; buffer.size--, buffer.head = (buffer.head + 1) % MapPhasesThreadBuffer::RING_SIZE)
+    {
+        MapPhasesThreadBuffer::Record const& record = buffer.ring[buffer.head];
+        MapPhasesStats& stats = _mapPhasesStats[record.mapId];
+        if (stats.samples.size() < MapPhasesStats::SAMPLE_COUNT)
+            stats.samples.push_back(record.phases);
+        else
+            stats.samples[stats.nextSample] = record.phases;
+
+        stats.nextSample = (stats.nextSample + 1) % MapPhasesStats::SAMPLE_COUNT;
+    }
+}
+
+bool Monitor::GetMapPhasesPercentiles(uint32 mapId, std::array<MapPhasePercentiles, MAP_UPDATE_PHASE_COUNT>& percentiles)
+{
+    std::vector<MapPhasesDurations> samples;
+    {
+        std::lock_guard<std::mutex> lock(_mapPhasesLock);
+        auto itr = _mapPhasesStats.find(mapId);
+        if (itr == _mapPhasesStats.end() || itr->second.samples.empty())
+            return false;
+
+        samples = itr->second.samples;
+    }
+
+    std::vector<uint32> values(samples.size());
+    for (uint8 phase = 0; phase < MAP_UPDATE_PHASE_COUNT; phase++)
+    {
+        for (size_t i = 0; i < samples.size(); i++)
+            values[i] = samples[i][phase];
+
+        MapPhasePercentiles& result = percentiles[phase];
+        std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+        result.p50 = values[values.size() / 2];
+        size_t const p99Index = std::min(values.size() - 1, values.size() * 99 / 100);
+        std::nth_element(values.begin(), values.begin() + p99Index, values.end());
+        result.p99 = values[p99Index];
+        result.max = *std::max_element(values.begin() + p99Index, values.end());
+    }
+    return true;
+}
+
+std::vector<uint32> Monitor::GetMapPhasesMapIds()
+{
+    std::vector<uint32> mapIds;
+    std::lock_guard<std::mutex> lock(_mapPhasesLock);
+    for (auto const& itr : _mapPhasesStats)
+        mapIds.push_back(itr.first);
+
+    return mapIds;
+}
+
+bool Monitor::ExportMapPhases(std::string const& fileName)
+{
+    //write to a temporary file then rename it, so that a reader never sees a partially written file
+    std::string const tmpFileName = fileName + ".tmp";
+    {
+        std::ofstream file(tmpFileName, std::ios::out | std::ios::trunc);
+        if (!file)
+            return false;
+
+        file << "# HELP sunstrider_map_phase_duration_microseconds Time spent in each phase of map updates\n";
+        file << "# TYPE sunstrider_map_phase_duration_microseconds summary\n";
+        std::array<MapPhasePercentiles, MAP_UPDATE_PHASE_COUNT> percentiles;
+        for (uint32 mapId : GetMapPhasesMapIds())
+        {
+            if (!GetMapPhasesPercentiles(mapId, percentiles))
+                continue;
+
+            for (uint8 phase = 0; phase < MAP_UPDATE_PHASE_COUNT; phase++)
+            {
+                char const* phaseName = GetMapPhaseName(MapUpdatePhase(phase));
+                file << "sunstrider_map_phase_duration_microseconds{map=\"" << mapId << "\",phase=\"" << phaseName << "\",quantile=\"0.5\"} " << percentiles[phase].p50 << "\n";
+                file << "sunstrider_map_phase_duration_microseconds{map=\"" << mapId << "\",phase=\"" << phaseName << "\",quantile=\"0.99\"} " << percentiles[phase].p99 << "\n";
+            }
+        }
+
+        std::map<uint32, MapCollisionCacheStats> collisionCacheStats;
+        {
+            std::lock_guard<std::mutex> lock(_mapCollisionCacheStatsLock);
+            collisionCacheStats = _mapCollisionCacheStats;
+        }
+
+        file << "# HELP sunstrider_map_collision_cache_queries_total Line of sight and height queries of maps, by cache result\n";
+        file << "# TYPE sunstrider_map_collision_cache_queries_total counter\n";
+        for (auto const& itr : collisionCacheStats)
+        {
+            for (uint8 query = 0; query < MAP_COLLISION_QUERY_COUNT; query++)
+            {
+                char const* queryName = GetMapCollisionQueryName(MapCollisionQuery(query));
+                file << "sunstrider_map_collision_cache_queries_total{map=\"" << itr.first << "\",query=\"" << queryName << "\",result=\"hit\"} " << itr.second.hits[query] << "\n";
+                file << "sunstrider_map_collision_cache_queries_total{map=\"" << itr.first << "\",query=\"" << queryName << "\",result=\"miss\"} " << itr.second.misses[query] << "\n";
+            }
+        }
+
+        if (!file)
+            return false;
+    }
+
+    return std::rename(tmpFileName.c_str(), fileName.c_str()) == 0;
+}
+
+void Monitor::AddMapCollisionCacheStats(uint32 mapId, MapCollisionCacheStats const& stats)
+{
+    std::lock_guard<std::mutex> lock(_mapCollisionCacheStatsLock);
+    MapCollisionCacheStats& total = _mapCollisionCacheStats[mapId];
+    for (uint8 query = 0; query < MAP_COLLISION_QUERY_COUNT; query++)
+    {
+        total.hits[query] += stats.hits[query];
+        total.misses[query] += stats.misses[query];
+    }
+}
+
+bool Monitor::GetMapCollisionCacheStats(uint32 mapId, MapCollisionCacheStats& stats)
+{
+    std::lock_guard<std::mutex> lock(_mapCollisionCacheStatsLock);
+    auto itr = _mapCollisionCacheStats.find(mapId);
+    if (itr == _mapCollisionCacheStats.end())
+        return false;
+
+    stats = itr->second;
+    return true;
+}
+
+char const* Monitor::GetMapCollisionQueryName(MapCollisionQuery query)
+{
+    switch (query)
+    {
+        case MAP_COLLISION_QUERY_LOS:    return "los";
+        case MAP_COLLISION_QUERY_HEIGHT: return "height";
+        default:                         return "unknown";
+    }
+}
+
+char const* Monitor::GetMapPhaseName(MapUpdatePhase phase)
+{
+    switch (phase)
+    {
+        case MAP_UPDATE_PHASE_SESSIONS:            return "sessions";
+        case MAP_UPDATE_PHASE_RESPAWNS:            return "respawns";
+        case MAP_UPDATE_PHASE_PLAYERS:             return "players";
+        case MAP_UPDATE_PHASE_GRID_VISITS:         return "grid_visits";
+        case MAP_UPDATE_PHASE_CREATURE_GROUPS:     return "creature_groups";
+        case MAP_UPDATE_PHASE_TRANSPORTS:          return "transports";
+        case MAP_UPDATE_PHASE_SEND_OBJECT_UPDATES: return "send_object_updates";
+        case MAP_UPDATE_PHASE_SCRIPTS:             return "scripts";
+        case MAP_UPDATE_PHASE_RELOCATION_NOTIFIES: return "relocation_notifies";
+        default:                                   return "unknown";
+    }
+}
+
 void MonitorAutoReboot::Update(uint32 diff)
 {
     uint32 searchCount = sWorld->getConfig(CONFIG_MONITORING_LAG_AUTO_REBOOT_COUNT);
@@ -1,6 +1,8 @@
 #ifndef __MONITOR_H
 #define __MONITOR_H
 
+#include "MapCollisionCache.h"
+
 /*
 Ideas:
 - Allow to trigger profiling at next udpate, by command or automatically every X according to config
@@ -15,7 +17,7 @@ struct MapTickInfo
 	uint32 startTime = 0;
 	uint32 endTime = 0;
 
-	uint32 diff() { return endTime - startTime; }
+	uint32 diff() const { return endTime - startTime; }
 };
 
 struct MapTicksInfo
@@ -36,6 +38,53 @@ struct WorldTickInfo
 	uint32 diff           = 0; //value calculated from startTime and endTime
 };
 
+// Phases of Map::Update measured by MapPhaseTimer
+enum MapUpdatePhase : uint8
+{
+	MAP_UPDATE_PHASE_SESSIONS,
+	MAP_UPDATE_PHASE_RESPAWNS,
+	MAP_UPDATE_PHASE_PLAYERS,              // includes everything done in parallel regions, if enabled for this map
+	MAP_UPDATE_PHASE_GRID_VISITS,
+	MAP_UPDATE_PHASE_CREATURE_GROUPS,
+	MAP_UPDATE_PHASE_TRANSPORTS,
+	MAP_UPDATE_PHASE_SEND_OBJECT_UPDATES,
+	MAP_UPDATE_PHASE_SCRIPTS,
+	MAP_UPDATE_PHASE_RELOCATION_NOTIFIES,
+
+	MAP_UPDATE_PHASE_COUNT
+};
+
+typedef std::array<uint32 /*microseconds*/, MAP_UPDATE_PHASE_COUNT> MapPhasesDurations;
+
+//Time spent in each phase for the last SAMPLE_COUNT updates of all maps with a given id
+struct MapPhasesStats
+{
+	static const uint32 SAMPLE_COUNT = 1024;
+
+	std::vector<MapPhasesDurations> samples; //ring buffer
+	uint32 nextSample = 0;
+};
+
+struct MapPhasePercentiles
+{
+	uint32 p50 = 0;
+	uint32 p99 = 0;
+	uint32 max = 0;
+};
+
+//Scoped timer, add time spent until destruction to given phase of the map update in progress on this thread
+class TC_GAME_API MapPhaseTimer
+{
+public:
+	explicit MapPhaseTimer(MapUpdatePhase phase);
+	~MapPhaseTimer();
+
+private:
+	MapUpdatePhase const _phase;
+	bool const _enabled;
+	std::chrono::steady_clock::time_point _start;
+};
+
 class MonitorAutoReboot
 {
 public:
@@ -110,6 +159,28 @@ public:
 
 	// Flattened timediff upated every minute. This is a cached value.
 	uint32 GetSmoothTimeDiff() const { return smoothTD.Get(); }
+
+	// -- Map update phases profiling (see MapPhaseTimer)
+	bool IsMapPhasesProfilingEnabled() const;
+	// Called by MapPhaseTimer, add time to the map update in progress on this thread
+	void AddMapPhaseTime(MapUpdatePhase phase, uint32 microseconds);
+	// Called at the end of Map::Update, store phases times accumulated on this thread for this map
+	void MapPhasesUpdateEnd(Map const& map);
+	// Percentiles for each phase for given map id. Return false if no update has been recorded for this map.
+	bool GetMapPhasesPercentiles(uint32 mapId, std::array<MapPhasePercentiles, MAP_UPDATE_PHASE_COUNT>& percentiles);
+	std::vector<uint32> GetMapPhasesMapIds();
+	// Write p50/p99 of all maps phases to file, in Prometheus text format
+	bool ExportMapPhases(std::string const& fileName);
+	static char const* GetMapPhaseName(MapUpdatePhase phase);
+	// --
+
+	// -- Line of sight and height cache of maps (see MapCollisionCache)
+	// Called at the end of Map::Update with the counters of this update
+	void AddMapCollisionCacheStats(uint32 mapId, MapCollisionCacheStats const& stats);
+	// Totals since startup for all maps with given id. Return false if none was recorded.
+	bool GetMapCollisionCacheStats(uint32 mapId, MapCollisionCacheStats& stats);
+	static char const* GetMapCollisionQueryName(MapCollisionQuery query);
+	// --
 private:
 	// -- MapUpdater & World functions
 	void MapUpdateStart(Map const& map);
@@ -133,9 +204,19 @@ private:
 	std::mutex _currentWorldTickLock;
 	WorldTickInfo _currentWorldTickInfo;
 
-	//info for all world loops since Monitor is running
+	//info for the last world loops, only the number needed by the various checks is kept (see GetWorldTicksInfoMaxCount)
 	std::mutex _worldTicksInfoLock;
-	std::vector<WorldTickInfo> _worldTicksInfo;
+	std::deque<WorldTickInfo> _worldTicksInfo;
+	uint32 GetWorldTicksInfoMaxCount() const;
+
+	//move phases records from this thread ring buffer to _mapPhasesStats
+	void FlushMapPhases();
+	std::mutex _mapPhasesLock;
+	std::map<uint32 /*mapId*/, MapPhasesStats> _mapPhasesStats;
+	uint32 _mapPhasesExportTimer;
+
+	std::mutex _mapCollisionCacheStatsLock;
+	std::map<uint32 /*mapId*/, MapCollisionCacheStats> _mapCollisionCacheStats;
 
 	//last map diffs. This is redundant with info in _worldTicksInfo but this allows for greater speed and to avoid locking it.
 	std::unordered_map<uint64 /* map pointer*/, uint32 /* diff*/> _lastMapDiffs;
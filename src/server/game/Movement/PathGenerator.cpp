@@ -89,16 +89,15 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
     if (_transport)
         _transport->CalculatePassengerOffset(destX, destY, destZ);
 
-    if (!_navMeshQuery || !_navMesh)
+    // queries belong to the calling thread, and maps may be updated by a different thread each time
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         if (_transport)
             _navMeshQuery = mmap->GetModelNavMeshQuery(_transport->GetDisplayId());
         else
-            _navMeshQuery = mmap->GetNavMeshQuery(_sourceMapId, _sourceInstanceId);
+            _navMeshQuery = mmap->GetNavMeshQuery(_sourceMapId);
 
-        if (_navMeshQuery)
-            _navMesh = _navMeshQuery->getAttachedNavMesh();
+        _navMesh = _navMeshQuery ? _navMeshQuery->getAttachedNavMesh() : nullptr;
     }
 
     //reset last result if any
@@ -62,4 +62,7 @@ class TC_GAME_API WorldPacket : public ByteBuffer
         uint16 m_opcode;
 };
 
+// Packet built once and sent as is to many sessions, sockets reference its content instead of copying it
+typedef std::shared_ptr<WorldPacket const> SharedWorldPacket;
+
 #endif
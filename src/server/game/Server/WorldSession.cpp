@@ -179,6 +179,16 @@ ObjectGuid::LowType WorldSession::GetGUIDLow() const
 }
 
 void WorldSession::SendPacket(WorldPacket const* packet)
+{
+    _SendPacket(packet, nullptr);
+}
+
+void WorldSession::SendPacket(SharedWorldPacket const& packet)
+{
+    _SendPacket(packet.get(), &packet);
+}
+
+void WorldSession::_SendPacket(WorldPacket const* packet, SharedWorldPacket const* shared)
 {
     ASSERT(packet->GetOpcode() != NULL_OPCODE);
 
@@ -235,7 +245,10 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     //    sScriptMgr->OnPacketSend(this, *packet);
 
     TC_LOG_TRACE("network.opcode", "S->C: %s %s", GetPlayerInfo().c_str(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str());
-    m_Socket->SendPacket(*packet);
+    if (shared)
+        m_Socket->SendPacket(*shared);
+    else
+        m_Socket->SendPacket(*packet);
 
     // Log packet for replay
     if (m_replayRecorder)
@@ -240,6 +240,8 @@ class TC_GAME_API WorldSession
         void SendAddonsInfo();
 
         void SendPacket(WorldPacket const* packet);
+        // For packets sent to many sessions, the socket references the packet instead of copying it
+        void SendPacket(SharedWorldPacket const& packet);
         void SendNotification(const char *format,...) ATTR_PRINTF(2,3);
         void SendNotification(int32 string_id,...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName *declinedName);
@@ -920,6 +922,8 @@ class TC_GAME_API WorldSession
 
     private:
         void ProcessQueryCallbacks();
+        // shared is set when packet is a shared one
+        void _SendPacket(WorldPacket const* packet, SharedWorldPacket const* shared);
 
         QueryResultHolderFuture _realmAccountLoginCallback;
         QueryResultHolderFuture _charLoginCallback;
@@ -17,15 +17,24 @@ class EncryptablePacket : public WorldPacket
 {
 public:
     EncryptablePacket(WorldPacket const& packet, bool encrypt) : WorldPacket(packet), _encrypt(encrypt) { }
+    // Only keeps a reference to the shared packet, left empty itself
+    EncryptablePacket(SharedWorldPacket packet, bool encrypt) : WorldPacket(), _shared(std::move(packet)), _encrypt(encrypt) { }
 
     bool NeedsEncryption() const { return _encrypt; }
 
+    WorldPacket const& GetPacket() const { return _shared ? *_shared : *this; }
+    SharedWorldPacket const& GetShared() const { return _shared; }
+
 private:
+    SharedWorldPacket _shared;
     bool _encrypt;
 };
 
 using boost::asio::ip::tcp;
 
+// packets at least this big are sent from their own storage instead of being copied into the send buffer
+#define ZERO_COPY_PACKET_MIN_SIZE 1024
+
 WorldSocket::WorldSocket(tcp::socket&& socket)
     : Socket(std::move(socket)), _authSeed(rand32()), _OverSpeedPings(0), _worldSession(nullptr), _authed(false), _authCrypt(nullptr), _sendBufferSize(4096)
 {
@@ -82,30 +91,52 @@ bool WorldSocket::Update()
     MessageBuffer buffer(_sendBufferSize);
     while (_bufferQueue.Dequeue(queued))
     {
-        ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
+        WorldPacket const& packet = queued->GetPacket();
+        ServerPktHeader header(packet.size() + 2, packet.GetOpcode());
         if (_authCrypt && queued->NeedsEncryption())
             _authCrypt->EncryptSend(header.header, header.getHeaderLength());
 
-        if (buffer.GetRemainingSpace() < queued->size() + header.getHeaderLength())
+        if (packet.size() >= ZERO_COPY_PACKET_MIN_SIZE)
         {
-            QueuePacket(std::move(buffer));
-            buffer.Resize(_sendBufferSize);
-        }
+            // write header in current buffer and queue packet storage right after it, no need to copy it
+            if (buffer.GetRemainingSpace() < header.getHeaderLength())
+            {
+                QueuePacket(std::move(buffer));
+                buffer = MessageBuffer(_sendBufferSize);
+            }
 
-        if (buffer.GetRemainingSpace() >= queued->size() + header.getHeaderLength())
-        {
             buffer.Write(header.header, header.getHeaderLength());
-            if (!queued->empty())
-                buffer.Write(queued->contents(), queued->size());
+            QueuePacket(std::move(buffer));
+            // a shared packet is referenced until sent, it can't be moved since other sockets may still send it
+            if (SharedWorldPacket const& shared = queued->GetShared())
+                QueuePacket(MessageBuffer(shared, shared->contents(), shared->size()));
+            else
+                QueuePacket(MessageBuffer(queued->Move()));
+            buffer = MessageBuffer(_sendBufferSize);
         }
-        else    // single packet larger than 4096 bytes
+        else
         {
-            MessageBuffer packetBuffer(queued->size() + header.getHeaderLength());
-            packetBuffer.Write(header.header, header.getHeaderLength());
-            if (!queued->empty())
-                packetBuffer.Write(queued->contents(), queued->size());
+            if (buffer.GetRemainingSpace() < packet.size() + header.getHeaderLength())
+            {
+                QueuePacket(std::move(buffer));
+                buffer = MessageBuffer(_sendBufferSize);
+            }
+
+            if (buffer.GetRemainingSpace() >= packet.size() + header.getHeaderLength())
+            {
+                buffer.Write(header.header, header.getHeaderLength());
+                if (!packet.empty())
+                    buffer.Write(packet.contents(), packet.size());
+            }
+            else    // single packet larger than send buffer
+            {
+                MessageBuffer packetBuffer(packet.size() + header.getHeaderLength());
+                packetBuffer.Write(header.header, header.getHeaderLength());
+                if (!packet.empty())
+                    packetBuffer.Write(packet.contents(), packet.size());
 
-            QueuePacket(std::move(packetBuffer));
+                QueuePacket(std::move(packetBuffer));
+            }
         }
 
         delete queued;
@@ -415,6 +446,21 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     if (!IsOpen())
         return;
 
+    LogSentPacket(packet);
+    _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt && _authCrypt->IsInitialized()));
+}
+
+void WorldSocket::SendPacket(SharedWorldPacket const& packet)
+{
+    if (!IsOpen())
+        return;
+
+    LogSentPacket(*packet);
+    _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt && _authCrypt->IsInitialized()));
+}
+
+void WorldSocket::LogSentPacket(WorldPacket const& packet)
+{
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
 
@@ -427,8 +473,6 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
         if (_lastPacketsSent.size() < 10)
             _lastPacketsSent.push_back(packet);
     }
-
-    _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt && _authCrypt->IsInitialized()));
 }
 
 void WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
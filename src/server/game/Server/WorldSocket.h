@@ -45,6 +45,8 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    // Same as above without copying the packet, which may be sent by other sockets at the same time
+    void SendPacket(SharedWorldPacket const& packet);
 
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
@@ -72,6 +74,8 @@ protected:
 
 private:
     void CheckIpCallback(PreparedQueryResult result);
+    /// packet log and debug options, for all sent packets
+    void LogSentPacket(WorldPacket const& packet);
 
     /// writes network.opcode log
     /// accessing WorldSession is not threadsafe, only do it when holding _worldSessionLock
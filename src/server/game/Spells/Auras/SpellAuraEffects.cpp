@@ -649,6 +649,20 @@ int32 AuraEffect::CalculateAmount(Unit* caster)
     return amount;
 }
 
+void AuraEffect::SetAmount(int32 amount)
+{
+    _amount = amount;
+    m_canBeRecalculated = false;
+    InvalidateTargetsAuraModifierCache();
+}
+
+void AuraEffect::InvalidateTargetsAuraModifierCache() const
+{
+    for (auto const& application : GetBase()->GetApplicationMap())
+        if (application.second->HasEffect(GetEffIndex()))
+            application.second->GetTarget()->InvalidateAuraModifierCache(GetAuraType());
+}
+
 void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
 {
     // Reapply if amount change
@@ -2248,6 +2262,7 @@ void AuraEffect::PeriodicDummyTick(AuraApplication* aurApp, Unit* caster, uint32
         else if (regen_pct < 0.2f) 
             regen_pct = 0.2f;
         _amount = int32(base_regen * regen_pct);
+        InvalidateTargetsAuraModifierCache();
         (m_target->ToPlayer())->UpdateManaRegen();
         return;
     }
@@ -1264,8 +1264,8 @@ void Spell::SelectImplicitConeTargets(SpellEffIndex effIndex, SpellImplicitTarge
     if (uint32 containerTypeMask = GetSearcherTypeMask(objectType, condList))
     {
         Trinity::WorldObjectSpellConeTargetCheck check(coneAngle, radius, m_caster, m_spellInfo, selectionType, condList);
-        Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellConeTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
-        SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellConeTargetCheck> >(searcher, containerTypeMask, m_caster, m_caster, radius);
+        Trinity::WorldObjectListAreaSearcher<Trinity::WorldObjectSpellConeTargetCheck> searcher(targets, check, *m_caster, radius, radius, containerTypeMask);
+        SearchTargets<Trinity::WorldObjectListAreaSearcher<Trinity::WorldObjectSpellConeTargetCheck> >(searcher, containerTypeMask, m_caster, m_caster, radius);
 
         CallScriptObjectAreaTargetSelectHandlers(targets, effIndex, targetType);
 
@@ -1373,6 +1373,8 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             Trinity::Containers::RandomResize(targets, maxTargets);
         }
 
+        PrefetchAreaTargetsLOS(targets);
+
         for (auto & target : targets)
         {
             if (Unit* newTarget = target->ToUnit())
@@ -1726,8 +1728,9 @@ void Spell::SelectImplicitTrajTargets(SpellEffIndex effIndex, SpellImplicitTarge
 
     std::list<WorldObject*> targets;
     Trinity::WorldObjectSpellTrajTargetCheck check(dist2d, &srcPos, m_caster, m_spellInfo, targetType.GetCheckType(), m_spellInfo->Effects[effIndex].ImplicitTargetConditions);
-    Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellTrajTargetCheck> searcher(m_caster, targets, check, GRID_MAP_TYPE_MASK_ALL);
-    SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellTrajTargetCheck> >(searcher, GRID_MAP_TYPE_MASK_ALL, m_caster, &srcPos, dist2d);
+    // any height, only the distance on the trajectory is checked
+    Trinity::WorldObjectListAreaSearcher<Trinity::WorldObjectSpellTrajTargetCheck> searcher(targets, check, srcPos, dist2d, std::numeric_limits<float>::max(), GRID_MAP_TYPE_MASK_ALL);
+    SearchTargets<Trinity::WorldObjectListAreaSearcher<Trinity::WorldObjectSpellTrajTargetCheck> >(searcher, GRID_MAP_TYPE_MASK_ALL, m_caster, &srcPos, dist2d);
     if (targets.empty())
         return;
 
@@ -1986,8 +1989,34 @@ void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Pos
     if (!containerTypeMask)
         return;
     Trinity::WorldObjectSpellAreaTargetCheck check(range, position, m_caster, referer, m_spellInfo, selectionType, condList);
-    Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
-    SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> >(searcher, containerTypeMask, m_caster, position, range);
+    Trinity::WorldObjectListAreaSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(targets, check, *position, range, range, containerTypeMask);
+    SearchTargets<Trinity::WorldObjectListAreaSearcher<Trinity::WorldObjectSpellAreaTargetCheck> >(searcher, containerTypeMask, m_caster, position, range);
+}
+
+void Spell::PrefetchAreaTargetsLOS(std::list<WorldObject*> const& targets) const
+{
+    // CheckEffectTarget checks targets one by one from the spell destination, check them all at once so that it only finds results in the map collision cache
+    if (targets.size() < 2 || !m_targets.HasDst() || m_spellInfo->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS))
+        return;
+
+    Map* map = m_caster->GetMap();
+    if (!map->IsCollisionCacheEnabled())
+        return;
+
+    Position const* dst = m_targets.GetDstPos();
+    uint32 const phaseMask = m_caster->GetPhaseMask();
+    std::vector<VMAP::LineOfSightQuery> queries;
+    queries.reserve(targets.size());
+    for (WorldObject* target : targets)
+    {
+        if (!target->ToUnit() || !target->IsInWorld() || target->GetMap() != map || target->GetPhaseMask() != phaseMask)
+            continue;
+
+        queries.emplace_back();
+        target->GetLOSQuery(dst->GetPositionX(), dst->GetPositionY(), dst->GetPositionZ(), queries.back());
+    }
+
+    map->isInLineOfSight(queries, phaseMask, LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::Nothing);
 }
 
 void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, SpellTargetSelectionCategories selectCategory, ConditionContainer* condList, bool isChainHeal)
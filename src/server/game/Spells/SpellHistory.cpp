@@ -35,6 +35,8 @@ struct SpellHistory::PersistenceHelper<Player>
 {
     static CharacterDatabaseStatements const CooldownsDeleteStatement = CHAR_DEL_CHAR_SPELL_COOLDOWNS;
     static CharacterDatabaseStatements const CooldownsInsertStatement = CHAR_INS_CHAR_SPELL_COOLDOWN;
+    // only write changed cooldowns after the first save
+    static bool const IncrementalSave = true;
 
     static void SetIdentifier(PreparedStatement* stmt, uint8 index, Unit* owner) { stmt->setUInt32(index, owner->GetGUID().GetCounter()); }
 
@@ -67,6 +69,8 @@ struct SpellHistory::PersistenceHelper<Pet>
 {
     static CharacterDatabaseStatements const CooldownsDeleteStatement = CHAR_DEL_PET_SPELL_COOLDOWNS;
     static CharacterDatabaseStatements const CooldownsInsertStatement = CHAR_INS_PET_SPELL_COOLDOWN;
+    // pet rows are also rewritten by other pet saves, always rewrite all cooldowns
+    static bool const IncrementalSave = false;
 
     static void SetIdentifier(PreparedStatement* stmt, uint8 index, Unit* owner) { stmt->setUInt32(index, owner->GetCharmInfo()->GetPetNumber()); }
 
@@ -121,21 +125,55 @@ void SpellHistory::SaveToDB(SQLTransaction& trans)
     typedef PersistenceHelper<OwnerType> StatementInfo;
 
     uint8 index = 0;
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(StatementInfo::CooldownsDeleteStatement);
-    StatementInfo::SetIdentifier(stmt, index++, _owner);
-    trans->Append(stmt);
+    PreparedStatement* stmt;
+    if (StatementInfo::IncrementalSave && _cooldownsSaved)
+    {
+        // only delete cooldowns removed or changed since last save
+        for (auto itr = _savedCooldowns.begin(); itr != _savedCooldowns.end();)
+        {
+            auto current = _spellCooldowns.find(itr->first);
+            if (current != _spellCooldowns.end() && !current->second.OnHold
+                && current->second.ItemId == itr->second.ItemId
+                && current->second.CategoryId == itr->second.CategoryId
+                && Clock::to_time_t(current->second.CooldownEnd) == Clock::to_time_t(itr->second.CooldownEnd)
+                && Clock::to_time_t(current->second.CategoryEnd) == Clock::to_time_t(itr->second.CategoryEnd))
+            {
+                ++itr;
+                continue;
+            }
+
+            index = 0;
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
+            StatementInfo::SetIdentifier(stmt, index++, _owner);
+            stmt->setUInt32(index++, itr->first);
+            trans->Append(stmt);
+            itr = _savedCooldowns.erase(itr);
+        }
+    }
+    else
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(StatementInfo::CooldownsDeleteStatement);
+        StatementInfo::SetIdentifier(stmt, index++, _owner);
+        trans->Append(stmt);
+        _savedCooldowns.clear();
+    }
 
     for (auto const& p : _spellCooldowns)
     {
-        if (!p.second.OnHold)
+        if (!p.second.OnHold && !_savedCooldowns.count(p.first))
         {
             index = 0;
             stmt = CharacterDatabase.GetPreparedStatement(StatementInfo::CooldownsInsertStatement);
             StatementInfo::SetIdentifier(stmt, index++, _owner);
             StatementInfo::WriteCooldown(stmt, index, p);
             trans->Append(stmt);
+
+            if (StatementInfo::IncrementalSave)
+                _savedCooldowns[p.first] = p.second;
         }
     }
+
+    _cooldownsSaved = StatementInfo::IncrementalSave;
 }
 
 void SpellHistory::Update()
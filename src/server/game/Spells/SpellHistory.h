@@ -60,7 +60,7 @@ public:
     typedef std::unordered_map<uint32 /*categoryId*/, CooldownEntry*> CategoryCooldownStorageType;
     typedef std::unordered_map<uint32 /*categoryId*/, Clock::time_point> GlobalCooldownStorageType;
 
-    explicit SpellHistory(Unit* owner) : _owner(owner), _schoolLockouts() { }
+    explicit SpellHistory(Unit* owner) : _owner(owner), _schoolLockouts(), _cooldownsSaved(false) { }
 
     template<class OwnerType>
     void LoadFromDB(PreparedQueryResult cooldownsResult);
@@ -157,6 +157,9 @@ private:
     CategoryCooldownStorageType _categoryCooldowns;
     Clock::time_point _schoolLockouts[MAX_SPELL_SCHOOL];
     GlobalCooldownStorageType _globalCooldowns;
+    // Cooldowns as last written by SaveToDB, only kept for owners saved incrementally (see PersistenceHelper::IncrementalSave)
+    CooldownStorageType _savedCooldowns;
+    bool _cooldownsSaved;
 
     template<class T>
     struct PersistenceHelper { };
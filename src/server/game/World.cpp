@@ -37,15 +37,18 @@
 #include "VMapFactory.h"
 #include "VMapManager2.h"
 #include "MapManager.h"
+#include "GridMapPreloader.h"
 #include "Memory.h"
 #include "ObjectMgr.h"
 #include "Opcodes.h"
+#include "ParallelLoader.h"
 #include "OutdoorPvPMgr.h"
 #include "PetitionMgr.h"
 #include "Player.h"
 #include "Pet.h"
 #include "PoolMgr.h"
 #include "QueryCallback.h"
+#include "QuerySnapshotCache.h"
 #include "ScriptMgr.h"
 #include "ScriptReloadMgr.h"
 #include "SkillDiscovery.h"
@@ -615,6 +618,8 @@ void World::LoadConfigSettings(bool reload)
     }
     m_configs[CONFIG_ADDON_CHANNEL] = sConfigMgr->GetBoolDefault("AddonChannel", true);
     m_configs[CONFIG_GRID_UNLOAD] = sConfigMgr->GetBoolDefault("GridUnload", true);
+    m_configs[CONFIG_GRIDMAP_MMAP] = sConfigMgr->GetBoolDefault("GridMap.Mmap", false);
+    m_configs[CONFIG_GRIDMAP_PRELOAD] = sConfigMgr->GetBoolDefault("GridMap.Preload", false);
     m_configs[CONFIG_INTERVAL_SAVE] = sConfigMgr->GetIntDefault("PlayerSaveInterval", 60000);
     m_configs[CONFIG_INTERVAL_DISCONNECT_TOLERANCE] = sConfigMgr->GetIntDefault("DisconnectToleranceInterval", 0);
 
@@ -917,6 +922,10 @@ void World::LoadConfigSettings(bool reload)
     m_configs[CONFIG_LOG_SANCTIONS] = sConfigMgr->GetIntDefault("DBLog.sanctions", -1);
     m_configs[CONFIG_LOG_CONNECTION_IP] = sConfigMgr->GetIntDefault("DBLog.connectionip",-1);
     m_configs[CONFIG_GM_LOG_CONNECTION_IP] = sConfigMgr->GetIntDefault("DBLog.gm.connectionip", -1);
+    m_configs[CONFIG_DBLOG_BUFFER] = sConfigMgr->GetBoolDefault("DBLog.Buffer.Enable", true);
+    m_configs[CONFIG_DBLOG_BUFFER_FLUSH_INTERVAL] = std::max(1, sConfigMgr->GetIntDefault("DBLog.Buffer.FlushInterval", 1000));
+    m_configs[CONFIG_DBLOG_BUFFER_FLUSH_SIZE] = std::max(1, sConfigMgr->GetIntDefault("DBLog.Buffer.FlushSize", 500));
+    m_configs[CONFIG_DBLOG_BUFFER_MAX_SIZE] = std::max(int32(m_configs[CONFIG_DBLOG_BUFFER_FLUSH_SIZE]), sConfigMgr->GetIntDefault("DBLog.Buffer.MaxSize", 20000));
 
     m_configs[CONFIG_MAIL_DELIVERY_DELAY] = sConfigMgr->GetIntDefault("MailDeliveryDelay",HOUR);
 
@@ -1196,6 +1205,14 @@ void World::LoadConfigSettings(bool reload)
     TC_LOG_INFO("server.loading", "WORLD: VMap support included. LineOfSight:%i, getHeight:%i",enableLOS, enableHeight);
     TC_LOG_INFO("server.loading", "WORLD: VMap data directory is: %svmaps",m_dataPath.c_str());
 
+    m_configs[CONFIG_VMAP_CACHE_SIZE] = sConfigMgr->GetIntDefault("vmap.cacheSize", 8192);
+    rate_values[RATE_VMAP_CACHE_PRECISION] = sConfigMgr->GetFloatDefault("vmap.cachePrecision", 0.05f);
+    if (rate_values[RATE_VMAP_CACHE_PRECISION] <= 0.0f)
+    {
+        TC_LOG_ERROR("server.loading", "vmap.cachePrecision (%f) must be > 0. Using 0.05 instead.", rate_values[RATE_VMAP_CACHE_PRECISION]);
+        rate_values[RATE_VMAP_CACHE_PRECISION] = 0.05f;
+    }
+
     m_configs[CONFIG_PREMATURE_BG_REWARD] = sConfigMgr->GetBoolDefault("Battleground.PrematureReward", true);
     m_configs[CONFIG_START_ALL_EXPLORED] = sConfigMgr->GetBoolDefault("PlayerStart.MapsExplored", false);
     m_configs[CONFIG_START_ALL_REP] = sConfigMgr->GetBoolDefault("PlayerStart.AllReputation", false);
@@ -1251,6 +1268,8 @@ void World::LoadConfigSettings(bool reload)
         TC_LOG_ERROR("server.loading", "Monitor.DynamicViewDist.AverageCount must be greater than 0. Setting it to default value (500)");
         m_configs[CONFIG_MONITORING_DYNAMIC_VIEWDIST_AVERAGE_COUNT] = 500;
     }
+    m_configs[CONFIG_MONITORING_MAP_PHASES] = sConfigMgr->GetBoolDefault("Monitor.MapPhases.Enable", false);
+    m_configs[CONFIG_MONITORING_MAP_PHASES_EXPORT_INTERVAL] = sConfigMgr->GetIntDefault("Monitor.MapPhases.ExportInterval", 0);
 
 
     std::string forbiddenmaps = sConfigMgr->GetStringDefault("ForbiddenMaps", "");
@@ -1267,6 +1286,11 @@ void World::LoadConfigSettings(bool reload)
     }
     delete[] forbiddenMaps;
 
+    m_parallelRegionsMapIds.clear();
+    Tokenizer parallelRegionsMaps(sConfigMgr->GetStringDefault("MapUpdate.ParallelRegions.Maps", ""), ',');
+    for (char const* token : parallelRegionsMaps)
+        m_parallelRegionsMapIds.insert(uint32(strtoul(token, nullptr, 10)));
+
     m_configs[CONFIG_AUTOANNOUNCE_ENABLED] = sConfigMgr->GetBoolDefault("AutoAnnounce.Enable", false);
 
     // warden
@@ -1431,6 +1455,12 @@ void World::SetInitialWorldSettings()
     ///- Initialize pool manager
     sPoolMgr->Initialize();
 
+    // Threads used to run independent loading steps concurrently
+    uint32 const loadingThreads = std::max(1, sConfigMgr->GetIntDefault("ParallelLoading.Threads", 4));
+
+    ///- Snapshots of the biggest static tables, rebuilt whenever their content or the world database version changes
+    sQuerySnapshotCache->Initialize(sConfigMgr->GetStringDefault("QuerySnapshot.Dir", ""), m_DBVersion);
+
     ///- Loading strings. Getting no records means core load has to be canceled because no error message can be output.
     TC_LOG_INFO("server.loading", "Loading Trinity strings..." );
     if (!sObjectMgr->LoadTrinityStrings())
@@ -1462,6 +1492,8 @@ void World::SetInitialWorldSettings()
 
     MMAP::MMapManager* mmmgr = MMAP::MMapFactory::createOrGetMMapManager();
     mmmgr->InitializeThreadUnsafe(mapIds);
+    if (sConfigMgr->GetBoolDefault("mmap.asyncTileLoading", false))
+        mmmgr->StartTileLoader();
 
     TC_LOG_INFO("server.loading","Loading Item Extended Cost Data...");
     sObjectMgr->LoadItemExtendedCost();
@@ -1529,30 +1561,28 @@ void World::SetInitialWorldSettings()
 //    TC_LOG_INFO("server.loading", "Packing instances..." );
 //    sInstanceSaveMgr->PackInstances();
 
-    TC_LOG_INFO("server.loading", "Loading Broadcast texts...");
-    sObjectMgr->LoadBroadcastTexts();
-    sObjectMgr->LoadBroadcastTextLocales();
-
-    TC_LOG_INFO("server.loading", "Loading Localization strings..." );
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadGossipTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadQuestGreetingsLocales();
+    {
+        TC_LOG_INFO("server.loading", "Loading Broadcast texts, Localization strings, Page Texts and NPC Texts...");
+        ParallelLoader loader;
+        ParallelLoader::StepId broadcastTexts = loader.Add("Broadcast texts", [] { sObjectMgr->LoadBroadcastTexts(); });
+        ParallelLoader::StepId broadcastTextLocales = loader.Add("Broadcast text locales", [] { sObjectMgr->LoadBroadcastTextLocales(); }, { broadcastTexts });
+        loader.Add("Creature locales", [] { sObjectMgr->LoadCreatureLocales(); });
+        loader.Add("Gameobject locales", [] { sObjectMgr->LoadGameObjectLocales(); });
+        loader.Add("Item locales", [] { sObjectMgr->LoadItemLocales(); });
+        loader.Add("Quest locales", [] { sObjectMgr->LoadQuestLocales(); });
+        loader.Add("NPC text locales", [] { sObjectMgr->LoadGossipTextLocales(); });
+        loader.Add("Page text locales", [] { sObjectMgr->LoadPageTextLocales(); });
+        loader.Add("Gossip menu items locales", [] { sObjectMgr->LoadGossipMenuItemsLocales(); });
+        loader.Add("Quest greetings locales", [] { sObjectMgr->LoadQuestGreetingsLocales(); });
+        loader.Add("Page texts", [] { sObjectMgr->LoadPageTexts(); });
+        loader.Add("NPC texts", [] { sObjectMgr->LoadGossipText(); }, { broadcastTextLocales });
+        loader.Run(loadingThreads);
+    }
     sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
 
-    TC_LOG_INFO("server.loading", "Loading Page Texts..." );
-    sObjectMgr->LoadPageTexts();
-
     TC_LOG_INFO("server.loading", "Loading Game Object Templates..." );   // must be after LoadPageTexts
     sObjectMgr->LoadGameObjectTemplate();
 
-    TC_LOG_INFO("server.loading", "Loading NPC Texts..." );
-    sObjectMgr->LoadGossipText();
-
     TC_LOG_INFO("server.loading", "Loading Enchant Spells Proc datas...");
     sSpellMgr->LoadSpellEnchantProcData();
 
@@ -1592,25 +1622,22 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading instance spawn groups...");
     sObjectMgr->LoadInstanceSpawnGroups();
 
-    if(!getConfig(CONFIG_DEBUG_DISABLE_CREATURES_LOADING))
     {
-        TC_LOG_INFO("server.loading", "Loading Creature Data..." );
-        sObjectMgr->LoadCreatures();
-
-        TC_LOG_INFO("server.loading", "Loading Creature Addon Data..." );
-        sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
+        TC_LOG_INFO("server.loading", "Loading Creature, Temporary Summon and Gameobject Data...");
+        ParallelLoader loader;
+        if (!getConfig(CONFIG_DEBUG_DISABLE_CREATURES_LOADING))
+        {
+            ParallelLoader::StepId creatures = loader.Add("Creature data", [] { sObjectMgr->LoadCreatures(); });
+            loader.Add("Creature addon data", [] { sObjectMgr->LoadCreatureAddons(); }, { creatures });                          // must be after LoadCreatureTemplates() and LoadCreatures()
+            loader.Add("Creature movement overrides", [] { sObjectMgr->LoadCreatureMovementOverrides(); }, { creatures });      // must be after LoadCreatures()
+        }
 
-        TC_LOG_INFO("server.loading", "Loading Creature Movement Overrides...");
-        sObjectMgr->LoadCreatureMovementOverrides();                 // must be after LoadCreatures()
-    }
+        loader.Add("Temporary summon data", [] { sObjectMgr->LoadTempSummons(); });   // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
 
-    TC_LOG_INFO("server.loading", "Loading Temporary Summon Data...");
-    sObjectMgr->LoadTempSummons();                               // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
+        if (!getConfig(CONFIG_DEBUG_DISABLE_GAMEOBJECTS_LOADING))
+            loader.Add("Gameobject data", [] { sObjectMgr->LoadGameObjects(); });
 
-    if (!getConfig(CONFIG_DEBUG_DISABLE_GAMEOBJECTS_LOADING))
-    {
-        TC_LOG_INFO("server.loading", "Loading Gameobject Data...");
-        sObjectMgr->LoadGameObjects();
+        loader.Run(loadingThreads);
     }
 
     TC_LOG_INFO("server.loading", "Loading Spawn Group Data...");
@@ -1703,17 +1730,26 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading Disabled Spells..." );
     sObjectMgr->LoadSpellDisabledEntrys();
 
-    TC_LOG_INFO("server.loading", "Loading Loot Tables..." );
-    LoadLootTables();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Discovery Table..." );
-    LoadSkillDiscoveryTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Extra Item Table..." );
-    LoadSkillExtraItemTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Fishing base level requirements..." );
-    sObjectMgr->LoadFishingBaseSkillLevel();
+    {
+        TC_LOG_INFO("server.loading", "Loading Loot Tables, Skill Discovery, Skill Extra Item and Skill Fishing base level requirements...");
+        ParallelLoader loader;
+        std::initializer_list<ParallelLoader::StepId> lootStores =
+        {
+            loader.Add("Creature loot", [] { LoadLootTemplates_Creature(); }),
+            loader.Add("Fishing loot", [] { LoadLootTemplates_Fishing(); }),
+            loader.Add("Gameobject loot", [] { LoadLootTemplates_Gameobject(); }),
+            loader.Add("Item loot", [] { LoadLootTemplates_Item(); }),
+            loader.Add("Pickpocketing loot", [] { LoadLootTemplates_Pickpocketing(); }),
+            loader.Add("Skinning loot", [] { LoadLootTemplates_Skinning(); }),
+            loader.Add("Disenchant loot", [] { LoadLootTemplates_Disenchant(); }),
+            loader.Add("Prospecting loot", [] { LoadLootTemplates_Prospecting(); }),
+        };
+        loader.Add("Reference loot", [] { LoadLootTemplates_Reference(); }, lootStores); // checks references from all other loot stores
+        loader.Add("Skill discovery", [] { LoadSkillDiscoveryTable(); });
+        loader.Add("Skill extra items", [] { LoadSkillExtraItemTable(); });
+        loader.Add("Fishing base skill levels", [] { sObjectMgr->LoadFishingBaseSkillLevel(); });
+        loader.Run(loadingThreads);
+    }
 
     ///- Load dynamic data tables from the database
     TC_LOG_INFO("server.loading", "Loading Auctions..." );
@@ -1872,6 +1908,8 @@ void World::SetInitialWorldSettings()
     ///- Initialize MapManager
     TC_LOG_INFO("server.loading", "Starting Map System...");
     sMapMgr->Initialize();
+    if (getBoolConfig(CONFIG_GRIDMAP_PRELOAD))
+        sGridMapPreloader->Start();
 
     // Load Warden Data
     TC_LOG_INFO("server.loading","Loading Warden Data...");
@@ -83,6 +83,8 @@ enum WorldConfigs
 {
     CONFIG_COMPRESSION = 0,
     CONFIG_GRID_UNLOAD,
+    CONFIG_GRIDMAP_MMAP,
+    CONFIG_GRIDMAP_PRELOAD,
     CONFIG_INTERVAL_SAVE,
     CONFIG_INTERVAL_MAPUPDATE,
     CONFIG_INTERVAL_CHANGEWEATHER,
@@ -275,6 +277,10 @@ enum WorldConfigs
     CONFIG_LOG_SANCTIONS,
     CONFIG_LOG_CONNECTION_IP,
     CONFIG_GM_LOG_CONNECTION_IP,
+    CONFIG_DBLOG_BUFFER,
+    CONFIG_DBLOG_BUFFER_FLUSH_INTERVAL,
+    CONFIG_DBLOG_BUFFER_FLUSH_SIZE,
+    CONFIG_DBLOG_BUFFER_MAX_SIZE,
 
     CONFIG_MYSQL_BUNDLE_LOGINDB,
     CONFIG_MYSQL_BUNDLE_CHARDB,
@@ -369,6 +375,8 @@ enum WorldConfigs
     CONFIG_MONITORING_DYNAMIC_VIEWDIST_AVERAGE_COUNT,
 
 	CONFIG_MONITORING_LAG_AUTO_REBOOT_COUNT,
+	CONFIG_MONITORING_MAP_PHASES,
+	CONFIG_MONITORING_MAP_PHASES_EXPORT_INTERVAL,
 
     CONFIG_HOTSWAP_ENABLED,
     CONFIG_HOTSWAP_RECOMPILER_ENABLED,
@@ -381,6 +389,8 @@ enum WorldConfigs
 
     CONFIG_CACHE_DATA_QUERIES,
 
+    CONFIG_VMAP_CACHE_SIZE,
+
     CONFIG_VALUE_COUNT,
 };
 
@@ -423,6 +433,7 @@ enum Rates
     RATE_CORPSE_DECAY_LOOTED,
     RATE_INSTANCE_RESET_TIME,
     RATE_TARGET_POS_RECALCULATION_RANGE,
+    RATE_VMAP_CACHE_PRECISION,
     RATE_DURABILITY_LOSS_DAMAGE,
     RATE_DURABILITY_LOSS_PARRY,
     RATE_DURABILITY_LOSS_ABSORB,
@@ -696,6 +707,8 @@ class TC_GAME_API World
 
 
         bool IsAllowedMap(uint32 mapid) { return m_forbiddenMapIds.count(mapid) == 0 ;}
+        // see MapUpdate.ParallelRegions.Maps config
+        bool IsParallelRegionsUpdateMap(uint32 mapid) const { return m_parallelRegionsMapIds.count(mapid) != 0; }
 
         // for max speed access
         static float GetMaxVisibleDistanceOnContinents()    { return m_MaxVisibleDistanceOnContinents; }
@@ -802,6 +815,7 @@ class TC_GAME_API World
         std::string m_motd;
         std::string m_dataPath;
         std::set<uint32> m_forbiddenMapIds;
+        std::set<uint32> m_parallelRegionsMapIds;
 
         void LoadCustomFFAZones();
         std::set<uint32> configFFAZones;
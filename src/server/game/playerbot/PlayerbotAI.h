@@ -3,6 +3,7 @@
 
 #include "PlayerbotMgr.h"
 #include "PlayerbotAIBase.h"
+#include "PlayerbotScheduler.h"
 #include "strategy/AiObjectContext.h"
 #include "strategy/Engine.h"
 #include "strategy/ExternalEventHelper.h"
@@ -178,6 +179,7 @@ public:
     bool IsOpposing(Player* player);
     static bool IsOpposing(uint8 race1, uint8 race2);
     PlayerbotSecurity* GetSecurity() { return &security; }
+    PlayerbotScheduleState& GetScheduleState() { return scheduleState; }
 
 protected:
     Player* bot;
@@ -194,6 +196,7 @@ protected:
     PacketHandlingHelper masterOutgoingPacketHandlers;
     CompositeChatFilter chatFilter;
     PlayerbotSecurity security;
+    PlayerbotScheduleState scheduleState;
 };
 
 class TC_GAME_API PlayerbotTestingAI : public PlayerbotAI
@@ -73,6 +73,9 @@ bool PlayerbotAIConfig::Initialize()
     randomBotMaxLevelChance = config.GetFloatDefault("AiPlayerbot.RandomBotMaxLevelChance", 0.4);
 
     iterationsPerTick = config.GetIntDefault("AiPlayerbot.IterationsPerTick", 4);
+    mapUpdateBudget = config.GetIntDefault("AiPlayerbot.MapUpdateBudget", 10000);
+    idleUpdateInterval = config.GetIntDefault("AiPlayerbot.IdleUpdateInterval", 2000);
+    priorityDistance = config.GetFloatDefault("AiPlayerbot.PriorityDistance", 150.0f);
 
     allowGuildBots = config.GetBoolDefault("AiPlayerbot.AllowGuildBots", true);
 
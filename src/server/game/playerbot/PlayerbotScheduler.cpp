@@ -0,0 +1,151 @@
+#include "playerbot.h"
+#include "PlayerbotAIConfig.h"
+#include "PlayerbotScheduler.h"
+#include "Map.h"
+#include <chrono>
+
+// How often the priority of a bot is computed again
+static uint32 const PRIORITY_CHECK_INTERVAL = 1000;
+// Bounds of the minimum wait when the budget is exceeded
+static uint32 const MIN_WAIT_STEP = 50;
+static uint32 const MIN_WAIT_MAX = 10000;
+
+void PlayerbotScheduler::UpdateAI(Player* bot, PlayerbotAI* ai, uint32 elapsed)
+{
+    uint32 const budget = sPlayerbotAIConfig.mapUpdateBudget;
+    if (!budget)
+    {
+        ai->UpdateAI(elapsed);
+        return;
+    }
+
+    PlayerbotScheduleState& state = ai->GetScheduleState();
+    state.pendingElapsed += elapsed;
+
+    if (state.priorityTimer <= elapsed)
+    {
+        state.priority = ComputePriority(bot, ai);
+        state.priorityTimer = PRIORITY_CHECK_INTERVAL;
+    }
+    else
+        state.priorityTimer -= elapsed;
+
+    if (state.priority == PLAYERBOT_SCHEDULE_ALWAYS)
+    {
+        Run(ai, state);
+        return;
+    }
+
+    if (state.priority == PLAYERBOT_SCHEDULE_IDLE && state.pendingElapsed < sPlayerbotAIConfig.idleUpdateInterval)
+    {
+        ++_throttled;
+        return;
+    }
+
+    MapBudget& mapBudget = GetMapBudget(bot);
+    uint32 const frame = bot->GetMap()->GetGameTimeMS();
+    uint32 lastFrame = mapBudget.frame;
+    // Only the first thread to see the new update resets the budget
+    if (lastFrame != frame && mapBudget.frame.compare_exchange_strong(lastFrame, frame))
+    {
+        // Additive increase while bots do not fit in the budget, halved as soon as they do
+        if (mapBudget.exceeded.exchange(false))
+        {
+            mapBudget.minWait = std::min(mapBudget.minWait + MIN_WAIT_STEP, MIN_WAIT_MAX);
+            ++_budgetExceeded;
+        }
+        else
+            mapBudget.minWait = mapBudget.minWait / 2;
+
+        mapBudget.spent = 0;
+    }
+
+    uint32 const wait = state.priority == PLAYERBOT_SCHEDULE_HIGH ? state.pendingElapsed * 4 : state.pendingElapsed;
+    if (mapBudget.exceeded || wait < mapBudget.minWait)
+    {
+        ++_delayed;
+        return;
+    }
+
+    std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+    Run(ai, state);
+    uint32 const spent = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    if (mapBudget.spent.fetch_add(spent) + spent >= budget)
+        mapBudget.exceeded = true;
+}
+
+void PlayerbotScheduler::Run(PlayerbotAI* ai, PlayerbotScheduleState& state)
+{
+    ai->UpdateAI(state.pendingElapsed);
+    state.pendingElapsed = 0;
+    ++_updated;
+}
+
+PlayerbotSchedulePriority PlayerbotScheduler::ComputePriority(Player* bot, PlayerbotAI* ai)
+{
+    // Tests expect bots to act on each update
+    if (bot->IsTestingBot())
+        return PLAYERBOT_SCHEDULE_ALWAYS;
+
+    if (bot->IsInCombat())
+        return PLAYERBOT_SCHEDULE_HIGH;
+
+    Player* master = ai->GetMaster();
+    if (master && master != bot && !master->GetPlayerbotAI())
+        return PLAYERBOT_SCHEDULE_HIGH;
+
+    float const distance = sPlayerbotAIConfig.priorityDistance;
+    Map::PlayerList const& players = bot->GetMap()->GetPlayers();
+    for (Map::PlayerList::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+    {
+        Player* player = itr->GetSource();
+        if (player && !player->GetPlayerbotAI() && bot->IsWithinDistInMap(player, distance))
+            return PLAYERBOT_SCHEDULE_HIGH;
+    }
+
+    if (bot->GetGroup() || !bot->IsAlive())
+        return PLAYERBOT_SCHEDULE_NORMAL;
+
+    return PLAYERBOT_SCHEDULE_IDLE;
+}
+
+PlayerbotScheduler::MapBudget& PlayerbotScheduler::GetMapBudget(Player* bot)
+{
+    uint64 const key = MakeBudgetKey(bot->GetMapId(), bot->GetInstanceId());
+
+    // A thread updates one map at a time, most calls are for the same map as the previous one
+    thread_local uint64 lastKey = 0;
+    thread_local std::shared_ptr<MapBudget> lastBudget;
+    if (lastBudget && lastKey == key && !lastBudget->removed)
+        return *lastBudget;
+
+    std::lock_guard<std::mutex> guard(_budgetsLock);
+    std::shared_ptr<MapBudget>& budget = _budgets[key];
+    if (!budget)
+        budget = std::make_shared<MapBudget>();
+
+    lastKey = key;
+    lastBudget = budget;
+    return *lastBudget;
+}
+
+void PlayerbotScheduler::RemoveMapBudget(uint32 mapId, uint32 instanceId)
+{
+    std::lock_guard<std::mutex> guard(_budgetsLock);
+    auto itr = _budgets.find(MakeBudgetKey(mapId, instanceId));
+    if (itr == _budgets.end())
+        return;
+
+    itr->second->removed = true;
+    _budgets.erase(itr);
+}
+
+PlayerbotScheduler::Stats PlayerbotScheduler::GetStats() const
+{
+    Stats stats;
+    stats.updated = _updated;
+    stats.throttled = _throttled;
+    stats.delayed = _delayed;
+    stats.budgetExceeded = _budgetExceeded;
+    return stats;
+}
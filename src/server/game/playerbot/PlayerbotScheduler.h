@@ -0,0 +1,76 @@
+#ifndef _PLAYERBOTSCHEDULER_H
+#define _PLAYERBOTSCHEDULER_H
+
+#include "Common.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+class Player;
+class PlayerbotAI;
+
+enum PlayerbotSchedulePriority : uint8
+{
+    PLAYERBOT_SCHEDULE_IDLE,        // no real player around, not in combat: only updated every idleUpdateInterval
+    PLAYERBOT_SCHEDULE_NORMAL,
+    PLAYERBOT_SCHEDULE_HIGH,        // in combat, near or grouped with a real player: catches up first when the budget is short
+    PLAYERBOT_SCHEDULE_ALWAYS,      // testing bots, never delayed
+};
+
+// Scheduling data kept in each bot AI
+struct PlayerbotScheduleState
+{
+    uint32 pendingElapsed = 0;      // time since the AI last ran, given to it when it runs again
+    uint32 priorityTimer = 0;
+    PlayerbotSchedulePriority priority = PLAYERBOT_SCHEDULE_NORMAL;
+};
+
+/* Bots AI updates are run from their map update. Each map has a time budget per update for all its bots,
+once spent the other bots wait for the next updates of the map. When the budget is regularly exceeded, only bots
+which waited long enough are run, high priority bots waiting less than others. */
+class TC_GAME_API PlayerbotScheduler
+{
+public:
+    struct Stats
+    {
+        uint64 updated;
+        uint64 throttled;           // idle bots waiting for their interval
+        uint64 delayed;             // bots waiting for budget
+        uint64 budgetExceeded;      // map updates where the budget was spent
+    };
+
+    // Called instead of ai->UpdateAI(elapsed) on each update of the bot
+    void UpdateAI(Player* bot, PlayerbotAI* ai, uint32 elapsed);
+
+    // Called when a map is unloaded
+    void RemoveMapBudget(uint32 mapId, uint32 instanceId);
+
+    Stats GetStats() const;
+
+private:
+    // Bots of a map can be updated by several threads at once (see MapUpdate.ParallelRegions), the budget is shared by all of them
+    struct MapBudget
+    {
+        std::atomic<uint32> frame{ 0 };         // map game time of the update being budgeted
+        std::atomic<uint32> spent{ 0 };         // microseconds
+        std::atomic<bool> exceeded{ false };
+        std::atomic<uint32> minWait{ 0 };       // ms a bot must have waited to run, raised while the budget is exceeded
+        std::atomic<bool> removed{ false };     // map was unloaded, budget is only kept alive by thread caches
+    };
+
+    void Run(PlayerbotAI* ai, PlayerbotScheduleState& state);
+    static PlayerbotSchedulePriority ComputePriority(Player* bot, PlayerbotAI* ai);
+    MapBudget& GetMapBudget(Player* bot);
+    static uint64 MakeBudgetKey(uint32 mapId, uint32 instanceId) { return (uint64(mapId) << 32) | instanceId; }
+
+    std::mutex _budgetsLock;
+    std::unordered_map<uint64, std::shared_ptr<MapBudget>> _budgets; // (map id, instance id)
+
+    std::atomic<uint64> _updated{ 0 };
+    std::atomic<uint64> _throttled{ 0 };
+    std::atomic<uint64> _delayed{ 0 };
+    std::atomic<uint64> _budgetExceeded{ 0 };
+};
+
+#endif
@@ -755,6 +755,10 @@ void RandomPlayerbotMgr::PrintStats()
 {
     sLog->outMessage("playerbot", LOG_LEVEL_INFO, "%d Random Bots online", playerBots.size());
 
+    PlayerbotScheduler::Stats const schedulerStats = scheduler.GetStats();
+    sLog->outMessage("playerbot", LOG_LEVEL_INFO, "AI updates: " UI64FMTD " run, " UI64FMTD " idle throttled, " UI64FMTD " delayed by map budget (exceeded " UI64FMTD " times)",
+        schedulerStats.updated, schedulerStats.throttled, schedulerStats.delayed, schedulerStats.budgetExceeded);
+
     map<uint32, int> alliance, horde;
     for (uint32 i = 0; i < 10; ++i)
     {
@@ -4,6 +4,7 @@
 #include "Common.h"
 #include "PlayerbotAIBase.h"
 #include "PlayerbotMgr.h"
+#include "PlayerbotScheduler.h"
 
 class WorldLocation;
 class WorldPacket;
@@ -48,6 +49,8 @@ class TC_GAME_API RandomPlayerbotMgr : public PlayerbotHolder
         uint32 GetTradeDiscount(Player* bot);
         void Refresh(Player* bot);
         void RandomTeleportForLevel(Player* bot);
+        // Runs the AI of all bots, random or not
+        PlayerbotScheduler& GetScheduler() { return scheduler; }
 
     protected:
         void OnBotLoginInternal(Player * const bot) override {}
@@ -67,6 +70,7 @@ class TC_GAME_API RandomPlayerbotMgr : public PlayerbotHolder
     private:
         vector<Player*> players;
         int processTicks;
+        PlayerbotScheduler scheduler;
 };
 
 //extra ifdef to make sure we don't try to include the playerbot mgr if playerbot are disabled
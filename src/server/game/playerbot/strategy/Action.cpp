@@ -17,6 +17,9 @@ ActionList NextAction::clone(ActionList actions)
 
 ActionList NextAction::merge(ActionList left, ActionList right)
 {
+    if (right.empty())
+        return left;
+
     int leftSize = left.size();
     int rightSize = right.size();
 
@@ -2,6 +2,7 @@
 #include "Event.h"
 #include "Value.h"
 #include "AiObject.h"
+#include "NamedObjectIds.h"
 
 namespace ai
 {
@@ -14,16 +15,19 @@ namespace ai
         NextAction(std::string const name, float relevance = 0.0f)
         {
             this->name = name;
+            this->id = NamedObjectIds::GetId(name);
             this->relevance = relevance;
         }
         explicit NextAction(std::string const name, int relevance)
         {
             this->name = name;
+            this->id = NamedObjectIds::GetId(name);
             this->relevance = float(relevance);
         }
         NextAction(const NextAction& o)
         {
             this->name = o.name;
+            this->id = o.id;
             this->relevance = o.relevance;
         }
         ~NextAction()
@@ -31,7 +35,8 @@ namespace ai
         }
 
     public:
-        std::string getName() { return name; }
+        std::string const& getName() const { return name; }
+        NameId getId() const { return id; }
         float getRelevance() {return relevance;}
 
     public:
@@ -44,6 +49,7 @@ namespace ai
     private:
         float relevance;
         std::string name;
+        NameId id;
     };
 
     //---------------------------------------------------------------------------------------------------------------------
@@ -89,6 +95,7 @@ namespace ai
         {
             this->action = nullptr;
             this->name = name;
+            this->id = NamedObjectIds::GetId(name);
             this->prerequisites = prerequisites;
             this->alternatives = alternatives;
             this->continuers = continuers;
@@ -101,17 +108,20 @@ namespace ai
         }
 
     public:
-        std::shared_ptr<Action> getAction() { return action; }
+        std::shared_ptr<Action> const& getAction() const { return action; }
         void setAction(std::shared_ptr<Action> _action) { action = _action; }
-        std::string getName() { return name; }
+        std::string const& getName() const { return name; }
+        NameId getId() const { return id; }
 
     public:
-        ActionList getContinuers() { return NextAction::merge(NextAction::clone(continuers), action->getContinuers()); }
-        ActionList getAlternatives() { return NextAction::merge(NextAction::clone(alternatives), action->getAlternatives()); }
-        ActionList getPrerequisites() { return NextAction::merge(NextAction::clone(prerequisites), action->getPrerequisites()); }
+        // NextAction are never modified once created, the lists can share them
+        ActionList getContinuers() { return NextAction::merge(continuers, action->getContinuers()); }
+        ActionList getAlternatives() { return NextAction::merge(alternatives, action->getAlternatives()); }
+        ActionList getPrerequisites() { return NextAction::merge(prerequisites, action->getPrerequisites()); }
 
     private:
         std::string name;
+        NameId id;
         std::shared_ptr<Action> action;
         ActionList continuers;
         ActionList alternatives;
@@ -145,5 +155,6 @@ namespace ai
 
 }
 
-#define AI_VALUE(type, name) context->GetValue<type>(name)->Get()
-#define AI_VALUE2(type, name, param) context->GetValue<type>(name, param)->Get()
+// name must be a string literal, use context->GetValue for names built at runtime
+#define AI_VALUE(type, name) context->GetValue<type>(AI_NAME_ID(name))->Get()
+#define AI_VALUE2(type, name, param) context->GetValue<type>(AI_NAME_ID(name), param)->Get()
@@ -21,23 +21,44 @@ namespace ai
         virtual std::shared_ptr<Action> GetAction(std::string name) { return actionContexts.GetObject(name, ai); }
         virtual std::shared_ptr<UntypedValue> GetUntypedValue(std::string name) { return valueContexts.GetObject(name, ai); }
 
+        std::shared_ptr<Trigger> const& GetTrigger(NameId id) { return triggerContexts.GetObject(id, ai); }
+        std::shared_ptr<Action> const& GetAction(NameId id) { return actionContexts.GetObject(id, ai); }
+        std::shared_ptr<UntypedValue> const& GetUntypedValue(NameId id) { return valueContexts.GetObject(id, ai); }
+
+        template<class T>
+        std::shared_ptr<Value<T>> GetValue(NameId id)
+        {
+            return std::dynamic_pointer_cast<Value<T>>(GetUntypedValue(id));
+        }
+
+        template<class T>
+        std::shared_ptr<Value<T>> GetValue(std::string const& name)
+        {
+            return GetValue<T>(NamedObjectIds::GetId(name));
+        }
+
+        template<class T>
+        std::shared_ptr<Value<T>> GetValue(NameId id, std::string const& param)
+        {
+            return GetValue<T>(NamedObjectIds::GetId(id, param));
+        }
+
         template<class T>
-        std::shared_ptr<Value<T>> GetValue(std::string name)
+        std::shared_ptr<Value<T>> GetValue(std::string const& name, std::string const& param)
         {
-            return std::dynamic_pointer_cast<Value<T>>(GetUntypedValue(name));
+            return GetValue<T>(NamedObjectIds::GetId(name), param);
         }
 
         template<class T>
-        std::shared_ptr<Value<T>> GetValue(std::string name, std::string param)
+        std::shared_ptr<Value<T>> GetValue(NameId id, uint32 param)
         {
-            return GetValue<T>((string(name) + "::" + param));
+            return GetValue<T>(id, std::to_string(param));
         }
 
         template<class T>
-        std::shared_ptr<Value<T>> GetValue(std::string name, uint32 param)
+        std::shared_ptr<Value<T>> GetValue(std::string const& name, uint32 param)
         {
-            std::ostringstream out; out << param;
-            return GetValue<T>(name, out.str());
+            return GetValue<T>(NamedObjectIds::GetId(name), std::to_string(param));
         }
 
         set<std::string> GetSupportedStrategies()
@@ -69,6 +69,8 @@ void Engine::Reset()
     queue.Clear();
     triggers.clear();
     multipliers.clear();
+    actionNodes.clear();
+    defaultActions.clear();
 }
 
 void Engine::Init()
@@ -80,8 +82,10 @@ void Engine::Init()
         std::shared_ptr<Strategy> strategy = i->second;
         strategy->InitMultipliers(multipliers);
         strategy->InitTriggers(triggers);
+        ActionList strategyDefaultActions = strategy->getDefaultActions();
         Event emptyEvent;
-        MultiplyAndPush(strategy->getDefaultActions(), 0.0f, false, emptyEvent);
+        MultiplyAndPush(strategyDefaultActions, 0.0f, false, emptyEvent);
+        defaultActions.insert(defaultActions.end(), strategyDefaultActions.begin(), strategyDefaultActions.end());
     }
 
     if (testMode)
@@ -129,7 +133,7 @@ bool Engine::DoNextAction(Unit* unit, int depth)
             {
                 for (list<std::shared_ptr<Multiplier>>::iterator i = multipliers.begin(); i!= multipliers.end(); i++)
                 {
-                    std::shared_ptr<Multiplier> multiplier = *i;
+                    std::shared_ptr<Multiplier> const& multiplier = *i;
                     relevance *= multiplier->GetValue(action);
                     if (!relevance)
                     {
@@ -195,6 +199,15 @@ bool Engine::DoNextAction(Unit* unit, int depth)
     return actionExecuted;
 }
 
+std::shared_ptr<ActionNode> Engine::CreateActionNode(NextAction const& nextAction)
+{
+    std::shared_ptr<ActionNode>& node = actionNodes[nextAction.getId()];
+    if (!node)
+        node = CreateActionNode(nextAction.getName());
+
+    return node;
+}
+
 std::shared_ptr<ActionNode> Engine::CreateActionNode(std::string name)
 {
     for (auto i = strategies.begin(); i != strategies.end(); i++)
@@ -210,14 +223,14 @@ std::shared_ptr<ActionNode> Engine::CreateActionNode(std::string name)
         /*C*/ ActionList());
 }
 
-bool Engine::MultiplyAndPush(ActionList actions, float forceRelevance, bool skipPrerequisites, Event event)
+bool Engine::MultiplyAndPush(ActionList const& actions, float forceRelevance, bool skipPrerequisites, Event event)
 {
     bool pushed = false;
     if (!actions.empty())
     {
         for(auto& nextAction : actions)
         {
-            std::shared_ptr<ActionNode> action = CreateActionNode(nextAction->getName());
+            std::shared_ptr<ActionNode> action = CreateActionNode(*nextAction);
             InitializeAction(action.get());
 
             float k = nextAction->getRelevance();
@@ -233,7 +246,6 @@ bool Engine::MultiplyAndPush(ActionList actions, float forceRelevance, bool skip
                 pushed = true;
             }
         }
-        actions.clear();
     }
     return pushed;
 }
@@ -319,14 +331,14 @@ void Engine::ProcessTriggers()
 {
     for (list<std::shared_ptr<TriggerNode>>::iterator i = triggers.begin(); i != triggers.end(); i++)
     {
-        std::shared_ptr<TriggerNode> node = *i;
+        std::shared_ptr<TriggerNode> const& node = *i;
         if (!node)
             continue;
 
         std::shared_ptr<Trigger> trigger = node->getTrigger();
         if (!trigger)
         {
-            trigger = aiObjectContext->GetTrigger(node->getName());
+            trigger = aiObjectContext->GetTrigger(node->getId());
             node->setTrigger(trigger);
         }
 
@@ -345,7 +357,7 @@ void Engine::ProcessTriggers()
     }
     for (list<std::shared_ptr<TriggerNode>>::iterator i = triggers.begin(); i != triggers.end(); i++)
     {
-        std::shared_ptr<Trigger> trigger = (*i)->getTrigger();
+        std::shared_ptr<Trigger> const& trigger = (*i)->getTrigger();
         if (trigger) 
             trigger->Reset();
     }
@@ -353,12 +365,8 @@ void Engine::ProcessTriggers()
 
 void Engine::PushDefaultActions()
 {
-    for (auto i = strategies.begin(); i != strategies.end(); i++)
-    {
-        std::shared_ptr<Strategy> strategy = i->second;
-        Event emptyEvent;
-        MultiplyAndPush(strategy->getDefaultActions(), 0.0f, false, emptyEvent);
-    }
+    Event emptyEvent;
+    MultiplyAndPush(defaultActions, 0.0f, false, emptyEvent);
 }
 
 string Engine::ListStrategies()
@@ -378,9 +386,12 @@ string Engine::ListStrategies()
 
 void Engine::PushAgain(std::shared_ptr<ActionNode> actionNode, float relevance, Event event)
 {
-    ActionList nextActions(1);
-    nextActions[0] = std::make_shared<NextAction>(actionNode->getName(), relevance);
-    MultiplyAndPush(nextActions, relevance, true, event);
+    // Same as pushing a NextAction of this node with skipPrerequisites, the node is already known
+    if (relevance > 0)
+    {
+        LogAction("PUSH:%s %f", actionNode->getName().c_str(), relevance);
+        queue.Push(std::make_shared<ActionBasket>(actionNode, relevance, true, event));
+    }
 }
 
 bool Engine::ContainsStrategy(StrategyType type)
@@ -399,7 +410,7 @@ Action* Engine::InitializeAction(ActionNode* actionNode)
     std::shared_ptr<Action> action = actionNode->getAction();
     if (!action)
     {
-        action = aiObjectContext->GetAction(actionNode->getName());
+        action = aiObjectContext->GetAction(actionNode->getId());
         actionNode->setAction(action);
     }
     return action.get();
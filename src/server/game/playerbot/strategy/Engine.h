@@ -94,11 +94,12 @@ namespace ai
         virtual ~Engine(void);
 
     private:
-        bool MultiplyAndPush(ActionList actions, float forceRelevance, bool skipPrerequisites, Event event);
+        bool MultiplyAndPush(ActionList const& actions, float forceRelevance, bool skipPrerequisites, Event event);
         void Reset();
         void ProcessTriggers();
         void PushDefaultActions();
         void PushAgain(std::shared_ptr<ActionNode> actionNode, float relevance, Event event);
+        std::shared_ptr<ActionNode> CreateActionNode(NextAction const& nextAction);
         std::shared_ptr<ActionNode> CreateActionNode(std::string name);
         Action* InitializeAction(ActionNode* actionNode);
         bool ListenAndExecute(Action* action, Event event);
@@ -113,6 +114,9 @@ namespace ai
         std::list<std::shared_ptr<Multiplier>> multipliers;
         AiObjectContext* aiObjectContext;
         std::map<string, std::shared_ptr<Strategy>> strategies;
+        // Built once per Init from the strategies, which create new nodes and lists on each call
+        std::unordered_map<NameId, std::shared_ptr<ActionNode>> actionNodes;
+        ActionList defaultActions;
         float lastRelevance;
         std::string lastAction;
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "NamedObjectIds.h"
 #include <memory>
+#include <unordered_map>
 
 namespace ai
 {
@@ -66,12 +68,19 @@ namespace ai
         NamedObjectContext(bool shared = false, bool supportsSiblings = false) :
             NamedObjectFactory<T>(), shared(shared), supportsSiblings(supportsSiblings) {}
 
-        std::shared_ptr<T> create(std::string name, PlayerbotAI* ai)
+        std::shared_ptr<T> create(std::string const& name, PlayerbotAI* ai)
+        {
+            return create(NamedObjectIds::GetId(name), ai);
+        }
+
+        // Names not supported by this context are only looked up once as well
+        std::shared_ptr<T> create(NameId id, PlayerbotAI* ai)
         {
-            if (created.find(name) == created.end())
-                return created[name] = NamedObjectFactory<T>::create(name, ai);
+            auto itr = created.find(id);
+            if (itr == created.end())
+                itr = created.emplace(id, NamedObjectFactory<T>::create(NamedObjectIds::GetName(id), ai)).first;
 
-            return created[name];
+            return itr->second;
         }
 
         virtual ~NamedObjectContext()
@@ -86,19 +95,19 @@ namespace ai
 
         void Update()
         {
-            for (typename map<string, std::shared_ptr<T>>::iterator i = created.begin(); i != created.end(); i++)
+            for (auto const& itr : created)
             {
-                if (i->second)
-                    i->second->Update();
+                if (itr.second)
+                    itr.second->Update();
             }
         }
 
         void Reset()
         {
-            for (typename map<string, std::shared_ptr<T>>::iterator i = created.begin(); i != created.end(); i++)
+            for (auto const& itr : created)
             {
-                if (i->second)
-                    i->second->Reset();
+                if (itr.second)
+                    itr.second->Reset();
             }
         }
 
@@ -108,13 +117,15 @@ namespace ai
         set<std::string> GetCreated()
         {
             set<std::string> keys;
-            for (auto it = created.begin(); it != created.end(); it++)
-                keys.insert(it->first);
+            for (auto const& itr : created)
+                if (itr.second)
+                    keys.insert(NamedObjectIds::GetName(itr.first));
             return keys;
         }
 
     protected:
-        map<string, std::shared_ptr<T>> created;
+        // Only names requested from this context, null if not supported
+        std::unordered_map<NameId, std::shared_ptr<T>> created;
         bool shared;
         bool supportsSiblings;
     };
@@ -135,16 +146,29 @@ namespace ai
         void Add(NamedObjectContext<T>* context)
         {
             contexts.push_back(context);
+            objects.clear();
         }
 
-        std::shared_ptr<T> GetObject(std::string name, PlayerbotAI* ai)
+        std::shared_ptr<T> GetObject(std::string const& name, PlayerbotAI* ai)
+        {
+            return GetObject(NamedObjectIds::GetId(name), ai);
+        }
+
+        std::shared_ptr<T> const& GetObject(NameId id, PlayerbotAI* ai)
         {
+            auto itr = objects.find(id);
+            if (itr != objects.end())
+                return itr->second;
+
+            std::shared_ptr<T>& object = objects[id];
             for (auto i = contexts.begin(); i != contexts.end(); i++)
             {
-                std::shared_ptr<T> object = (*i)->create(name, ai);
-                if (object) return object;
+                object = (*i)->create(id, ai);
+                if (object)
+                    break;
             }
-            return nullptr;
+
+            return object;
         }
 
         void Update()
@@ -213,6 +237,8 @@ namespace ai
 
     private:
         list<NamedObjectContext<T>*> contexts;
+        // First object found in contexts for each NameId requested, contexts never release the objects they created
+        std::unordered_map<NameId, std::shared_ptr<T>> objects;
     };
 
     template <class T> class NamedObjectFactoryList
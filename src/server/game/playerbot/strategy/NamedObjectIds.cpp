@@ -0,0 +1,77 @@
+#include "../playerbot.h"
+#include "NamedObjectIds.h"
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+using namespace ai;
+
+namespace
+{
+    // Bots of different maps are updated concurrently
+    struct NameRegistry
+    {
+        std::shared_mutex lock;
+        std::unordered_map<std::string, NameId> ids;
+        std::deque<std::string> names;                                           // indexed by id, deque keeps references valid
+        std::deque<std::unordered_map<std::string, NameId>> qualifiedIds;        // indexed by unqualified id
+
+        NameId Insert(std::string const& name)
+        {
+            auto itr = ids.find(name);
+            if (itr != ids.end())
+                return itr->second;
+
+            NameId const id = NameId(names.size());
+            ids.emplace(name, id);
+            names.push_back(name);
+            qualifiedIds.emplace_back();
+            return id;
+        }
+    };
+
+    NameRegistry& GetRegistry()
+    {
+        static NameRegistry registry;
+        return registry;
+    }
+}
+
+NameId NamedObjectIds::GetId(std::string const& name)
+{
+    NameRegistry& registry = GetRegistry();
+    {
+        std::shared_lock<std::shared_mutex> guard(registry.lock);
+        auto itr = registry.ids.find(name);
+        if (itr != registry.ids.end())
+            return itr->second;
+    }
+
+    std::unique_lock<std::shared_mutex> guard(registry.lock);
+    return registry.Insert(name);
+}
+
+NameId NamedObjectIds::GetId(NameId name, std::string const& qualifier)
+{
+    NameRegistry& registry = GetRegistry();
+    {
+        std::shared_lock<std::shared_mutex> guard(registry.lock);
+        auto const& qualifiedIds = registry.qualifiedIds[name];
+        auto itr = qualifiedIds.find(qualifier);
+        if (itr != qualifiedIds.end())
+            return itr->second;
+    }
+
+    std::unique_lock<std::shared_mutex> guard(registry.lock);
+    NameId const id = registry.Insert(registry.names[name] + "::" + qualifier);
+    registry.qualifiedIds[name].emplace(qualifier, id);
+    return id;
+}
+
+std::string const& NamedObjectIds::GetName(NameId id)
+{
+    NameRegistry& registry = GetRegistry();
+    std::shared_lock<std::shared_mutex> guard(registry.lock);
+    return registry.names[id];
+}
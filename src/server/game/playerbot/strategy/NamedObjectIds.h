@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Define.h"
+#include <string>
+
+namespace ai
+{
+    typedef uint32 NameId;
+
+    /* Strategies, triggers, actions and values are identified by their names in configs and chat commands.
+    Names are resolved once into ids, so that contexts can look objects up by them without hashing strings. Ids are never
+    released and include qualified names, so they are not meant to index per bot arrays. */
+    class NamedObjectIds
+    {
+    public:
+        static NameId GetId(std::string const& name);
+        // Id of "name::qualifier", without building the qualified name once it is known
+        static NameId GetId(NameId name, std::string const& qualifier);
+        static std::string const& GetName(NameId id);
+    };
+}
+
+// Id of a name known at compile time, resolved once per call site
+#define AI_NAME_ID(name) ([]() { static ai::NameId const id = ai::NamedObjectIds::GetId(name); return id; }())
@@ -60,6 +60,7 @@ namespace ai
         TriggerNode(std::string name, ActionList const handlers)
         {
             this->name = name;
+            this->id = NamedObjectIds::GetId(name);
             this->handlers = handlers;
             this->trigger = nullptr;
         }
@@ -69,16 +70,18 @@ namespace ai
         }
 
     public:
-        std::shared_ptr<Trigger> getTrigger() { return trigger; }
+        std::shared_ptr<Trigger> const& getTrigger() const { return trigger; }
         void setTrigger(std::shared_ptr<Trigger> _trigger) { trigger = _trigger; }
-        std::string getName() { return name; }
+        std::string const& getName() const { return name; }
+        NameId getId() const { return id; }
 
     public:
-        ActionList getHandlers() { return NextAction::merge(NextAction::clone(handlers), trigger->getHandlers()); }
+        ActionList getHandlers() { return NextAction::merge(handlers, trigger->getHandlers()); }
 
     private:
         std::shared_ptr<Trigger> trigger;
         ActionList handlers;
         std::string name;
+        NameId id;
     };
 }
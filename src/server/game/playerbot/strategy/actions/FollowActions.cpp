@@ -12,7 +12,7 @@ bool FollowAction::Execute(Event event)
     std::string target = formation->GetTargetName();
     if (!target.empty())
     {
-        return Follow(AI_VALUE(Unit*, target));
+        return Follow(context->GetValue<Unit*>(target)->Get());
     }
     else
     {
@@ -32,7 +32,7 @@ namespace ai
         }
         virtual bool IsActive()
         {
-            Unit* target = AI_VALUE(Unit*, GetTargetName());
+            Unit* target = context->GetValue<Unit*>(GetTargetName())->Get();
             return target && AI_VALUE2(float, "distance", GetTargetName()) > distance;
         }
         virtual std::string GetTargetName() { return "current target"; }
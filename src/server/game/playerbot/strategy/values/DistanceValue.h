@@ -15,7 +15,7 @@ namespace ai
         {
             if (qualifier == "loot target")
             {
-                LootObject loot = AI_VALUE(LootObject, qualifier);
+                LootObject loot = context->GetValue<LootObject>(qualifier)->Get();
                 if (loot.IsEmpty())
                     return 0.0f;
 
@@ -25,7 +25,7 @@ namespace ai
 
                 return ai->GetBot()->GetDistance(obj);
             }
-            Unit* target = AI_VALUE(Unit*, qualifier);
+            Unit* target = context->GetValue<Unit*>(qualifier)->Get();
             if (!target || !target->IsInWorld())
                 return 0.0f;
 
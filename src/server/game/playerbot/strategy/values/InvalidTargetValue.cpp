@@ -7,7 +7,7 @@ using namespace ai;
 
 bool InvalidTargetValue::Calculate()
 {
-    Unit* target = AI_VALUE(Unit*, qualifier);
+    Unit* target = context->GetValue<Unit*>(qualifier)->Get();
     if (qualifier == "current target")
     {
         return !target ||
@@ -10,7 +10,7 @@ namespace ai
 
         virtual bool Calculate()
         {
-            Unit* target = AI_VALUE(Unit*, qualifier);
+            Unit* target = context->GetValue<Unit*>(qualifier)->Get();
             if (!target)
                 return false;
 
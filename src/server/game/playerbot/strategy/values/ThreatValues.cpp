@@ -24,7 +24,7 @@ uint8 ThreatValue::Calculate()
         return maxThreat;
     }
 
-    Unit* target = AI_VALUE(Unit*, qualifier);
+    Unit* target = context->GetValue<Unit*>(qualifier)->Get();
     return Calculate(target);
 }
 
@@ -1,5 +1,8 @@
 #include "Chat.h"
 #include "Profiler.h"
+#include "Monitor.h"
+#include "Config.h"
+#include "World.h"
 
 class profiling_commandscript : public CommandScript
 {
@@ -13,6 +16,9 @@ public:
             { "start",     SEC_SUPERADMIN,   true,  &HandleProfilingStartCommand,             "" },
             { "stop",      SEC_SUPERADMIN,   true,  &HandleProfilingStopCommand,              "" },
             { "status",    SEC_SUPERADMIN,   true,  &HandleProfilingStatusCommand,            "" },
+            { "phases",    SEC_SUPERADMIN,   true,  &HandleProfilingPhasesCommand,            "" },
+            { "phasesexport", SEC_SUPERADMIN, true, &HandleProfilingPhasesExportCommand,      "" },
+            { "collision", SEC_SUPERADMIN,   true,  &HandleProfilingCollisionCommand,         "" },
         };
         static std::vector<ChatCommand> commandTable =
         {
@@ -57,6 +63,95 @@ public:
         handler->PSendSysMessage("Profiling infos:\n%s", infos.c_str());
         return true;
     }
+
+    /* .profiling phases [on|off|mapId]
+    Without args, show p50/p99 of each map update phase for the current map (or list profiled maps from console)
+    */
+    static bool HandleProfilingPhasesCommand(ChatHandler* handler, char const* args)
+    {
+        std::string const arg = *args ? args : "";
+        if (arg == "on" || arg == "off")
+        {
+            sWorld->setConfig(CONFIG_MONITORING_MAP_PHASES, arg == "on");
+            handler->PSendSysMessage("Map phases profiling %s", arg == "on" ? "enabled" : "disabled");
+            if (arg == "on" && !sWorld->getConfig(CONFIG_MONITORING_ENABLED))
+                handler->SendSysMessage("Warning: Monitor is disabled (Monitor.Enabled), nothing will be recorded");
+            return true;
+        }
+
+        uint32 mapId;
+        if (!arg.empty())
+            mapId = uint32(atoi(args));
+        else if (Player* player = handler->GetSession() ? handler->GetSession()->GetPlayer() : nullptr)
+            mapId = player->GetMapId();
+        else
+        {
+            std::ostringstream ss;
+            for (uint32 id : sMonitor->GetMapPhasesMapIds())
+                ss << id << " ";
+            handler->PSendSysMessage("Profiled maps: %s", ss.str().c_str());
+            return true;
+        }
+
+        std::array<MapPhasePercentiles, MAP_UPDATE_PHASE_COUNT> percentiles;
+        if (!sMonitor->GetMapPhasesPercentiles(mapId, percentiles))
+        {
+            handler->PSendSysMessage("No map update phases recorded for map %u", mapId);
+            return true;
+        }
+
+        handler->PSendSysMessage("Map %u update phases (microseconds):", mapId);
+        for (uint8 phase = 0; phase < MAP_UPDATE_PHASE_COUNT; phase++)
+            handler->PSendSysMessage("%s: p50 %u - p99 %u - max %u", Monitor::GetMapPhaseName(MapUpdatePhase(phase)), percentiles[phase].p50, percentiles[phase].p99, percentiles[phase].max);
+
+        return true;
+    }
+
+    /* .profiling phasesexport [filename] */
+    static bool HandleProfilingPhasesExportCommand(ChatHandler* handler, char const* args)
+    {
+        std::string filename = sConfigMgr->GetStringDefault("Monitor.MapPhases.ExportFile", "map_phases.prom");
+        char* cFileName = strtok((char*)args, " ");
+        if (cFileName)
+            filename = cFileName;
+
+        if (sMonitor->ExportMapPhases(filename))
+            handler->PSendSysMessage("Map phases written to %s", filename.c_str());
+        else
+            handler->PSendSysMessage("Failed to write map phases to %s", filename.c_str());
+        return true;
+    }
+
+    /* .profiling collision [mapId]
+    Show hits and misses of the line of sight and height cache for given map, or the current map
+    */
+    static bool HandleProfilingCollisionCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 mapId;
+        if (*args)
+            mapId = uint32(atoi(args));
+        else if (Player* player = handler->GetSession() ? handler->GetSession()->GetPlayer() : nullptr)
+            mapId = player->GetMapId();
+        else
+            return false;
+
+        MapCollisionCacheStats stats;
+        if (!sMonitor->GetMapCollisionCacheStats(mapId, stats))
+        {
+            handler->PSendSysMessage("No collision cache stats recorded for map %u (vmap.cacheSize may be 0)", mapId);
+            return true;
+        }
+
+        handler->PSendSysMessage("Map %u collision cache:", mapId);
+        for (uint8 query = 0; query < MAP_COLLISION_QUERY_COUNT; query++)
+        {
+            uint64 const total = stats.hits[query] + stats.misses[query];
+            handler->PSendSysMessage("%s: " UI64FMTD " hits - " UI64FMTD " misses (%.1f%% hits)", Monitor::GetMapCollisionQueryName(MapCollisionQuery(query)),
+                stats.hits[query], stats.misses[query], total ? stats.hits[query] * 100.0f / total : 0.0f);
+        }
+
+        return true;
+    }
 };
 
 void AddSC_profiling_commandscript()
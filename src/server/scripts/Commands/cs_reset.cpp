@@ -54,7 +54,7 @@ public:
         }
 
         player->SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, DEFAULT_PLAYER_BOUNDING_RADIUS);
-        player->SetFloatValue(UNIT_FIELD_COMBATREACH, DEFAULT_PLAYER_COMBAT_REACH);
+        player->SetCombatReach(DEFAULT_PLAYER_COMBAT_REACH);
 
         player->SetFactionForRace(player->GetRace());
 
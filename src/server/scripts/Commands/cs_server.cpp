@@ -10,6 +10,9 @@
 #include "DatabaseLoader.h"
 #include "Config.h"
 #include "UpdateTime.h"
+#include "PacketBufferPool.h"
+#include "DatabaseWorker.h"
+#include "LogsDatabaseAccessor.h"
 
 #include <boost/filesystem.hpp>
 #include <mysql_version.h>
@@ -21,6 +24,29 @@ class server_commandscript : public CommandScript
 public:
     server_commandscript() : CommandScript("server_commandscript") { }
 
+    static void PrintDatabaseBatchStats(ChatHandler* handler, char const* name, DatabaseBatchStats const& stats)
+    {
+        handler->PSendSysMessage("%s database: %" PRIu64 " write batches, %.1f operations per batch, %" PRIu64 " fallbacks, %" PRIu64 " uncertain",
+            name, stats.Batches, stats.Batches ? stats.Operations / double(stats.Batches) : 0.0, stats.Fallbacks, stats.Uncertain);
+
+        std::ostringstream sizes, latencies;
+        for (uint8 i = 0; i < DatabaseBatchStats::BUCKET_COUNT; ++i)
+        {
+            if (DatabaseBatchStats::SizeBounds[i])
+                sizes << " <=" << DatabaseBatchStats::SizeBounds[i] << ':' << stats.Sizes[i];
+            else
+                sizes << " >" << DatabaseBatchStats::SizeBounds[i - 1] << ':' << stats.Sizes[i];
+
+            if (DatabaseBatchStats::LatencyBounds[i])
+                latencies << " <=" << DatabaseBatchStats::LatencyBounds[i] << "us:" << stats.Latencies[i];
+            else
+                latencies << " >" << DatabaseBatchStats::LatencyBounds[i - 1] << "us:" << stats.Latencies[i];
+        }
+
+        handler->PSendSysMessage("  Batch sizes:%s", sizes.str().c_str());
+        handler->PSendSysMessage("  Batch latencies:%s", latencies.str().c_str());
+    }
+
     std::vector<ChatCommand> GetCommands() const override
     {
         static std::vector<ChatCommand> serverIdleRestartCommandTable =
@@ -128,6 +154,21 @@ public:
         handler->PSendSysMessage("Worldserver listening connections on port %" PRIu16, worldPort);
         handler->PSendSysMessage("%s", dbPortOutput.c_str());
 
+        PacketBufferPool::Stats const poolStats = sPacketBufferPool->GetStats();
+        uint64 const poolRequests = poolStats.hits + poolStats.misses;
+        handler->PSendSysMessage("Packet buffer pool: %" PRIu64 " hits, %" PRIu64 " misses (hit rate %.1f%%), %" PRIu64 " released, %" PRIu64 " dropped, %" PRIu64 " KB pooled",
+            poolStats.hits, poolStats.misses, poolRequests ? poolStats.hits * 100.0 / poolRequests : 0.0, poolStats.released, poolStats.dropped, poolStats.pooledBytes / 1024);
+
+        uint64 const playerSaves = Player::GetSaveCount();
+        handler->PSendSysMessage("Player saves: %" PRIu64 ", %.1f statements per save", playerSaves, playerSaves ? Player::GetSaveStatementCount() / double(playerSaves) : 0.0);
+
+        PrintDatabaseBatchStats(handler, "Characters", CharacterDatabase.GetBatchStats());
+        PrintDatabaseBatchStats(handler, "Logs", LogsDatabase.GetBatchStats());
+
+        LogsDatabaseAccessor::BufferStats const logsStats = sLogsDatabaseAccessor->GetBufferStats();
+        handler->PSendSysMessage("Logs buffer: %u pending, %" PRIu64 " buffered, %" PRIu64 " written in %" PRIu64 " flushes, %" PRIu64 " failed, %" PRIu64 " uncertain, %" PRIu64 " dropped, %" PRIu64 " overflowed",
+            logsStats.pending, logsStats.buffered, logsStats.flushed, logsStats.flushes, logsStats.failed, logsStats.uncertain, logsStats.dropped, logsStats.overflowed);
+
         //bool vmapIndoorCheck = sWorld->getBoolConfig(CONFIG_VMAP_INDOOR_CHECK);
         bool vmapIndoorCheck = true;
         bool vmapLOSCheck = VMAP::VMapFactory::createOrGetVMapManager()->isLineOfSightCalcEnabled();
@@ -0,0 +1,142 @@
+#ifndef _GRIDPOSITIONINDEX
+#define _GRIDPOSITIONINDEX
+
+#include "Define.h"
+#include <cmath>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define GRID_POSITION_INDEX_SSE
+#include <xmmintrin.h>
+#endif
+
+class GridPositionIndex;
+
+// Kept by each indexed object, index is null while the object is not indexed
+struct GridPositionLink
+{
+    GridPositionIndex* index = nullptr;
+    uint32 slot = 0;
+};
+
+/* Positions of the objects of a grid container in contiguous arrays, so that area searches can filter them by distance
+without going through each object. Each entry has a radius, the distance from its position at which the object can
+still be in range of a search (combat reach for units). Entries are not ordered, removing one moves the last one in its slot. */
+class GridPositionIndex
+{
+    public:
+        GridPositionIndex() = default;
+        ~GridPositionIndex()
+        {
+            for (GridPositionLink* link : _links)
+                link->index = nullptr;
+        }
+
+        void Insert(GridPositionLink& link, void* object, float x, float y, float z, float radius)
+        {
+            link.index = this;
+            link.slot = uint32(_objects.size());
+            _x.push_back(x);
+            _y.push_back(y);
+            _z.push_back(z);
+            _radius.push_back(radius);
+            _objects.push_back(object);
+            _links.push_back(&link);
+        }
+
+        static void Remove(GridPositionLink& link)
+        {
+            if (GridPositionIndex* index = link.index)
+                index->RemoveSlot(link.slot);
+            link.index = nullptr;
+        }
+
+        static void Update(GridPositionLink const& link, float x, float y, float z, float radius)
+        {
+            if (GridPositionIndex* index = link.index)
+            {
+                index->_x[link.slot] = x;
+                index->_y[link.slot] = y;
+                index->_z[link.slot] = z;
+                index->_radius[link.slot] = radius;
+            }
+        }
+
+        uint32 size() const { return uint32(_objects.size()); }
+        void* GetObject(uint32 slot) const { return _objects[slot]; }
+
+        /* Append to slots the entries within range of x, y in 2d and within rangeZ of z on the z axis, the radius of
+        each entry being added to both */
+        void Filter(float x, float y, float z, float range, float rangeZ, std::vector<uint32>& slots) const
+        {
+            uint32 const count = size();
+            uint32 i = 0;
+#ifdef GRID_POSITION_INDEX_SSE
+            __m128 const centerX = _mm_set1_ps(x);
+            __m128 const centerY = _mm_set1_ps(y);
+            __m128 const centerZ = _mm_set1_ps(z);
+            __m128 const range4 = _mm_set1_ps(range);
+            __m128 const rangeZ4 = _mm_set1_ps(rangeZ);
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128 const radius = _mm_loadu_ps(&_radius[i]);
+                __m128 const dx = _mm_sub_ps(_mm_loadu_ps(&_x[i]), centerX);
+                __m128 const dy = _mm_sub_ps(_mm_loadu_ps(&_y[i]), centerY);
+                __m128 const dz = _mm_sub_ps(_mm_loadu_ps(&_z[i]), centerZ);
+                __m128 const absDz = _mm_max_ps(dz, _mm_sub_ps(_mm_setzero_ps(), dz));
+                __m128 const maxDist = _mm_add_ps(range4, radius);
+                __m128 const inRange = _mm_and_ps(
+                    _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(maxDist, maxDist)),
+                    _mm_cmple_ps(absDz, _mm_add_ps(rangeZ4, radius)));
+
+                int const mask = _mm_movemask_ps(inRange);
+                for (uint32 lane = 0; lane < 4; ++lane)
+                    if (mask & (1 << lane))
+                        slots.push_back(i + lane);
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                float const dx = _x[i] - x;
+                float const dy = _y[i] - y;
+                float const maxDist = range + _radius[i];
+                if (dx * dx + dy * dy <= maxDist * maxDist && std::fabs(_z[i] - z) <= rangeZ + _radius[i])
+                    slots.push_back(i);
+            }
+        }
+
+    private:
+        void RemoveSlot(uint32 slot)
+        {
+            uint32 const last = size() - 1;
+            if (slot != last)
+            {
+                _x[slot] = _x[last];
+                _y[slot] = _y[last];
+                _z[slot] = _z[last];
+                _radius[slot] = _radius[last];
+                _objects[slot] = _objects[last];
+                _links[slot] = _links[last];
+                _links[slot]->slot = slot;
+            }
+
+            _x.pop_back();
+            _y.pop_back();
+            _z.pop_back();
+            _radius.pop_back();
+            _objects.pop_back();
+            _links.pop_back();
+        }
+
+        GridPositionIndex(GridPositionIndex const&) = delete;
+        GridPositionIndex& operator=(GridPositionIndex const&) = delete;
+
+        std::vector<float> _x;
+        std::vector<float> _y;
+        std::vector<float> _z;
+        std::vector<float> _radius;
+        std::vector<void*> _objects;
+        std::vector<GridPositionLink*> _links;
+};
+
+#endif
@@ -22,6 +22,7 @@
 #define _GRIDREFMANAGER
 
 #include "LinkedReference/RefManager.h"
+#include "GridPositionIndex.h"
 
 template<class OBJECT>
 class GridReference;
@@ -37,6 +38,13 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
 
         iterator begin() { return iterator(getFirst()); }
         iterator end() { return iterator(nullptr); }
+
+        // Positions of the world objects in the list, maintained by the objects themselves
+        GridPositionIndex& GetPositions() { return _positions; }
+        OBJECT* GetIndexedObject(uint32 slot) const { return static_cast<OBJECT*>(_positions.GetObject(slot)); }
+
+    private:
+        GridPositionIndex _positions;
 };
 #endif
 
@@ -19,6 +19,8 @@
 #define __MESSAGEBUFFER_H_
 
 #include "Define.h"
+#include "PacketBufferPool.h"
+#include <memory>
 #include <vector>
 
 class MessageBuffer
@@ -26,21 +28,39 @@ class MessageBuffer
     typedef std::vector<uint8>::size_type size_type;
 
 public:
-    MessageBuffer() : _wpos(0), _rpos(0), _storage()
+    MessageBuffer() : _wpos(0), _rpos(0), _storage(sPacketBufferPool->Acquire(4096))
     {
         _storage.resize(4096);
     }
 
-    explicit MessageBuffer(std::size_t initialSize) : _wpos(0), _rpos(0), _storage()
+    explicit MessageBuffer(std::size_t initialSize) : _wpos(0), _rpos(0), _storage(sPacketBufferPool->Acquire(initialSize))
     {
         _storage.resize(initialSize);
     }
 
-    MessageBuffer(MessageBuffer const& right) : _wpos(right._wpos), _rpos(right._rpos), _storage(right._storage)
+    // Take ownership of an already filled storage (for example from a ByteBuffer), without copying it
+    explicit MessageBuffer(std::vector<uint8>&& storage) : _wpos(storage.size()), _rpos(0), _storage(std::move(storage)) { }
+
+    /* Read only buffer over data kept alive by owner, for data sent as is by several sockets.
+    It has no remaining space and must not be written to. */
+    MessageBuffer(std::shared_ptr<void const> owner, uint8 const* data, std::size_t size) : _wpos(size), _rpos(0), _sharedOwner(std::move(owner)), _sharedData(data) { }
+
+    MessageBuffer(MessageBuffer const& right) : _wpos(right._wpos), _rpos(right._rpos), _storage(sPacketBufferPool->Acquire(right._storage.size())),
+        _sharedOwner(right._sharedOwner), _sharedData(right._sharedData)
     {
+        _storage.assign(right._storage.begin(), right._storage.end());
     }
 
-    MessageBuffer(MessageBuffer&& right) : _wpos(right._wpos), _rpos(right._rpos), _storage(right.Move()) { }
+    MessageBuffer(MessageBuffer&& right) : _wpos(right._wpos), _rpos(right._rpos), _storage(right.Move()),
+        _sharedOwner(std::move(right._sharedOwner)), _sharedData(right._sharedData)
+    {
+        right._sharedData = nullptr;
+    }
+
+    ~MessageBuffer()
+    {
+        sPacketBufferPool->Release(_storage);
+    }
 
     void Reset()
     {
@@ -53,7 +73,8 @@ public:
         _storage.resize(bytes);
     }
 
-    uint8* GetBasePointer() { return _storage.data(); }
+    // Socket only reads from shared data
+    uint8* GetBasePointer() { return _sharedData ? const_cast<uint8*>(_sharedData) : _storage.data(); }
 
     uint8* GetReadPointer() { return GetBasePointer() + _rpos; }
 
@@ -65,9 +86,9 @@ public:
 
     size_type GetActiveSize() const { return _wpos - _rpos; }
 
-    size_type GetRemainingSpace() const { return _storage.size() - _wpos; }
+    size_type GetRemainingSpace() const { return _sharedData ? 0 : _storage.size() - _wpos; }
 
-    size_type GetBufferSize() const { return _storage.size(); }
+    size_type GetBufferSize() const { return _sharedData ? _wpos : _storage.size(); }
 
     // Discards inactive data
     void Normalize()
@@ -112,6 +133,8 @@ public:
             _wpos = right._wpos;
             _rpos = right._rpos;
             _storage = right._storage;
+            _sharedOwner = right._sharedOwner;
+            _sharedData = right._sharedData;
         }
 
         return *this;
@@ -123,6 +146,10 @@ public:
         {
             _wpos = right._wpos;
             _rpos = right._rpos;
+            sPacketBufferPool->Release(_storage);
+            _sharedOwner = std::move(right._sharedOwner);
+            _sharedData = right._sharedData;
+            right._sharedData = nullptr;
             _storage = right.Move();
         }
 
@@ -133,6 +160,8 @@ private:
     size_type _wpos;
     size_type _rpos;
     std::vector<uint8> _storage;
+    std::shared_ptr<void const> _sharedOwner;
+    uint8 const* _sharedData = nullptr;
 };
 
 #endif /* __MESSAGEBUFFER_H_ */
@@ -21,7 +21,8 @@
 #include "MessageBuffer.h"
 #include "Log.h"
 #include <atomic>
-#include <queue>
+#include <deque>
+#include <vector>
 #include <memory>
 #include <functional>
 #include <type_traits>
@@ -30,6 +31,8 @@
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
+// max number of queued buffers sent with a single write call
+#define MAX_GATHERED_WRITE_BUFFERS 64
 #ifdef BOOST_ASIO_HAS_IOCP
 #define TC_SOCKET_USE_IOCP
 #endif
@@ -92,7 +95,7 @@ public:
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.push_back(std::move(buffer));
 
 #ifdef TC_SOCKET_USE_IOCP
         AsyncProcessQueue();
@@ -175,7 +178,7 @@ private:
             _isWritingAsync = false;
             _writeQueue.front().ReadCompleted(transferedBytes);
             if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+                _writeQueue.pop_front();
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -199,37 +202,53 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        // Send as many queued buffers as possible at once, this allows big packets to be queued as they are instead of being copied in a send buffer
+        _gatheredBuffers.clear();
+        std::size_t bytesToSend = 0;
+        for (auto itr = _writeQueue.begin(); itr != _writeQueue.end() && _gatheredBuffers.size() < MAX_GATHERED_WRITE_BUFFERS; ++itr)
+        {
+            _gatheredBuffers.push_back(boost::asio::const_buffer(itr->GetReadPointer(), itr->GetActiveSize()));
+            bytesToSend += itr->GetActiveSize();
+        }
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(_gatheredBuffers, error);
 
         if (error)
         {
             if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
                 return AsyncProcessQueue();
 
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
-        else if (bytesSent < bytesToSend) // now n > 0
+
+        // drop fully sent buffers
+        for (std::size_t remaining = bytesSent; remaining > 0;)
         {
-            queuedMessage.ReadCompleted(bytesSent);
-            return AsyncProcessQueue();
+            MessageBuffer& queuedMessage = _writeQueue.front();
+            if (remaining < queuedMessage.GetActiveSize())
+            {
+                queuedMessage.ReadCompleted(remaining);
+                break;
+            }
+
+            remaining -= queuedMessage.GetActiveSize();
+            _writeQueue.pop_front();
         }
 
-        _writeQueue.pop();
+        if (bytesSent < bytesToSend) // now n > 0
+            return AsyncProcessQueue();
+
         if (_closing && _writeQueue.empty())
             CloseSocket();
         return !_writeQueue.empty();
@@ -243,7 +262,11 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<MessageBuffer> _writeQueue;
+#ifndef TC_SOCKET_USE_IOCP
+    // only used in HandleQueue, kept here to avoid reallocating it at each call
+    std::vector<boost::asio::const_buffer> _gatheredBuffers;
+#endif
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
@@ -23,6 +23,7 @@
 #include "Debugging/Errors.h"
 #include "ByteConverter.h"
 #include "Util.h"
+#include "PacketBufferPool.h"
 
 #include <exception>
 #include <list>
@@ -74,15 +75,9 @@ public:
     const static size_t DEFAULT_SIZE = 0x1000;
 
     // constructor
-    ByteBuffer() : _rpos(0), _wpos(0)
-    {
-        _storage.reserve(DEFAULT_SIZE);
-    }
+    ByteBuffer() : _rpos(0), _wpos(0), _storage(sPacketBufferPool->Acquire(DEFAULT_SIZE)) { }
 
-    ByteBuffer(size_t reserve) : _rpos(0), _wpos(0)
-    {
-        _storage.reserve(reserve);
-    }
+    ByteBuffer(size_t reserve) : _rpos(0), _wpos(0), _storage(sPacketBufferPool->Acquire(reserve)) { }
 
     ByteBuffer(ByteBuffer&& buf) : _rpos(buf._rpos), _wpos(buf._wpos), _storage(std::move(buf._storage))
     {
@@ -90,7 +85,10 @@ public:
         buf._wpos = 0;
     }
 
-    ByteBuffer(ByteBuffer const& right) : _rpos(right._rpos), _wpos(right._wpos), _storage(right._storage) { }
+    ByteBuffer(ByteBuffer const& right) : _rpos(right._rpos), _wpos(right._wpos), _storage(sPacketBufferPool->Acquire(right._storage.size()))
+    {
+        _storage.assign(right._storage.begin(), right._storage.end());
+    }
 
     ByteBuffer(MessageBuffer&& buffer);
 
@@ -114,13 +112,25 @@ public:
             right._rpos = 0;
             _wpos = right._wpos;
             right._wpos = 0;
+            sPacketBufferPool->Release(_storage);
             _storage = std::move(right._storage);
         }
 
         return *this;
     }
 
-    virtual ~ByteBuffer() = default;
+    virtual ~ByteBuffer()
+    {
+        sPacketBufferPool->Release(_storage);
+    }
+
+    // Take ownership of storage, buffer is left empty
+    std::vector<uint8>&& Move()
+    {
+        _wpos = 0;
+        _rpos = 0;
+        return std::move(_storage);
+    }
 
     void clear()
     {
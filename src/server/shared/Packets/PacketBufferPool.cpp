@@ -0,0 +1,162 @@
+
+#include "PacketBufferPool.h"
+#include <algorithm>
+
+const std::array<std::size_t, PacketBufferPool::SIZE_CLASS_COUNT> PacketBufferPool::SizeClasses = { 256, 1024, 4096, 16384, 65536 };
+
+PacketBufferPool* PacketBufferPool::instance()
+{
+    // Never destroyed, static ByteBuffers may still give back their storage after static destruction has begun
+    static PacketBufferPool* instance = new PacketBufferPool();
+    return instance;
+}
+
+struct PacketBufferThreadCache
+{
+    std::array<std::vector<std::vector<uint8>>, PacketBufferPool::SIZE_CLASS_COUNT> storages;
+
+    ~PacketBufferThreadCache();
+};
+
+// Raw pointer and flag are trivially destructible, they can still be read when ByteBuffers are destroyed after the cache at thread exit
+static thread_local PacketBufferThreadCache* threadCache = nullptr;
+static thread_local bool threadCacheDestroyed = false;
+
+PacketBufferThreadCache::~PacketBufferThreadCache()
+{
+    threadCache = nullptr;
+    threadCacheDestroyed = true;
+
+    for (std::size_t i = 0; i < PacketBufferPool::SIZE_CLASS_COUNT; ++i)
+        sPacketBufferPool->GiveShared(i, storages[i], storages[i].size());
+}
+
+// nullptr once the thread is exiting, storages then go directly through the shared classes
+static PacketBufferThreadCache* GetThreadCache()
+{
+    if (!threadCache && !threadCacheDestroyed)
+    {
+        static thread_local PacketBufferThreadCache cache;
+        threadCache = &cache;
+    }
+    return threadCache;
+}
+
+std::size_t PacketBufferPool::GetThreadCacheCapacity(std::size_t classIndex)
+{
+    return std::max<std::size_t>(MAX_THREAD_POOLED_BYTES_PER_CLASS / SizeClasses[classIndex], 2);
+}
+
+void PacketBufferPool::TakeShared(std::size_t classIndex, std::vector<std::vector<uint8>>& storages, std::size_t count)
+{
+    SizeClass& sizeClass = _classes[classIndex];
+    std::lock_guard<std::mutex> lock(sizeClass.lock);
+    while (count-- && !sizeClass.storages.empty())
+    {
+        storages.push_back(std::move(sizeClass.storages.back()));
+        sizeClass.storages.pop_back();
+    }
+}
+
+void PacketBufferPool::GiveShared(std::size_t classIndex, std::vector<std::vector<uint8>>& storages, std::size_t count)
+{
+    SizeClass& sizeClass = _classes[classIndex];
+    std::size_t const maxCount = MAX_POOLED_BYTES_PER_CLASS / SizeClasses[classIndex];
+    std::lock_guard<std::mutex> lock(sizeClass.lock);
+    for (; count && !storages.empty(); --count)
+    {
+        if (sizeClass.storages.size() < maxCount)
+            sizeClass.storages.push_back(std::move(storages.back()));
+        else
+        {
+            _pooledBytes -= storages.back().capacity();
+            ++_dropped;
+        }
+        storages.pop_back();
+    }
+}
+
+std::vector<uint8> PacketBufferPool::Acquire(std::size_t reserve)
+{
+    std::vector<uint8> storage;
+    if (!reserve)
+        return storage;
+
+    for (std::size_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+    {
+        if (reserve > SizeClasses[i])
+            continue;
+
+        PacketBufferThreadCache* cache = GetThreadCache();
+        std::vector<std::vector<uint8>> taken;
+        std::vector<std::vector<uint8>>& storages = cache ? cache->storages[i] : taken;
+        // refill half of the thread cache at once
+        if (storages.empty())
+            TakeShared(i, storages, cache ? GetThreadCacheCapacity(i) / 2 : 1);
+
+        if (!storages.empty())
+        {
+            storage = std::move(storages.back());
+            storages.pop_back();
+            _pooledBytes -= storage.capacity();
+            ++_hits;
+            return storage;
+        }
+
+        // allocate the whole class size so that this storage can be reused for any request of this class later
+        ++_misses;
+        storage.reserve(SizeClasses[i]);
+        return storage;
+    }
+
+    // too big to be pooled
+    ++_misses;
+    storage.reserve(reserve);
+    return storage;
+}
+
+void PacketBufferPool::Release(std::vector<uint8>& storage)
+{
+    std::size_t const capacity = storage.capacity();
+    if (!capacity)
+        return;
+
+    // biggest class this storage can serve. Don't keep storages much bigger than the biggest class, this would waste memory.
+    if (capacity >= SizeClasses[0] && capacity < SizeClasses[SIZE_CLASS_COUNT - 1] * 2)
+    {
+        std::size_t i = SIZE_CLASS_COUNT - 1;
+        while (capacity < SizeClasses[i])
+            --i;
+
+        storage.clear();
+        _pooledBytes += capacity;
+        ++_released;
+
+        std::vector<std::vector<uint8>> given;
+        PacketBufferThreadCache* cache = GetThreadCache();
+        std::vector<std::vector<uint8>>& storages = cache ? cache->storages[i] : given;
+        storages.push_back(std::move(storage));
+        storage = std::vector<uint8>();
+
+        // threads releasing more packets than they build (network threads) keep half of their cache and spill the rest
+        if (!cache)
+            GiveShared(i, storages, 1);
+        else if (storages.size() > GetThreadCacheCapacity(i))
+            GiveShared(i, storages, storages.size() / 2);
+        return;
+    }
+
+    ++_dropped;
+    std::vector<uint8>().swap(storage);
+}
+
+PacketBufferPool::Stats PacketBufferPool::GetStats() const
+{
+    Stats stats;
+    stats.hits = _hits;
+    stats.misses = _misses;
+    stats.released = _released;
+    stats.dropped = _dropped;
+    stats.pooledBytes = _pooledBytes;
+    return stats;
+}
@@ -0,0 +1,76 @@
+
+#ifndef __PACKETBUFFERPOOL_H
+#define __PACKETBUFFERPOOL_H
+
+#include "Define.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/**
+Recycles storages used by ByteBuffer (and so WorldPacket) and MessageBuffer, packets are built and destroyed at a very high rate
+and most of them share a few typical sizes.
+Storages are kept by size class, a storage given back is filed in the biggest class it can hold so that any storage taken from
+a class can be used without reallocation.
+Each thread keeps a few storages per class for itself, the locked shared classes are only used in batches when a thread has
+none left or too many.
+*/
+class TC_SHARED_API PacketBufferPool
+{
+    friend struct PacketBufferThreadCache;
+
+public:
+    struct Stats
+    {
+        uint64 hits = 0;     // storage taken from the pool
+        uint64 misses = 0;   // storage had to be allocated
+        uint64 released = 0; // storage given back and kept for reuse
+        uint64 dropped = 0;  // storage given back but freed (too big/small, or class full)
+        uint64 pooledBytes = 0; // capacity currently held in pool
+    };
+
+    static PacketBufferPool* instance();
+
+    // Get an empty storage with at least reserve bytes capacity. reserve 0 gives an unallocated storage.
+    std::vector<uint8> Acquire(std::size_t reserve);
+    // Give back storage to the pool (if it fits in a size class). storage is left empty in any case.
+    void Release(std::vector<uint8>& storage);
+
+    Stats GetStats() const;
+
+private:
+    PacketBufferPool() = default;
+    ~PacketBufferPool() = default;
+
+    static const std::size_t SIZE_CLASS_COUNT = 5;
+    static const std::array<std::size_t, SIZE_CLASS_COUNT> SizeClasses;
+    // max capacity kept per class, in bytes
+    static const std::size_t MAX_POOLED_BYTES_PER_CLASS = 4 * 1024 * 1024;
+    // max capacity kept per class by each thread, in bytes (at least 2 storages)
+    static const std::size_t MAX_THREAD_POOLED_BYTES_PER_CLASS = 64 * 1024;
+
+    struct SizeClass
+    {
+        std::mutex lock;
+        std::vector<std::vector<uint8>> storages;
+    };
+
+    std::array<SizeClass, SIZE_CLASS_COUNT> _classes;
+
+    static std::size_t GetThreadCacheCapacity(std::size_t classIndex);
+    // Move up to count storages from shared class to storages
+    void TakeShared(std::size_t classIndex, std::vector<std::vector<uint8>>& storages, std::size_t count);
+    // Move count last storages to shared class, those which don't fit are freed
+    void GiveShared(std::size_t classIndex, std::vector<std::vector<uint8>>& storages, std::size_t count);
+
+    std::atomic<uint64> _hits{ 0 };
+    std::atomic<uint64> _misses{ 0 };
+    std::atomic<uint64> _released{ 0 };
+    std::atomic<uint64> _dropped{ 0 };
+    std::atomic<uint64> _pooledBytes{ 0 };
+};
+
+#define sPacketBufferPool PacketBufferPool::instance()
+
+#endif
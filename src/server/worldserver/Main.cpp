@@ -32,6 +32,8 @@
 #include "Resolver.h"
 #include "World.h"
 #include "MapManager.h"
+#include "GridMapPreloader.h"
+#include "LogsDatabaseAccessor.h"
 #include "OutdoorPvPMgr.h"
 #include "InstanceSaveMgr.h"
 #include "Configuration/Config.h"
@@ -266,6 +268,12 @@ extern int main(int argc, char **argv)
     // Initialize the World
     sWorld->SetInitialWorldSettings();
 
+    std::shared_ptr<void> logsDatabaseHandle(nullptr, [](void*)
+    {
+        // write buffered logs, after players were kicked and before databases are closed
+        sLogsDatabaseAccessor->StopBuffer();
+    });
+
     std::shared_ptr<void> mapManagementHandle(nullptr, [](void*)
     {
         // unload battleground templates before different singletons destroyed
@@ -274,6 +282,7 @@ extern int main(int argc, char **argv)
         sInstanceSaveMgr->Unload();
         sOutdoorPvPMgr->Die();                     // unload it before MapManager
         sMapMgr->UnloadAll();                      // unload all grids (including locked in memory)
+        sGridMapPreloader->Stop();
     });
 
     // Start the Remote Access port (acceptor) if enabled
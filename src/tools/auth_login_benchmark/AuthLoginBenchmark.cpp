@@ -0,0 +1,342 @@
+#include "BigNumber.h"
+#include "SHA1.h"
+#include "Banner.h"
+#include "OpenSSLCrypto.h"
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Login storm against an authserver: each thread logs in the same account again and again with a 2.4.3 client
+handshake (challenge then proof, SRP6 computed like the client does), for a given duration.
+The account must exist without security token, its name is sent upper case like clients do. */
+
+using boost::asio::ip::tcp;
+
+enum LoginResult
+{
+    LOGIN_OK,
+    LOGIN_BUSY,             // server answered WOW_FAIL_DB_BUSY
+    LOGIN_REFUSED,          // any other error code, wrong password...
+    LOGIN_NETWORK_ERROR,
+
+    LOGIN_RESULT_COUNT
+};
+
+static uint8 const AUTH_LOGON_CHALLENGE = 0x00;
+static uint8 const AUTH_LOGON_PROOF = 0x01;
+static uint8 const WOW_SUCCESS = 0x00;
+static uint8 const WOW_FAIL_DB_BUSY = 0x08;
+
+struct BenchmarkConfig
+{
+    std::string host;
+    std::string port;
+    std::string account;
+    std::string password;
+};
+
+static void Append(std::vector<uint8>& packet, void const* data, size_t size)
+{
+    packet.insert(packet.end(), static_cast<uint8 const*>(data), static_cast<uint8 const*>(data) + size);
+}
+
+static void AppendBigNumber(std::vector<uint8>& packet, BigNumber& number, int32 size)
+{
+    Append(packet, number.AsByteArray(size).get(), size);
+}
+
+static std::vector<uint8> BuildChallenge(std::string const& account)
+{
+    std::vector<uint8> packet;
+    uint8 const header[] = { AUTH_LOGON_CHALLENGE, 0x08 };
+    Append(packet, header, sizeof(header));
+
+    uint16 const size = uint16(30 + account.size());
+    uint8 const sizeBytes[] = { uint8(size & 0xFF), uint8(size >> 8) };
+    Append(packet, sizeBytes, sizeof(sizeBytes));
+
+    // gamename, version 2.4.3.8606, platform, os and country reversed like the client sends them
+    uint8 const client[] =
+    {
+        'W', 'o', 'W', 0,
+        2, 4, 3, uint8(8606 & 0xFF), uint8(8606 >> 8),
+        '6', '8', 'x', 0,
+        'n', 'i', 'W', 0,
+        'S', 'U', 'n', 'e',
+        0, 0, 0, 0,                 // timezone bias
+        127, 0, 0, 1,               // ip
+        uint8(account.size())
+    };
+    Append(packet, client, sizeof(client));
+    Append(packet, account.data(), account.size());
+    return packet;
+}
+
+static LoginResult Login(boost::asio::io_context& ioContext, tcp::resolver::results_type const& endpoints, BenchmarkConfig const& config)
+{
+    boost::system::error_code error;
+    tcp::socket socket(ioContext);
+    boost::asio::connect(socket, endpoints, error);
+    if (error)
+        return LOGIN_NETWORK_ERROR;
+
+    std::vector<uint8> challenge = BuildChallenge(config.account);
+    boost::asio::write(socket, boost::asio::buffer(challenge), error);
+
+    // cmd, unk, error then B, g, N, s, unk3 and security flags on success
+    uint8 challengeHeader[3];
+    boost::asio::read(socket, boost::asio::buffer(challengeHeader), error);
+    if (error)
+        return LOGIN_NETWORK_ERROR;
+
+    if (challengeHeader[2] != WOW_SUCCESS)
+        return challengeHeader[2] == WOW_FAIL_DB_BUSY ? LOGIN_BUSY : LOGIN_REFUSED;
+
+    uint8 challengeData[32 + 1 + 1 + 1 + 32 + 32 + 16 + 1];
+    boost::asio::read(socket, boost::asio::buffer(challengeData), error);
+    if (error)
+        return LOGIN_NETWORK_ERROR;
+
+    // Security token, PIN or matrix are not supported
+    if (challengeData[sizeof(challengeData) - 1] != 0)
+        return LOGIN_REFUSED;
+
+    BigNumber B, g, N, s;
+    B.SetBinary(challengeData, 32);
+    g.SetBinary(challengeData + 33, 1);
+    N.SetBinary(challengeData + 35, 32);
+    s.SetBinary(challengeData + 67, 32);
+
+    // x = SHA1(s, SHA1(ACCOUNT:PASSWORD))
+    SHA1Hash sha;
+    sha.UpdateData(config.account + ":" + config.password);
+    sha.Finalize();
+    uint8 passwordHash[SHA_DIGEST_LENGTH];
+    memcpy(passwordHash, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+    sha.Initialize();
+    sha.UpdateData(challengeData + 67, 32);
+    sha.UpdateData(passwordHash, SHA_DIGEST_LENGTH);
+    sha.Finalize();
+    BigNumber x;
+    x.SetBinary(sha.GetDigest(), sha.GetLength());
+
+    BigNumber a;
+    a.SetRand(19 * 8);
+    BigNumber A = g.ModExp(a, N);
+
+    sha.Initialize();
+    sha.UpdateBigNumbers(&A, &B, NULL);
+    sha.Finalize();
+    BigNumber u;
+    u.SetBinary(sha.GetDigest(), 20);
+
+    // S = (B - 3 * g^x)^(a + u * x)
+    BigNumber k;
+    k.SetDword(3);
+    BigNumber S = ((B + N * k - k * g.ModExp(x, N)) % N).ModExp(a + u * x, N);
+
+    // Session key, interleaved the same way as the server
+    uint8 t[32];
+    uint8 t1[16];
+    uint8 vK[40];
+    memcpy(t, S.AsByteArray(32).get(), 32);
+
+    for (int i = 0; i < 16; ++i)
+        t1[i] = t[i * 2];
+
+    sha.Initialize();
+    sha.UpdateData(t1, 16);
+    sha.Finalize();
+
+    for (int i = 0; i < 20; ++i)
+        vK[i * 2] = sha.GetDigest()[i];
+
+    for (int i = 0; i < 16; ++i)
+        t1[i] = t[i * 2 + 1];
+
+    sha.Initialize();
+    sha.UpdateData(t1, 16);
+    sha.Finalize();
+
+    for (int i = 0; i < 20; ++i)
+        vK[i * 2 + 1] = sha.GetDigest()[i];
+
+    BigNumber K;
+    K.SetBinary(vK, 40);
+
+    uint8 hash[20];
+    sha.Initialize();
+    sha.UpdateBigNumbers(&N, NULL);
+    sha.Finalize();
+    memcpy(hash, sha.GetDigest(), 20);
+    sha.Initialize();
+    sha.UpdateBigNumbers(&g, NULL);
+    sha.Finalize();
+
+    for (int i = 0; i < 20; ++i)
+        hash[i] ^= sha.GetDigest()[i];
+
+    BigNumber t3;
+    t3.SetBinary(hash, 20);
+
+    sha.Initialize();
+    sha.UpdateData(config.account);
+    sha.Finalize();
+    uint8 t4[SHA_DIGEST_LENGTH];
+    memcpy(t4, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+    sha.Initialize();
+    sha.UpdateBigNumbers(&t3, NULL);
+    sha.UpdateData(t4, SHA_DIGEST_LENGTH);
+    sha.UpdateBigNumbers(&s, &A, &B, &K, NULL);
+    sha.Finalize();
+    BigNumber M;
+    M.SetBinary(sha.GetDigest(), sha.GetLength());
+
+    // cmd, A, M1, crc hash, number of keys, security flags
+    std::vector<uint8> proof;
+    proof.push_back(AUTH_LOGON_PROOF);
+    AppendBigNumber(proof, A, 32);
+    AppendBigNumber(proof, M, 20);
+    proof.resize(proof.size() + 20 + 1 + 1, 0);
+    boost::asio::write(socket, boost::asio::buffer(proof), error);
+
+    uint8 proofHeader[2];
+    boost::asio::read(socket, boost::asio::buffer(proofHeader), error);
+    if (error)
+        return LOGIN_NETWORK_ERROR;
+
+    if (proofHeader[1] != WOW_SUCCESS)
+        return LOGIN_REFUSED;
+
+    // M2, account flags, survey id, unk3
+    uint8 proofData[20 + 4 + 4 + 2];
+    boost::asio::read(socket, boost::asio::buffer(proofData), error);
+    if (error)
+        return LOGIN_NETWORK_ERROR;
+
+    sha.Initialize();
+    sha.UpdateBigNumbers(&A, &M, &K, NULL);
+    sha.Finalize();
+    if (memcmp(proofData, sha.GetDigest(), 20) != 0)
+        return LOGIN_REFUSED;
+
+    return LOGIN_OK;
+}
+
+int main(int argc, char* argv[])
+{
+    Trinity::Banner::Show("authserver login benchmark", [](char const* text) { std::cout << text << std::endl; }, nullptr);
+
+    if (argc < 4)
+    {
+        std::cout << "usage: " << argv[0] << " <host[:port]> <account> <password> [connections] [seconds]" << std::endl;
+        return 1;
+    }
+
+    BenchmarkConfig config;
+    config.host = argv[1];
+    config.port = "3724";
+    size_t const colon = config.host.find(':');
+    if (colon != std::string::npos)
+    {
+        config.port = config.host.substr(colon + 1);
+        config.host.resize(colon);
+    }
+
+    config.account = argv[2];
+    config.password = argv[3];
+    std::transform(config.account.begin(), config.account.end(), config.account.begin(), ::toupper);
+    std::transform(config.password.begin(), config.password.end(), config.password.begin(), ::toupper);
+
+    uint32 const connections = argc > 4 ? uint32(std::max(1, atoi(argv[4]))) : 100;
+    uint32 const seconds = argc > 5 ? uint32(std::max(1, atoi(argv[5]))) : 10;
+
+    boost::asio::io_context resolverContext;
+    tcp::resolver resolver(resolverContext);
+    boost::system::error_code error;
+    tcp::resolver::results_type const endpoints = resolver.resolve(config.host, config.port, error);
+    if (error)
+    {
+        std::cout << "could not resolve " << config.host << ": " << error.message() << std::endl;
+        return 1;
+    }
+
+    std::cout << connections << " concurrent logins of " << config.account << " to " << config.host << ":" << config.port
+        << " for " << seconds << " s" << std::endl;
+
+    std::atomic<uint64> results[LOGIN_RESULT_COUNT];
+    for (std::atomic<uint64>& result : results)
+        result = 0;
+
+    std::mutex latenciesLock;
+    std::vector<double> latencies;      // ms, successful logins only
+
+    std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point const end = start + std::chrono::seconds(seconds);
+
+    // Each connection thread computes its own logon proof
+    OpenSSLCrypto::threadsSetup();
+
+    std::vector<std::thread> threads;
+    for (uint32 i = 0; i < connections; ++i)
+    {
+        threads.emplace_back([&]()
+        {
+            boost::asio::io_context ioContext;
+            std::vector<double> threadLatencies;
+            while (std::chrono::steady_clock::now() < end)
+            {
+                std::chrono::steady_clock::time_point const loginStart = std::chrono::steady_clock::now();
+                LoginResult const result = Login(ioContext, endpoints, config);
+                ++results[result];
+                if (result == LOGIN_OK)
+                    threadLatencies.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loginStart).count());
+                else if (result == LOGIN_NETWORK_ERROR)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+
+            std::lock_guard<std::mutex> lock(latenciesLock);
+            latencies.insert(latencies.end(), threadLatencies.begin(), threadLatencies.end());
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    OpenSSLCrypto::threadsCleanup();
+
+    double const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << results[LOGIN_OK] << " logins (" << results[LOGIN_OK] / elapsed << "/s), "
+        << results[LOGIN_BUSY] << " busy, " << results[LOGIN_REFUSED] << " refused, "
+        << results[LOGIN_NETWORK_ERROR] << " network errors" << std::endl;
+
+    if (!latencies.empty())
+    {
+        std::sort(latencies.begin(), latencies.end());
+        double total = 0.0;
+        for (double latency : latencies)
+            total += latency;
+
+        std::cout << "latency: avg " << total / latencies.size() << " ms, p50 " << latencies[latencies.size() / 2]
+            << " ms, p99 " << latencies[latencies.size() * 99 / 100] << " ms, max " << latencies.back() << " ms" << std::endl;
+    }
+
+    return results[LOGIN_OK] ? 0 : 1;
+}
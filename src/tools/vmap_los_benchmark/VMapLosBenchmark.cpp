@@ -0,0 +1,163 @@
+#include "VMapManager2.h"
+#include "Banner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* Replays line of sight queries logged by the worldserver (Logger.maps.los) against extracted vmaps, one by one
+then by packets of rays like area spells do, and compares the results of both. */
+
+struct RecordedQuery
+{
+    uint32 mapId;
+    VMAP::LineOfSightQuery query;
+};
+
+// Queries are the last 7 fields of each line, whatever the log prefix
+static bool ReadQueries(std::string const& fileName, std::vector<RecordedQuery>& queries)
+{
+    std::ifstream file(fileName);
+    if (!file)
+        return false;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream stream(line);
+        std::vector<std::string> fields;
+        std::string field;
+        while (stream >> field)
+            fields.push_back(field);
+
+        if (fields.size() < 7)
+            continue;
+
+        std::vector<std::string>::const_iterator itr = fields.end() - 7;
+        RecordedQuery recorded;
+        try
+        {
+            recorded.mapId = uint32(std::stoul(*itr++));
+            recorded.query.x1 = std::stof(*itr++);
+            recorded.query.y1 = std::stof(*itr++);
+            recorded.query.z1 = std::stof(*itr++);
+            recorded.query.x2 = std::stof(*itr++);
+            recorded.query.y2 = std::stof(*itr++);
+            recorded.query.z2 = std::stof(*itr++);
+        }
+        catch (std::exception const&)
+        {
+            continue;
+        }
+
+        recorded.query.result = true;
+        queries.push_back(recorded);
+    }
+
+    return true;
+}
+
+// Same tile as the grid the worldserver loads for this position
+static uint64 GetTileKey(uint32 mapId, float x, float y)
+{
+    float const gridSize = 533.3333f;
+    uint32 const tileX = 63 - uint32(x / gridSize + 32);
+    uint32 const tileY = 63 - uint32(y / gridSize + 32);
+    return (uint64(mapId) << 32) | (tileX << 16) | tileY;
+}
+
+int main(int argc, char* argv[])
+{
+    Trinity::Banner::Show("VMAP line of sight benchmark", [](char const* text) { std::cout << text << std::endl; }, nullptr);
+
+    if (argc < 3 || argc > 4)
+    {
+        std::cout << "usage: " << argv[0] << " <vmaps dir> <recorded queries file> [iterations]" << std::endl;
+        return 1;
+    }
+
+    std::string const vmapsDir = argv[1];
+    uint32 const iterations = argc > 3 ? uint32(std::max(1, atoi(argv[3]))) : 10;
+
+    std::vector<RecordedQuery> recorded;
+    if (!ReadQueries(argv[2], recorded))
+    {
+        std::cout << "could not read " << argv[2] << std::endl;
+        return 1;
+    }
+
+    if (recorded.empty())
+    {
+        std::cout << "no query found in " << argv[2] << std::endl;
+        return 1;
+    }
+
+    VMAP::VMapManager2 manager;
+    std::set<uint64> tiles;
+    for (RecordedQuery const& query : recorded)
+    {
+        tiles.insert(GetTileKey(query.mapId, query.query.x1, query.query.y1));
+        tiles.insert(GetTileKey(query.mapId, query.query.x2, query.query.y2));
+    }
+
+    for (uint64 tile : tiles)
+        manager.loadMap(vmapsDir.c_str(), uint32(tile >> 32), int((tile >> 16) & 0xFFFF), int(tile & 0xFFFF));
+
+    std::cout << recorded.size() << " queries, " << tiles.size() << " tiles" << std::endl;
+
+    // Consecutive queries of the same map are checked together, as they were made in the same map update
+    std::vector<std::pair<uint32, std::vector<VMAP::LineOfSightQuery>>> batches;
+    for (RecordedQuery const& query : recorded)
+    {
+        if (batches.empty() || batches.back().first != query.mapId)
+            batches.emplace_back(query.mapId, std::vector<VMAP::LineOfSightQuery>());
+        batches.back().second.push_back(query.query);
+    }
+
+    std::vector<bool> singleResults(recorded.size());
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+        for (size_t j = 0; j < recorded.size(); ++j)
+        {
+            VMAP::LineOfSightQuery const& query = recorded[j].query;
+            singleResults[j] = manager.isInLineOfSight(recorded[j].mapId, query.x1, query.y1, query.z1, query.x2, query.y2, query.z2, VMAP::ModelIgnoreFlags::Nothing);
+        }
+    double const singleTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+        for (auto& batch : batches)
+            manager.isInLineOfSight(batch.first, batch.second.data(), uint32(batch.second.size()), VMAP::ModelIgnoreFlags::Nothing);
+    double const packetTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    size_t mismatches = 0;
+    size_t blocked = 0;
+    size_t index = 0;
+    for (auto const& batch : batches)
+        for (VMAP::LineOfSightQuery const& query : batch.second)
+        {
+            if (query.result != singleResults[index])
+                ++mismatches;
+            if (!singleResults[index])
+                ++blocked;
+            ++index;
+        }
+
+    double const total = double(recorded.size()) * iterations;
+    std::cout << blocked << " queries not in line of sight" << std::endl;
+    std::cout << "single rays: " << singleTime << " ms (" << singleTime * 1000000.0 / total << " ns/query)" << std::endl;
+    std::cout << "ray packets: " << packetTime << " ms (" << packetTime * 1000000.0 / total << " ns/query)" << std::endl;
+    if (mismatches)
+    {
+        std::cout << mismatches << " results differ between single rays and ray packets" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}